@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer.hpp>
+#include "../test/mock/mock_server.hpp"
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+using namespace bc::explorer::commands;
+
+// The mock server is bound to a loopback port so that the network commands
+// exercise the same socket, codec and callback paths as against a server.
+#define BX_BENCHMARK_SERVER "tcp://127.0.0.1:65091"
+#define BX_BENCHMARK_USAGE \
+"Usage: bx_benchmark [ITERATIONS] [LATENCY_MS] [JITTER_MS] [HISTORY_ROWS] " \
+"[ADDRESSES] [WINDOWS] [RATE]"
+
+typedef std::chrono::steady_clock clock_type;
+typedef std::chrono::microseconds period_us;
+
+// Configure the shared network settings of a benchmarked command.
+template <typename Command>
+static void configure(Command& command)
+{
+    command.set_general_retries_setting(0);
+    command.set_general_wait_setting(5000);
+    command.set_general_hedge_setting(0);
+    command.set_mainnet_url_setting({ BX_BENCHMARK_SERVER });
+}
+
+static period_us::rep percentile(const std::vector<period_us::rep>& sorted,
+    size_t percent)
+{
+    if (sorted.empty())
+        return 0;
+
+    return sorted[(sorted.size() - 1) * percent / 100];
+}
+
+// Parse a comma separated list of load levels.
+static std::vector<size_t> parse_levels(const std::string& text)
+{
+    std::vector<std::string> tokens;
+    boost::split(tokens, text, boost::is_any_of(","));
+
+    std::vector<size_t> levels;
+    for (const auto& token: tokens)
+        levels.push_back(std::stoul(token));
+
+    return levels;
+}
+
+// A set of distinct addresses, each of which the server answers with the
+// synthetic history.
+static std::vector<primitives::address> make_addresses(size_t count)
+{
+    std::vector<primitives::address> addresses;
+    for (size_t index = 0; index < count; ++index)
+    {
+        short_hash hash = { { 0 } };
+        hash[0] = static_cast<uint8_t>(index);
+        hash[1] = static_cast<uint8_t>(index >> 8);
+        addresses.push_back({ payment_address(0x00, hash) });
+    }
+
+    return addresses;
+}
+
+// Invoke the command the specified number of times and report the results.
+// With a rate the invocations are started on a fixed schedule and latency is
+// measured from the scheduled start, so that time spent queued behind a slow
+// invocation is counted rather than hidden by the closed loop.
+static bool measure(const std::string& name, size_t window, size_t iterations,
+    size_t rate, size_t addresses,
+    std::function<console_result(std::ostream&, std::ostream&)> invoke)
+{
+    size_t failures = 0;
+    std::vector<period_us::rep> latencies;
+    const auto interval = period_us(rate == 0 ? 0 : 1000000 / rate);
+    const auto begin = clock_type::now();
+
+    for (size_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        std::stringstream output, error;
+        auto start = clock_type::now();
+        if (rate != 0)
+        {
+            start = begin + interval * iteration;
+            std::this_thread::sleep_until(start);
+        }
+
+        if (invoke(output, error) != console_result::okay)
+            ++failures;
+
+        latencies.push_back(std::chrono::duration_cast<period_us>(
+            clock_type::now() - start).count());
+    }
+
+    const auto elapsed = std::chrono::duration_cast<period_us>(
+        clock_type::now() - begin).count();
+    std::sort(latencies.begin(), latencies.end());
+    const auto seconds = std::max(elapsed, period_us::rep(1)) / 1000000.0;
+
+    std::cout << boost::format(
+        "%1$-14s %2$6u %3$8u %4$8u %5$10.1f %6$10.1f %7$10u %8$10u %9$10u") %
+        name % window % iterations % failures % (iterations / seconds) %
+        (iterations * addresses / seconds) % percentile(latencies, 50) %
+        percentile(latencies, 95) % percentile(latencies, 99) << std::endl;
+
+    return failures == 0;
+}
+
+/**
+ * Measure network commands against a local mock server, offline.
+ * @param argc  The number of elements in the argv array.
+ * @param argv  The array of arguments, including the process.
+ * @return      Zero if all invocations succeeded.
+ */
+int main(int argc, char* argv[])
+{
+    size_t iterations = 1000;
+    size_t latency = 0;
+    size_t jitter = 0;
+    size_t rows = 100;
+    size_t count = 16;
+    std::vector<size_t> windows = { 1, 4, 16 };
+    size_t rate = 0;
+
+    try
+    {
+        if (argc > 1)
+            iterations = std::stoul(argv[1]);
+        if (argc > 2)
+            latency = std::stoul(argv[2]);
+        if (argc > 3)
+            jitter = std::stoul(argv[3]);
+        if (argc > 4)
+            rows = std::stoul(argv[4]);
+        if (argc > 5)
+            count = std::stoul(argv[5]);
+        if (argc > 6)
+            windows = parse_levels(argv[6]);
+        if (argc > 7)
+            rate = std::stoul(argv[7]);
+    }
+    catch (const std::exception&)
+    {
+        std::cerr << BX_BENCHMARK_USAGE << std::endl;
+        return 1;
+    }
+
+    const auto genesis = genesis_block();
+    const auto& coinbase = genesis.transactions.front();
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context, period_ms(latency),
+        period_ms(jitter));
+    server.set_height(0);
+    server.set_synthetic_history(rows);
+    server.add_header(0, genesis.header);
+    server.add_transaction(coinbase, 0, 0);
+
+    if (!server.start(BX_BENCHMARK_SERVER))
+    {
+        std::cerr << "Failed to bind " BX_BENCHMARK_SERVER << std::endl;
+        return 1;
+    }
+
+    // The load level of the address commands is the window of outstanding
+    // requests over a set of addresses, since the shared connection serves
+    // one invocation at a time. Other commands issue one request per call.
+    const auto addresses = make_addresses(std::max(count, size_t(1)));
+
+    std::cout << boost::format("%1$-14s %2$s") % "rate" % (rate == 0 ?
+        std::string("closed loop") : std::to_string(rate) + " calls/s")
+        << std::endl;
+
+    std::cout << boost::format(
+        "%1$-14s %2$6s %3$8s %4$8s %5$10s %6$10s %7$10s %8$10s %9$10s") %
+        "command" % "window" % "calls" % "failed" % "calls/s" % "addrs/s" %
+        "p50(us)" % "p95(us)" % "p99(us)" << std::endl;
+
+    auto success = true;
+
+    for (const auto window: windows)
+        success &= measure("fetch-history", window, iterations, rate,
+            addresses.size(),
+            [&addresses, window](std::ostream& output, std::ostream& error)
+            {
+                fetch_history command;
+                configure(command);
+                command.set_window_option(window);
+                command.set_bitcoin_addresses_argument(addresses);
+                return command.invoke(output, error);
+            });
+
+    for (const auto window: windows)
+        success &= measure("fetch-balance", window, iterations, rate,
+            addresses.size(),
+            [&addresses, window](std::ostream& output, std::ostream& error)
+            {
+                fetch_balance command;
+                configure(command);
+                command.set_window_option(window);
+                command.set_bitcoin_addresses_argument(addresses);
+                return command.invoke(output, error);
+            });
+
+    success &= measure("fetch-tx", 1, iterations, rate, 0,
+        [&coinbase](std::ostream& output, std::ostream& error)
+        {
+            fetch_tx command;
+            configure(command);
+            command.set_hash_argument({ hash_transaction(coinbase) });
+            return command.invoke(output, error);
+        });
+
+    success &= measure("send-tx", 1, iterations, rate, 0,
+        [&coinbase](std::ostream& output, std::ostream& error)
+        {
+            send_tx command;
+            configure(command);
+            command.set_transaction_argument({ coinbase });
+            return command.invoke(output, error);
+        });
+
+    std::cout << boost::format("%1$-14s %2$8u") % "requests" %
+        server.requests() << std::endl;
+
+    server.stop();
+    return success ? 0 : 1;
+}
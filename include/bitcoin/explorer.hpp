@@ -25,13 +25,24 @@
 // This is intended primarily for test.
 #include <bitcoin/client.hpp>
 #include <bitcoin/explorer/async_client.hpp>
+#include <bitcoin/explorer/binary_format.hpp>
+#include <bitcoin/explorer/binary_writer.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/coalesce_stream.hpp>
 #include <bitcoin/explorer/command.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
 #include <bitcoin/explorer/dispatch.hpp>
 #include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/generated.hpp>
+#include <bitcoin/explorer/header_store.hpp>
+#include <bitcoin/explorer/hedge_stream.hpp>
+#include <bitcoin/explorer/history_cache.hpp>
+#include <bitcoin/explorer/latency_probe.hpp>
+#include <bitcoin/explorer/load_generator.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/output_buffer.hpp>
 #include <bitcoin/explorer/primitives/address.hpp>
 #include <bitcoin/explorer/primitives/base16.hpp>
 #include <bitcoin/explorer/primitives/base2.hpp>
@@ -57,6 +68,9 @@
 #include <bitcoin/explorer/primitives/wif.hpp>
 #include <bitcoin/explorer/primitives/wrapper.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
+#include <bitcoin/explorer/transaction_cache.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
 #include <bitcoin/explorer/utility/compat.hpp>
 #include <bitcoin/explorer/utility/config.hpp>
 #include <bitcoin/explorer/utility/environment.hpp>
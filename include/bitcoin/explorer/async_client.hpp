@@ -23,6 +23,7 @@
 #include <functional>
 #include <cstdint>
 #include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/callback_state.hpp>
 #include <bitcoin/explorer/command.hpp>
 #include <bitcoin/explorer/define.hpp>
 
@@ -67,20 +68,17 @@ public:
     BCX_API virtual threadpool& get_threadpool();
 
     /**
-     * Poll for changes until stopped.
-     * @param[in]  done       A flag that signals cessation of polling.
-     * @param[in]  period_ms  The polling period in ms, defaults to 100.
-     * @param[in]  action     The poll function to execute, defaults to null.
+     * Block until the callback state is stopped. Returns as soon as the last
+     * handler stops the state, the period only paces the optional action.
+     * @param[in]  state      The callback state that signals completion.
+     * @param[in]  period_ms  The action period in ms, defaults to 100.
+     * @param[in]  action     The function to execute each period, defaults
+     *                        to null.
      */
-    BCX_API virtual void poll(bool& done,
+    BCX_API virtual void poll(callback_state& state,
         uint32_t period_ms=default_poll_period_ms,
         std::function<void()> action=nullptr);
 
-    /**
-     * Sleep test wrapper.
-     */
-    BCX_API virtual void sleep(uint32_t period_ms);
-
     /**
      * Stop polling.
      */
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_BINARY_FORMAT_HPP
+#define BX_BINARY_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+/**
+ * The binary output format, readable without libbitcoin. This header depends
+ * only on the standard library so that it may be copied into consumers.
+ *
+ * The output is a sequence of records. Each record is a one byte type and a
+ * four byte payload size, followed by the payload. Integers are little
+ * endian and hashes are in wire order (the reverse of their hex display).
+ * Fixed size payloads are laid out as the packed structs below, so that on a
+ * little endian platform a payload may be copied directly into its struct.
+ * Readers should skip records of unknown type.
+ */
+
+namespace libbitcoin {
+namespace explorer {
+namespace binary {
+
+/**
+ * The record types.
+ */
+enum record_type : uint8_t
+{
+    /**
+     * The address of the transfer records that follow, address_record.
+     */
+    address = 1,
+
+    /**
+     * A history row, transfer_record.
+     */
+    transfer = 2,
+
+    /**
+     * The balance of an address, balance_record.
+     */
+    balance = 3,
+
+    /**
+     * The balance of a set of addresses, total_record.
+     */
+    total = 4,
+
+    /**
+     * A block header, in satoshi serialization, header_record.
+     */
+    header = 5,
+
+    /**
+     * A transaction, in satoshi serialization (variable size).
+     */
+    transaction = 6,
+
+    /**
+     * A stealth row, stealth_record.
+     */
+    stealth = 7
+};
+
+/**
+ * The size of the type and payload size that precede each payload.
+ */
+static const size_t record_prefix_size = 1 + 4;
+
+#pragma pack(push, 1)
+
+struct address_record
+{
+    uint8_t version;
+    uint8_t hash[20];
+};
+
+/**
+ * An unspent transfer has a zero spent_hash, a pending or unconfirmed point
+ * has a zero height.
+ */
+struct transfer_record
+{
+    uint8_t received_hash[32];
+    uint32_t received_index;
+    uint32_t received_height;
+    uint8_t spent_hash[32];
+    uint32_t spent_index;
+    uint32_t spent_height;
+    uint64_t value;
+};
+
+struct balance_record
+{
+    uint64_t confirmed;
+    uint64_t received;
+    uint64_t unspent;
+    address_record address;
+};
+
+struct total_record
+{
+    uint64_t addresses;
+    uint64_t confirmed;
+    uint64_t received;
+    uint64_t unspent;
+};
+
+struct header_record
+{
+    uint32_t version;
+    uint8_t previous_block_hash[32];
+    uint8_t merkle_tree_hash[32];
+    uint32_t time_stamp;
+    uint32_t bits;
+    uint32_t nonce;
+};
+
+struct stealth_record
+{
+    uint8_t ephemeral_public_key[33];
+    address_record paid_address;
+    uint8_t transaction_hash[32];
+};
+
+#pragma pack(pop)
+
+/**
+ * Read the next record of a buffer without copying its payload.
+ * @param[in,out] data     The position of the record, advanced past it.
+ * @param[in]     end      The end of the buffer.
+ * @param[out]    type     The record type.
+ * @param[out]    payload  The position of the payload.
+ * @param[out]    size     The size of the payload.
+ * @return                 True if a complete record was read.
+ */
+inline bool read_record(const uint8_t*& data, const uint8_t* end,
+    uint8_t& type, const uint8_t*& payload, uint32_t& size)
+{
+    if (end < data || static_cast<size_t>(end - data) < record_prefix_size)
+        return false;
+
+    type = data[0];
+    size = static_cast<uint32_t>(data[1]) |
+        static_cast<uint32_t>(data[2]) << 8 |
+        static_cast<uint32_t>(data[3]) << 16 |
+        static_cast<uint32_t>(data[4]) << 24;
+
+    if (static_cast<size_t>(end - data) - record_prefix_size < size)
+        return false;
+
+    payload = data + record_prefix_size;
+    data = payload + size;
+    return true;
+}
+
+/**
+ * Copy a fixed size payload into its record struct. The fields are little
+ * endian, so this is only a complete read on a little endian platform.
+ * @param      <Record>  The record struct of the payload type.
+ * @param[out] record    The record to populate.
+ * @param[in]  payload   The position of the payload.
+ * @param[in]  size      The size of the payload.
+ * @return               True if the payload is of the size of the record.
+ */
+template <typename Record>
+bool read_payload(Record& record, const uint8_t* payload, uint32_t size)
+{
+    if (size != sizeof(Record))
+        return false;
+
+    std::memcpy(&record, payload, sizeof(Record));
+    return true;
+}
+
+} // namespace binary
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_BINARY_WRITER_HPP
+#define BX_BINARY_WRITER_HPP
+
+#include <cstddef>
+#include <map>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/binary_format.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+// The records are defined in binary_format.hpp.
+
+/**
+ * Generate an address record.
+ * @param[in]  address  The payment address.
+ * @return              The record.
+ */
+BCX_API data_chunk binary_record(const payment_address& address);
+
+/**
+ * Generate a transfer record for a history row.
+ * @param[in]  row  The history row.
+ * @return          The record.
+ */
+BCX_API data_chunk binary_record(const client::history_row& row);
+
+/**
+ * Generate a balance record from the balance rows of an address.
+ * @param[in]  rows             The set of balance rows.
+ * @param[in]  balance_address  The payment address for the balance rows.
+ * @return                      The record.
+ */
+BCX_API data_chunk binary_record(const std::vector<balance_row>& rows,
+    const payment_address& balance_address);
+
+/**
+ * Generate a total record for the balances of a set of addresses.
+ * @param[in]  totals     The balance totals.
+ * @param[in]  addresses  The number of addresses totaled.
+ * @return                The record.
+ */
+BCX_API data_chunk binary_record(const balance_totals& totals,
+    size_t addresses);
+
+/**
+ * Generate a header record.
+ * @param[in]  header  The block header.
+ * @return             The record.
+ */
+BCX_API data_chunk binary_record(const block_header_type& header);
+
+/**
+ * Generate a transaction record.
+ * @param[in]  tx  The transaction.
+ * @return         The record.
+ */
+BCX_API data_chunk binary_record(const tx_type& tx);
+
+/**
+ * Generate a stealth record for a stealth row.
+ * @param[in]  row  The stealth row.
+ * @return          The record, empty if the ephemeral key is not 33 bytes.
+ */
+BCX_API data_chunk binary_record(const client::stealth_row& row);
+
+/**
+ * Generate the transfer records of a set of history rows.
+ * @param[in]  rows  The set of history rows.
+ * @return           The records.
+ */
+BCX_API data_chunk binary_records(
+    const std::vector<client::history_row>& rows);
+
+/**
+ * Generate the transfer records of a set of history rows of an address,
+ * preceded by its address record.
+ * @param[in]  rows             The set of history rows.
+ * @param[in]  history_address  The payment address for the history rows.
+ * @return                      The records.
+ */
+BCX_API data_chunk binary_records(
+    const std::vector<client::history_row>& rows,
+    const payment_address& history_address);
+
+/**
+ * Generate the transfer records of a set of history rows, each followed by
+ * the transaction records of its received and spent hashes where they are
+ * available.
+ * @param[in]  rows          The set of history rows.
+ * @param[in]  transactions  The transactions indexed by hash.
+ * @return                   The records.
+ */
+BCX_API data_chunk binary_records(
+    const std::vector<client::history_row>& rows,
+    const std::map<hash_digest, tx_type>& transactions);
+
+/**
+ * Generate the transfer records of a set of history rows of an address,
+ * preceded by its address record, each followed by the transaction records
+ * of its received and spent hashes where they are available.
+ * @param[in]  rows             The set of history rows.
+ * @param[in]  history_address  The payment address for the history rows.
+ * @param[in]  transactions     The transactions indexed by hash.
+ * @return                      The records.
+ */
+BCX_API data_chunk binary_records(
+    const std::vector<client::history_row>& rows,
+    const payment_address& history_address,
+    const std::map<hash_digest, tx_type>& transactions);
+
+/**
+ * Generate the stealth records of a set of stealth rows.
+ * @param[in]  rows  The set of stealth rows.
+ * @return           The records, empty if any ephemeral key is not 33 bytes.
+ */
+BCX_API data_chunk binary_records(
+    const std::vector<client::stealth_row>& rows);
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -20,13 +20,20 @@
 #ifndef BX_CALLBACK_STATE_HPP
 #define BX_CALLBACK_STATE_HPP
 
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <boost/format.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
+#include <bitcoin/explorer/output_buffer.hpp>
 #include <bitcoin/explorer/primitives/encoding.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
 
 /* NOTE: don't declare 'using namespace foo' in headers. */
 
@@ -35,11 +42,23 @@ namespace explorer {
 
 /**
  * Shared state wrapper to manage non-global shared call state.
+ * Output is flushed according to a flush policy, and written through when the
+ * state is destroyed. By default each flush writes through to the stream.
  */
 class callback_state
 {
 public:
 
+    /**
+     * A handler that writes output elements as they are produced.
+     */
+    typedef std::function<void(stream_writer&)> stream_handler;
+
+    /**
+     * A handler that writes the rows of a delimited table.
+     */
+    typedef std::function<void(delimited_writer&)> delimited_handler;
+
     /**
      * Construct an instance of the callback_state class. The class is
      * initialized with a reference count of zero (0). If the streams
@@ -52,6 +71,16 @@ public:
     BCX_API callback_state(std::ostream& error, std::ostream& output,
         const encoding_engine engine);
 
+    /**
+     * Construct an instance of the callback_state class with buffered output.
+     * @param[in]  error   The error stream for the callback handler.
+     * @param[in]  output  The output stream for the callback handler.
+     * @param[in]  engine  The desired output format.
+     * @param[in]  policy  The flush policy of the output stream.
+     */
+    BCX_API callback_state(std::ostream& error, std::ostream& output,
+        const encoding_engine engine, const flush_policy& policy);
+
     /**
      * Construct an instance of the callback_state class with native encoding.
      * @param[in]  error   The error stream for the callback handler.
@@ -96,6 +125,36 @@ public:
      */
     BCX_API virtual void output(const pt::ptree tree);
 
+    /**
+     * Stream elements to output as the handler produces them, with the
+     * encoding of a property tree of the same elements. The stream must be
+     * flushed before returning in order to prevent interleaving on the shared
+     * stream.
+     * @param[in]  handler  The handler that writes the elements.
+     */
+    BCX_API virtual void stream_output(const stream_handler& handler);
+
+    /**
+     * Open a list that encloses the elements of subsequent stream output, so
+     * that the output of a set of handlers is written as one document. The
+     * engine must not be binary or a delimited encoding.
+     * @param[in]  name  The name of the enclosing list.
+     */
+    BCX_API virtual void open_stream_output(const std::string& name);
+
+    /**
+     * Close the list opened by open_stream_output and finish its document.
+     */
+    BCX_API virtual void close_stream_output();
+
+    /**
+     * Write delimited table rows to output as the handler produces them. The
+     * engine must be a delimited encoding. The stream must be flushed before
+     * returning in order to prevent interleaving on the shared stream.
+     * @param[in]  handler  The handler that writes the rows.
+     */
+    BCX_API virtual void delimited_output(const delimited_handler& handler);
+
     /**
      * Write a line to the output stream. The stream must be flushed before 
      * returning in order to prevent interleaving on the shared stream.
@@ -117,6 +176,24 @@ public:
      */
     BCX_API virtual void output(uint64_t value);
 
+    /**
+     * Write binary records to the output stream. The stream must be flushed
+     * before returning in order to prevent interleaving on the shared stream.
+     * @param[in]  records  The records to write.
+     */
+    BCX_API virtual void output(const data_chunk& records);
+
+    /**
+     * Write through any buffered output, regardless of the flush policy.
+     */
+    BCX_API virtual void flush();
+
+    /**
+     * Write through buffered output if the flush policy makes it due. This
+     * allows a flush interval to be honored while no output is being written.
+     */
+    BCX_API virtual void flush_due();
+
     /**
      * Set the callback refcount to one and reset result to okay.
      */
@@ -131,9 +208,18 @@ public:
     
     /**
      * Get a value indicating whether the callback reference count is zero.
+     * The state is stopped by stop() or by the last decrement.
      * @return  True if the reference count is zero.
      */
-    BCX_API virtual bool& stopped();
+    BCX_API virtual bool stopped();
+
+    /**
+     * Block until the callback reference count is zero or the period elapses.
+     * The wait ends as soon as a handler on any thread stops the state.
+     * @param[in]  period_ms  The maximum period to wait in milliseconds.
+     * @return                True if the reference count is zero.
+     */
+    BCX_API virtual bool wait(uint32_t period_ms);
 
     /**
      * Get the engine enumeration value.
@@ -178,12 +264,22 @@ public:
     BCX_API virtual callback_state& operator--();
 
 private:
+
+    /**
+     * Signal waiters that the state has been stopped.
+     */
+    void notify();
+
     bool stopped_;
     size_t refcount_;
     console_result result_;
     encoding_engine engine_;
     std::ostream& error_;
-    std::ostream& output_;
+    output_buffer buffer_;
+    std::ostream output_;
+    std::unique_ptr<stream_writer> writer_;
+    mutable std::mutex mutex_;
+    std::condition_variable stopping_;
 };
 
 } // namespace explorer
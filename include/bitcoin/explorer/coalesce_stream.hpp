@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_COALESCE_STREAM_HPP
+#define BX_COALESCE_STREAM_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Message stream to coalesce identical calls. A call with the command and
+ * payload of a call that is in flight is not sent, instead it waits on the
+ * earlier call and the reply to that call is copied to it under its own id.
+ * A call that is resent by the codec is sent on its own. A call is forgotten
+ * once it and every call waiting on it have expired, so that the calls the
+ * codec has given up on do not accumulate.
+ */
+class coalesce_stream
+  : public client::message_stream
+{
+public:
+
+    /**
+     * Initialization constructor.
+     * @param[in]  next    The stream to which calls are sent.
+     * @param[in]  expiry  The period after which an unanswered call no
+     *                     longer accepts waiting calls, and after which the
+     *                     call and its waiting calls are forgotten, zero
+     *                     never expires.
+     */
+    BCX_API coalesce_stream(std::shared_ptr<client::message_stream> next,
+        const client::period_ms& expiry=client::period_ms(0));
+
+    /**
+     * Send a call, unless an identical call is in flight.
+     * @param[in]  data  The call message.
+     */
+    BCX_API virtual void write(const data_stack& data);
+
+    /**
+     * Complete a call on receipt of its reply.
+     * @param[in]  data  The reply message.
+     * @return           A copy of the reply for each waiting call.
+     */
+    BCX_API virtual std::vector<data_stack> reply(const data_stack& data);
+
+    /**
+     * Forget all calls, such as once the codec has no call outstanding.
+     */
+    BCX_API virtual void clear();
+
+    /**
+     * Determine whether identical calls are coalesced.
+     * @return  True if enabled, the default.
+     */
+    BCX_API virtual bool enabled() const;
+
+    /**
+     * Enable or disable coalescing, such as to measure the load of each call
+     * on the server. Calls already waiting are unaffected.
+     * @param[in]  enabled  True to coalesce identical calls.
+     */
+    BCX_API virtual void set_enabled(bool enabled);
+
+    /**
+     * Get the number of calls answered by the reply to an identical call.
+     * @return  The number of coalesced calls.
+     */
+    BCX_API virtual size_t coalesced() const;
+
+private:
+
+    typedef std::chrono::steady_clock clock;
+
+    struct call
+    {
+        data_chunk id;
+        clock::time_point sent;
+        clock::time_point joined;
+        std::vector<data_chunk> waiting;
+    };
+
+    bool expired(const call& entry, const clock::time_point& now) const;
+    void prune(const clock::time_point& now);
+
+    const std::shared_ptr<client::message_stream> next_;
+    const client::period_ms expiry_;
+    bool enabled_;
+    size_t coalesced_;
+
+    // Calls by request (command and payload), with the request of each call
+    // id that is sent and of each call id that is waiting.
+    std::map<data_chunk, call> calls_;
+    std::map<data_chunk, data_chunk> sent_;
+    std::map<data_chunk, data_chunk> waiting_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
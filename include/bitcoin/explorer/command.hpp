@@ -62,6 +62,7 @@ namespace explorer {
 
 #define BX_CONFIG_VARIABLE "config"
 #define BX_HELP_VARIABLE "help"
+#define BX_STATS_VARIABLE "stats"
 #define BX_PROGRAM_NAME "bx"
 
 /**
@@ -127,6 +128,19 @@ public:
         return console_result::failure;
     }
 
+    /**
+     * Bind command line arguments directly, without the program options
+     * parser. This is implemented only by commands with simple positional
+     * arguments and no options, and fails if any token is not bound.
+     * @param[in]  argc  The number of elements in the argv parameter.
+     * @param[in]  argv  Array of command line arguments excluding process.
+     * @return           True if all arguments are bound.
+     */
+    BCX_API virtual bool bind_arguments(int argc, const char* argv[])
+    {
+        return false;
+    }
+
     /**
      * Load command argument definitions.
      * A value of -1 indicates that the number of instances is unlimited.
@@ -197,18 +211,83 @@ public:
             value<uint32_t>(&setting_.general.wait)->default_value(2000),
             "Milliseconds to wait for a response from the server."
         )
+        (
+            "general.hedge",
+            value<uint32_t>(&setting_.general.hedge)->default_value(500),
+            "Milliseconds to wait for a response before also sending the call to the next server, until enough responses are observed to hedge at the 95th percentile of latency. Zero disables hedging."
+        )
+        (
+            "general.ranking",
+            value<boost::filesystem::path>(&setting_.general.ranking),
+            "The path of the ranked server list written by probe-servers. Servers are preferred in ranked order when the file exists."
+        )
+        (
+            "general.flush_size",
+            value<uint32_t>(&setting_.general.flush_size)->default_value(0),
+            "The number of bytes of output to buffer before writing it, for commands that write a row or event at a time. Buffered output is also written at the end of the command. Zero writes each row or line as it is completed, unless flush_interval is set."
+        )
+        (
+            "general.flush_interval",
+            value<uint32_t>(&setting_.general.flush_interval)->default_value(0),
+            "Milliseconds to buffer output before writing it, checked as each row or line is completed, for commands that write a row or event at a time. Buffered output is also written at the end of the command. Zero writes each row or line as it is completed, unless flush_size is set."
+        )
         (
             "mainnet.url",
             value<primitives::uri>(&setting_.mainnet.url)->default_value({ "tcp://obelisk.airbitz.co:9091" }),
             "The URL of the Obelisk mainnet server."
         )
+        (
+            "mainnet.server",
+            value<std::vector<primitives::uri>>(&setting_.mainnet.servers),
+            "The URL of an additional Obelisk mainnet server, to which slow calls are hedged. May be repeated."
+        )
         (
             "testnet.url",
             value<primitives::uri>(&setting_.testnet.url)->default_value({ "tcp://obelisk-testnet.airbitz.co:9091" }),
             "The URL of the Obelisk testnet server."
+        )
+        (
+            "testnet.server",
+            value<std::vector<primitives::uri>>(&setting_.testnet.servers),
+            "The URL of an additional Obelisk testnet server, to which slow calls are hedged. May be repeated."
+        )
+        (
+            "cache.header",
+            value<boost::filesystem::path>(&setting_.cache.header),
+            "The path of the block header file. When set, sync-headers stores verified headers in the file and fetch-header reads headers from it."
+        )
+        (
+            "cache.history",
+            value<boost::filesystem::path>(&setting_.cache.history),
+            "The path of the history cache file. When set, fetch-history and fetch-balance request only the rows at or above six blocks below the cached height of each address, so that a chain reorganization is corrected."
+        )
+        (
+            "cache.transaction",
+            value<boost::filesystem::path>(&setting_.cache.transaction),
+            "The path of the transaction cache file. When set, fetch-tx reads transactions from the cache and caches those it fetches."
+        )
+        (
+            "cache.transaction_limit",
+            value<uint32_t>(&setting_.cache.transaction_limit)->default_value(64),
+            "The maximum size of the transaction cache file in megabytes, beyond which the least recently used transactions are evicted. Defaults to 64."
         );
     }
 
+    /**
+     * Load configuration setting defaults, without the program options parser.
+     */
+    BCX_API virtual void load_setting_defaults()
+    {
+        setting_.general.network = "mainnet";
+        setting_.general.wait = 2000;
+        setting_.general.hedge = 500;
+        setting_.general.flush_size = 0;
+        setting_.general.flush_interval = 0;
+        setting_.mainnet.url = { "tcp://obelisk.airbitz.co:9091" };
+        setting_.testnet.url = { "tcp://obelisk-testnet.airbitz.co:9091" };
+        setting_.cache.transaction_limit = 64;
+    }
+
     /**
      * Load streamed value as parameter fallback.
      * @param[in]  input      The input stream for loading the parameter.
@@ -298,6 +377,70 @@ public:
         setting_.general.wait = value;
     }
 
+    /**
+     * Get the value of the general.hedge setting.
+     */
+    BCX_API virtual uint32_t get_general_hedge_setting()
+    {
+        return setting_.general.hedge;
+    }
+
+    /**
+     * Set the value of the general.hedge setting.
+     */
+    BCX_API virtual void set_general_hedge_setting(uint32_t value)
+    {
+        setting_.general.hedge = value;
+    }
+
+    /**
+     * Get the value of the general.ranking setting.
+     */
+    BCX_API virtual boost::filesystem::path get_general_ranking_setting()
+    {
+        return setting_.general.ranking;
+    }
+
+    /**
+     * Set the value of the general.ranking setting.
+     */
+    BCX_API virtual void set_general_ranking_setting(boost::filesystem::path value)
+    {
+        setting_.general.ranking = value;
+    }
+
+    /**
+     * Get the value of the general.flush_size setting.
+     */
+    BCX_API virtual uint32_t get_general_flush_size_setting()
+    {
+        return setting_.general.flush_size;
+    }
+
+    /**
+     * Set the value of the general.flush_size setting.
+     */
+    BCX_API virtual void set_general_flush_size_setting(uint32_t value)
+    {
+        setting_.general.flush_size = value;
+    }
+
+    /**
+     * Get the value of the general.flush_interval setting.
+     */
+    BCX_API virtual uint32_t get_general_flush_interval_setting()
+    {
+        return setting_.general.flush_interval;
+    }
+
+    /**
+     * Set the value of the general.flush_interval setting.
+     */
+    BCX_API virtual void set_general_flush_interval_setting(uint32_t value)
+    {
+        setting_.general.flush_interval = value;
+    }
+
     /**
      * Get the value of the mainnet.url setting.
      */
@@ -314,6 +457,22 @@ public:
         setting_.mainnet.url = value;
     }
 
+    /**
+     * Get the value of the mainnet.server settings.
+     */
+    BCX_API virtual std::vector<primitives::uri> get_mainnet_servers_setting()
+    {
+        return setting_.mainnet.servers;
+    }
+
+    /**
+     * Set the value of the mainnet.server settings.
+     */
+    BCX_API virtual void set_mainnet_servers_setting(std::vector<primitives::uri> value)
+    {
+        setting_.mainnet.servers = value;
+    }
+
     /**
      * Get the value of the testnet.url setting.
      */
@@ -330,6 +489,86 @@ public:
         setting_.testnet.url = value;
     }
 
+    /**
+     * Get the value of the testnet.server settings.
+     */
+    BCX_API virtual std::vector<primitives::uri> get_testnet_servers_setting()
+    {
+        return setting_.testnet.servers;
+    }
+
+    /**
+     * Set the value of the testnet.server settings.
+     */
+    BCX_API virtual void set_testnet_servers_setting(std::vector<primitives::uri> value)
+    {
+        setting_.testnet.servers = value;
+    }
+
+    /**
+     * Get the value of the cache.header setting.
+     */
+    BCX_API virtual boost::filesystem::path get_cache_header_setting()
+    {
+        return setting_.cache.header;
+    }
+
+    /**
+     * Set the value of the cache.header setting.
+     */
+    BCX_API virtual void set_cache_header_setting(boost::filesystem::path value)
+    {
+        setting_.cache.header = value;
+    }
+
+    /**
+     * Get the value of the cache.history setting.
+     */
+    BCX_API virtual boost::filesystem::path get_cache_history_setting()
+    {
+        return setting_.cache.history;
+    }
+
+    /**
+     * Set the value of the cache.history setting.
+     */
+    BCX_API virtual void set_cache_history_setting(boost::filesystem::path value)
+    {
+        setting_.cache.history = value;
+    }
+
+    /**
+     * Get the value of the cache.transaction setting.
+     */
+    BCX_API virtual boost::filesystem::path get_cache_transaction_setting()
+    {
+        return setting_.cache.transaction;
+    }
+
+    /**
+     * Set the value of the cache.transaction setting.
+     */
+    BCX_API virtual void set_cache_transaction_setting(boost::filesystem::path value)
+    {
+        setting_.cache.transaction = value;
+    }
+
+    /**
+     * Get the value of the cache.transaction_limit setting.
+     */
+    BCX_API virtual uint32_t get_cache_transaction_limit_setting()
+    {
+        return setting_.cache.transaction_limit;
+    }
+
+    /**
+     * Set the value of the cache.transaction_limit setting.
+     */
+    BCX_API virtual void set_cache_transaction_limit_setting(uint32_t value)
+    {
+        setting_.cache.transaction_limit = value;
+    }
+
 protected:
 
     /**
@@ -377,39 +616,68 @@ private:
             general()
               : network(),
                 retries(),
-                wait()
+                wait(),
+                hedge(),
+                ranking(),
+                flush_size(),
+                flush_interval()
             {
             }
 
             std::string network;
             primitives::base10 retries;
             uint32_t wait;
+            uint32_t hedge;
+            boost::filesystem::path ranking;
+            uint32_t flush_size;
+            uint32_t flush_interval;
         } general;
 
         struct mainnet
         {
             mainnet()
-              : url()
+              : url(),
+                servers()
             {
             }
 
             primitives::uri url;
+            std::vector<primitives::uri> servers;
         } mainnet;
 
         struct testnet
         {
             testnet()
-              : url()
+              : url(),
+                servers()
             {
             }
 
             primitives::uri url;
+            std::vector<primitives::uri> servers;
         } testnet;
 
+        struct cache
+        {
+            cache()
+              : header(),
+                history(),
+                transaction(),
+                transaction_limit()
+            {
+            }
+
+            boost::filesystem::path header;
+            boost::filesystem::path history;
+            boost::filesystem::path transaction;
+            uint32_t transaction_limit;
+        } cache;
+
         setting()
           : general(),
             mainnet(),
-            testnet()
+            testnet(),
+            cache()
         {
         }
     } setting_;
@@ -127,6 +127,18 @@ public:
         load_input(get_data_argument(), "DATA", variables, input);
     }
 
+    /**
+     * Bind program arguments directly, without the program options parser.
+     * @param[in]  argc  The number of elements in the argv parameter.
+     * @param[in]  argv  Array of command line arguments excluding process.
+     * @return           True if all arguments are bound.
+     */
+    BCX_API virtual bool bind_arguments(int argc, const char* argv[])
+    {
+        return argc == 2 &&
+            bind_token(argument_.data, argv[1]);
+    }
+
     /**
      * Load program option definitions.
      * BUGBUG: see boost bug/fix: svn.boost.org/trac/boost/ticket/8009
@@ -102,7 +102,7 @@ public:
      */
     BCX_API virtual const char* description()
     {
-        return "Get the balance in satoshi of a Bitcoin address. Requires an Obelisk server connection.";
+        return "Get the balance in satoshi of a set of Bitcoin addresses. The total balance of the set is included for more than one address. Requires an Obelisk server connection.";
     }
 
     /**
@@ -113,7 +113,7 @@ public:
     BCX_API virtual arguments_metadata& load_arguments()
     {
         return get_argument_metadata()
-            .add("BITCOIN_ADDRESS", 1);
+            .add("BITCOIN_ADDRESS", -1);
     }
 
 	/**
@@ -124,7 +124,7 @@ public:
     BCX_API virtual void load_fallbacks(std::istream& input, 
         po::variables_map& variables)
     {
-        load_input(get_bitcoin_address_argument(), "BITCOIN_ADDRESS", variables, input);
+        load_input(get_bitcoin_addresses_argument(), "BITCOIN_ADDRESS", variables, input);
     }
 
     /**
@@ -147,15 +147,25 @@ public:
             value<boost::filesystem::path>(),
             "The path to the configuration settings file."
         )
+        (
+            BX_STATS_VARIABLE,
+            value<bool>()->zero_tokens(),
+            "Write the wire metrics of the server calls made by the command to STDERR, in the output format of the command."
+        )
         (
             "format,f",
             value<primitives::encoding>(&option_.format),
-            "The output format. Options are 'info', 'json' and 'xml', defaults to 'info'."
+            "The output format. Options are 'binary', 'csv', 'info', 'json', 'ndjson', 'tsv' and 'xml', defaults to 'info'."
+        )
+        (
+            "window,w",
+            value<size_t>(&option_.window)->default_value(16),
+            "The maximum number of outstanding server requests, defaults to 16."
         )
         (
             "BITCOIN_ADDRESS",
-            value<primitives::address>(&argument_.bitcoin_address),
-            "The Bitcoin address. If not specified the address is read from STDIN."
+            value<std::vector<primitives::address>>(&argument_.bitcoin_addresses),
+            "The set of Bitcoin addresses. If not specified the addresses are read from STDIN."
         );
 
         return options;
@@ -173,20 +183,20 @@ public:
     /* Properties */
 
     /**
-     * Get the value of the BITCOIN_ADDRESS argument.
+     * Get the value of the BITCOIN_ADDRESS arguments.
      */
-    BCX_API virtual primitives::address& get_bitcoin_address_argument()
+    BCX_API virtual std::vector<primitives::address>& get_bitcoin_addresses_argument()
     {
-        return argument_.bitcoin_address;
+        return argument_.bitcoin_addresses;
     }
 
     /**
-     * Set the value of the BITCOIN_ADDRESS argument.
+     * Set the value of the BITCOIN_ADDRESS arguments.
      */
-    BCX_API virtual void set_bitcoin_address_argument(
-        const primitives::address& value)
+    BCX_API virtual void set_bitcoin_addresses_argument(
+        const std::vector<primitives::address>& value)
     {
-        argument_.bitcoin_address = value;
+        argument_.bitcoin_addresses = value;
     }
 
     /**
@@ -206,6 +216,23 @@ public:
         option_.format = value;
     }
 
+    /**
+     * Get the value of the window option.
+     */
+    BCX_API virtual size_t& get_window_option()
+    {
+        return option_.window;
+    }
+
+    /**
+     * Set the value of the window option.
+     */
+    BCX_API virtual void set_window_option(
+        const size_t& value)
+    {
+        option_.window = value;
+    }
+
 private:
 
     /**
@@ -216,11 +243,11 @@ private:
     struct argument
     {
         argument()
-          : bitcoin_address()
+          : bitcoin_addresses()
         {
         }
 
-        primitives::address bitcoin_address;
+        std::vector<primitives::address> bitcoin_addresses;
     } argument_;
 
     /**
@@ -231,11 +258,13 @@ private:
     struct option
     {
         option()
-          : format()
+          : format(),
+            window()
         {
         }
 
         primitives::encoding format;
+        size_t window;
     } option_;
 };
 
@@ -145,10 +145,15 @@ public:
             value<boost::filesystem::path>(),
             "The path to the configuration settings file."
         )
+        (
+            BX_STATS_VARIABLE,
+            value<bool>()->zero_tokens(),
+            "Write the wire metrics of the server calls made by the command to STDERR, in the output format of the command."
+        )
         (
             "format,f",
             value<primitives::encoding>(&option_.format),
-            "The output format. Options are 'info', 'json' and 'xml', defaults to 'info'."
+            "The output format. Options are 'binary', 'info', 'json', 'ndjson' and 'xml', defaults to 'info'."
         )
         (
             "hash,s",
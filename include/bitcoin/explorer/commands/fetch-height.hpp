@@ -133,6 +133,18 @@ public:
     {
     }
 
+    /**
+     * Bind program arguments directly, without the program options parser.
+     * @param[in]  argc  The number of elements in the argv parameter.
+     * @param[in]  argv  Array of command line arguments excluding process.
+     * @return           True if all arguments are bound.
+     */
+    BCX_API virtual bool bind_arguments(int argc, const char* argv[])
+    {
+        return argc == 2 &&
+            bind_token(argument_.server_url, argv[1]);
+    }
+
     /**
      * Load program option definitions.
      * BUGBUG: see boost bug/fix: svn.boost.org/trac/boost/ticket/8009
@@ -153,6 +165,11 @@ public:
             value<boost::filesystem::path>(),
             "The path to the configuration settings file."
         )
+        (
+            BX_STATS_VARIABLE,
+            value<bool>()->zero_tokens(),
+            "Write the wire metrics of the server calls made by the command to STDERR, in the output format of the command."
+        )
         (
             "server-url",
             value<std::string>(&argument_.server_url),
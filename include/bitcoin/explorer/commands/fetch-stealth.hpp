@@ -67,6 +67,8 @@ namespace commands {
 /**
  * Various localizable strings.
  */
+#define BX_FETCH_STEALTH_INVALID_KEY \
+    "The server returned an ephemeral key that is not 33 bytes, which has no binary record."
 #define BX_FETCH_STEALTH_PREFIX_TOO_LONG \
     "WARNING: stealth prefix is limited to 32 bits."
 
@@ -152,10 +154,15 @@ public:
             value<boost::filesystem::path>(),
             "The path to the configuration settings file."
         )
+        (
+            BX_STATS_VARIABLE,
+            value<bool>()->zero_tokens(),
+            "Write the wire metrics of the server calls made by the command to STDERR, in the output format of the command."
+        )
         (
             "format,f",
             value<primitives::encoding>(&option_.format),
-            "The output format. Options are 'info', 'json' and 'xml', defaults to 'info'."
+            "The output format. Options are 'binary', 'csv', 'info', 'json', 'ndjson', 'tsv' and 'xml', defaults to 'info'."
         )
         (
             "height,t",
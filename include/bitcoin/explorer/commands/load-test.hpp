@@ -0,0 +1,322 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_LOAD_TEST_HPP
+#define BX_LOAD_TEST_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/command.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/generated.hpp>
+#include <bitcoin/explorer/primitives/address.hpp>
+#include <bitcoin/explorer/primitives/base10.hpp>
+#include <bitcoin/explorer/primitives/base16.hpp>
+#include <bitcoin/explorer/primitives/base2.hpp>
+#include <bitcoin/explorer/primitives/base58.hpp>
+#include <bitcoin/explorer/primitives/btc.hpp>
+#include <bitcoin/explorer/primitives/btc160.hpp>
+#include <bitcoin/explorer/primitives/btc256.hpp>
+#include <bitcoin/explorer/primitives/ec_private.hpp>
+#include <bitcoin/explorer/primitives/ec_public.hpp>
+#include <bitcoin/explorer/primitives/encoding.hpp>
+#include <bitcoin/explorer/primitives/hashtype.hpp>
+#include <bitcoin/explorer/primitives/hd_key.hpp>
+#include <bitcoin/explorer/primitives/hd_priv.hpp>
+#include <bitcoin/explorer/primitives/hd_pub.hpp>
+#include <bitcoin/explorer/primitives/header.hpp>
+#include <bitcoin/explorer/primitives/input.hpp>
+#include <bitcoin/explorer/primitives/output.hpp>
+#include <bitcoin/explorer/primitives/raw.hpp>
+#include <bitcoin/explorer/primitives/script.hpp>
+#include <bitcoin/explorer/primitives/stealth.hpp>
+#include <bitcoin/explorer/primitives/transaction.hpp>
+#include <bitcoin/explorer/primitives/uri.hpp>
+#include <bitcoin/explorer/primitives/wif.hpp>
+#include <bitcoin/explorer/primitives/wrapper.hpp>
+#include <bitcoin/explorer/utility/compat.hpp>
+#include <bitcoin/explorer/utility/config.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+/********* GENERATED SOURCE CODE, DO NOT EDIT EXCEPT EXPERIMENTALLY **********/
+
+namespace libbitcoin {
+namespace explorer {
+namespace commands {
+
+/**
+ * Class to implement the load-test command.
+ */
+class load_test 
+    : public command
+{
+public:
+
+    /**
+     * The symbolic (not localizable) command name, lower case.
+     */
+    BCX_API static const char* symbol()
+    {
+        return "load-test";
+    }
+
+
+    /**
+     * The member symbolic (not localizable) command name, lower case.
+     */
+    BCX_API virtual const char* name()
+    {
+        return load_test::symbol();
+    }
+
+    /**
+     * The localizable command category name, upper case.
+     */
+    BCX_API virtual const char* category()
+    {
+        return "ONLINE";
+    }
+
+    /**
+     * The localizable command description.
+     */
+    BCX_API virtual const char* description()
+    {
+        return "Measure the throughput of an Obelisk server by keeping a number of height, header, transaction and history requests outstanding, at a target rate, for a fixed duration. Reports throughput, latency percentiles and timeout and retry counts. Requires an Obelisk server connection.";
+    }
+
+    /**
+     * Load program argument definitions.
+     * A value of -1 indicates that the number of instances is unlimited.
+     * @return  The loaded program argument definitions.
+     */
+    BCX_API virtual arguments_metadata& load_arguments()
+    {
+        return get_argument_metadata()
+            .add("server-url", 1);
+    }
+
+	/**
+     * Load parameter fallbacks from file or input as appropriate.
+     * @param[in]  input  The input stream for loading the parameters.
+     * @param[in]         The loaded variables.
+     */
+    BCX_API virtual void load_fallbacks(std::istream& input, 
+        po::variables_map& variables)
+    {
+    }
+
+    /**
+     * Load program option definitions.
+     * BUGBUG: see boost bug/fix: svn.boost.org/trac/boost/ticket/8009
+     * @return  The loaded program option definitions.
+     */
+    BCX_API virtual options_metadata& load_options()
+    {
+        using namespace po;
+        options_description& options = get_option_metadata();
+        options.add_options()
+        (
+            BX_HELP_VARIABLE ",h",
+            value<bool>()->zero_tokens(),
+            "Get a description and instructions for this command."
+        )
+        (
+            BX_CONFIG_VARIABLE ",c",
+            value<boost::filesystem::path>(),
+            "The path to the configuration settings file."
+        )
+        (
+            BX_STATS_VARIABLE,
+            value<bool>()->zero_tokens(),
+            "Write the wire metrics of the server calls made by the command to STDERR, in the output format of the command."
+        )
+        (
+            "format,f",
+            value<primitives::encoding>(&option_.format),
+            "The output format. Options are 'info', 'json', 'ndjson' and 'xml', defaults to 'info'."
+        )
+        (
+            "concurrency,n",
+            value<size_t>(&option_.concurrency)->default_value(16),
+            "The maximum number of outstanding server requests, defaults to 16."
+        )
+        (
+            "rate,r",
+            value<size_t>(&option_.rate)->default_value(0),
+            "The target number of requests per second, defaults to 0 (unlimited)."
+        )
+        (
+            "duration,d",
+            value<size_t>(&option_.duration)->default_value(10),
+            "The number of seconds over which requests are sent, defaults to 10."
+        )
+        (
+            "server-url",
+            value<std::string>(&argument_.server_url),
+            "The URL of the Obelisk server to use. If not specified the URL is obtained from configuration settings or defaults."
+        );
+
+        return options;
+    }
+
+    /**
+     * Invoke the command.
+     * @param[out]  output  The input stream for the command execution.
+     * @param[out]  error   The input stream for the command execution.
+     * @return              The appropriate console return code { -1, 0, 1 }.
+     */
+    BCX_API virtual console_result invoke(std::ostream& output,
+        std::ostream& cerr);
+
+    /* Properties */
+
+    /**
+     * Get the value of the server-url argument.
+     */
+    BCX_API virtual std::string& get_server_url_argument()
+    {
+        return argument_.server_url;
+    }
+
+    /**
+     * Set the value of the server-url argument.
+     */
+    BCX_API virtual void set_server_url_argument(
+        const std::string& value)
+    {
+        argument_.server_url = value;
+    }
+
+    /**
+     * Get the value of the format option.
+     */
+    BCX_API virtual primitives::encoding& get_format_option()
+    {
+        return option_.format;
+    }
+
+    /**
+     * Set the value of the format option.
+     */
+    BCX_API virtual void set_format_option(
+        const primitives::encoding& value)
+    {
+        option_.format = value;
+    }
+
+    /**
+     * Get the value of the concurrency option.
+     */
+    BCX_API virtual size_t& get_concurrency_option()
+    {
+        return option_.concurrency;
+    }
+
+    /**
+     * Set the value of the concurrency option.
+     */
+    BCX_API virtual void set_concurrency_option(
+        const size_t& value)
+    {
+        option_.concurrency = value;
+    }
+
+    /**
+     * Get the value of the rate option.
+     */
+    BCX_API virtual size_t& get_rate_option()
+    {
+        return option_.rate;
+    }
+
+    /**
+     * Set the value of the rate option.
+     */
+    BCX_API virtual void set_rate_option(
+        const size_t& value)
+    {
+        option_.rate = value;
+    }
+
+    /**
+     * Get the value of the duration option.
+     */
+    BCX_API virtual size_t& get_duration_option()
+    {
+        return option_.duration;
+    }
+
+    /**
+     * Set the value of the duration option.
+     */
+    BCX_API virtual void set_duration_option(
+        const size_t& value)
+    {
+        option_.duration = value;
+    }
+
+private:
+
+    /**
+     * Command line argument bound variables.
+     * Uses cross-compiler safe constructor-based zeroize.
+     * Zeroize for unit test consistency with program_options initialization.
+     */
+    struct argument
+    {
+        argument()
+          : server_url()
+        {
+        }
+
+        std::string server_url;
+    } argument_;
+
+    /**
+     * Command line option bound variables.
+     * Uses cross-compiler safe constructor-based zeroize.
+     * Zeroize for unit test consistency with program_options initialization.
+     */
+    struct option
+    {
+        option()
+          : format(),
+            concurrency(),
+            rate(),
+            duration()
+        {
+        }
+
+        primitives::encoding format;
+        size_t concurrency;
+        size_t rate;
+        size_t duration;
+    } option_;
+};
+
+} // namespace commands
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_PROBE_SERVERS_HPP
+#define BX_PROBE_SERVERS_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/command.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/generated.hpp>
+#include <bitcoin/explorer/primitives/address.hpp>
+#include <bitcoin/explorer/primitives/base10.hpp>
+#include <bitcoin/explorer/primitives/base16.hpp>
+#include <bitcoin/explorer/primitives/base2.hpp>
+#include <bitcoin/explorer/primitives/base58.hpp>
+#include <bitcoin/explorer/primitives/btc.hpp>
+#include <bitcoin/explorer/primitives/btc160.hpp>
+#include <bitcoin/explorer/primitives/btc256.hpp>
+#include <bitcoin/explorer/primitives/ec_private.hpp>
+#include <bitcoin/explorer/primitives/ec_public.hpp>
+#include <bitcoin/explorer/primitives/encoding.hpp>
+#include <bitcoin/explorer/primitives/hashtype.hpp>
+#include <bitcoin/explorer/primitives/hd_key.hpp>
+#include <bitcoin/explorer/primitives/hd_priv.hpp>
+#include <bitcoin/explorer/primitives/hd_pub.hpp>
+#include <bitcoin/explorer/primitives/header.hpp>
+#include <bitcoin/explorer/primitives/input.hpp>
+#include <bitcoin/explorer/primitives/output.hpp>
+#include <bitcoin/explorer/primitives/raw.hpp>
+#include <bitcoin/explorer/primitives/script.hpp>
+#include <bitcoin/explorer/primitives/stealth.hpp>
+#include <bitcoin/explorer/primitives/transaction.hpp>
+#include <bitcoin/explorer/primitives/uri.hpp>
+#include <bitcoin/explorer/primitives/wif.hpp>
+#include <bitcoin/explorer/primitives/wrapper.hpp>
+#include <bitcoin/explorer/utility/compat.hpp>
+#include <bitcoin/explorer/utility/config.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+/********* GENERATED SOURCE CODE, DO NOT EDIT EXCEPT EXPERIMENTALLY **********/
+
+namespace libbitcoin {
+namespace explorer {
+namespace commands {
+
+/**
+ * Various localizable strings.
+ */
+#define BX_PROBE_SERVERS_WRITE_FAIL \
+    "Could not write the server ranking file: %1%"
+
+/**
+ * Class to implement the probe-servers command.
+ */
+class probe_servers 
+    : public command
+{
+public:
+
+    /**
+     * The symbolic (not localizable) command name, lower case.
+     */
+    BCX_API static const char* symbol()
+    {
+        return "probe-servers";
+    }
+
+
+    /**
+     * The member symbolic (not localizable) command name, lower case.
+     */
+    BCX_API virtual const char* name()
+    {
+        return probe_servers::symbol();
+    }
+
+    /**
+     * The localizable command category name, upper case.
+     */
+    BCX_API virtual const char* category()
+    {
+        return "ONLINE";
+    }
+
+    /**
+     * The localizable command description.
+     */
+    BCX_API virtual const char* description()
+    {
+        return "Measure the latency and height lag of a set of Obelisk servers and rank them by health and median latency. The ranking is written to the general.ranking file, if configured, from which network commands select their servers. Requires Obelisk server connections.";
+    }
+
+    /**
+     * Load program argument definitions.
+     * A value of -1 indicates that the number of instances is unlimited.
+     * @return  The loaded program argument definitions.
+     */
+    BCX_API virtual arguments_metadata& load_arguments()
+    {
+        return get_argument_metadata()
+            .add("server-url", -1);
+    }
+
+	/**
+     * Load parameter fallbacks from file or input as appropriate.
+     * @param[in]  input  The input stream for loading the parameters.
+     * @param[in]         The loaded variables.
+     */
+    BCX_API virtual void load_fallbacks(std::istream& input, 
+        po::variables_map& variables)
+    {
+    }
+
+    /**
+     * Load program option definitions.
+     * BUGBUG: see boost bug/fix: svn.boost.org/trac/boost/ticket/8009
+     * @return  The loaded program option definitions.
+     */
+    BCX_API virtual options_metadata& load_options()
+    {
+        using namespace po;
+        options_description& options = get_option_metadata();
+        options.add_options()
+        (
+            BX_HELP_VARIABLE ",h",
+            value<bool>()->zero_tokens(),
+            "Get a description and instructions for this command."
+        )
+        (
+            BX_CONFIG_VARIABLE ",c",
+            value<boost::filesystem::path>(),
+            "The path to the configuration settings file."
+        )
+        (
+            BX_STATS_VARIABLE,
+            value<bool>()->zero_tokens(),
+            "Write the wire metrics of the server calls made by the command to STDERR, in the output format of the command."
+        )
+        (
+            "format,f",
+            value<primitives::encoding>(&option_.format),
+            "The output format. Options are 'info', 'json', 'ndjson' and 'xml', defaults to 'info'."
+        )
+        (
+            "samples,s",
+            value<size_t>(&option_.samples)->default_value(5),
+            "The number of height requests sent to each server, defaults to 5."
+        )
+        (
+            "server-url",
+            value<std::vector<std::string>>(&argument_.server_urls),
+            "The set of URLs of the Obelisk servers to probe. If not specified the servers are obtained from configuration settings or defaults."
+        );
+
+        return options;
+    }
+
+    /**
+     * Invoke the command.
+     * @param[out]  output  The input stream for the command execution.
+     * @param[out]  error   The input stream for the command execution.
+     * @return              The appropriate console return code { -1, 0, 1 }.
+     */
+    BCX_API virtual console_result invoke(std::ostream& output,
+        std::ostream& cerr);
+
+    /* Properties */
+
+    /**
+     * Get the value of the server-url arguments.
+     */
+    BCX_API virtual std::vector<std::string>& get_server_urls_argument()
+    {
+        return argument_.server_urls;
+    }
+
+    /**
+     * Set the value of the server-url arguments.
+     */
+    BCX_API virtual void set_server_urls_argument(
+        const std::vector<std::string>& value)
+    {
+        argument_.server_urls = value;
+    }
+
+    /**
+     * Get the value of the format option.
+     */
+    BCX_API virtual primitives::encoding& get_format_option()
+    {
+        return option_.format;
+    }
+
+    /**
+     * Set the value of the format option.
+     */
+    BCX_API virtual void set_format_option(
+        const primitives::encoding& value)
+    {
+        option_.format = value;
+    }
+
+    /**
+     * Get the value of the samples option.
+     */
+    BCX_API virtual size_t& get_samples_option()
+    {
+        return option_.samples;
+    }
+
+    /**
+     * Set the value of the samples option.
+     */
+    BCX_API virtual void set_samples_option(
+        const size_t& value)
+    {
+        option_.samples = value;
+    }
+
+private:
+
+    /**
+     * Command line argument bound variables.
+     * Uses cross-compiler safe constructor-based zeroize.
+     * Zeroize for unit test consistency with program_options initialization.
+     */
+    struct argument
+    {
+        argument()
+          : server_urls()
+        {
+        }
+
+        std::vector<std::string> server_urls;
+    } argument_;
+
+    /**
+     * Command line option bound variables.
+     * Uses cross-compiler safe constructor-based zeroize.
+     * Zeroize for unit test consistency with program_options initialization.
+     */
+    struct option
+    {
+        option()
+          : format(),
+            samples()
+        {
+        }
+
+        primitives::encoding format;
+        size_t samples;
+    } option_;
+};
+
+} // namespace commands
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -148,7 +148,7 @@ public:
         (
             "format,f",
             value<primitives::encoding>(&option_.format),
-            "The output format. Options are 'info', 'json' and 'xml', defaults to 'info'."
+            "The output format. Options are 'info', 'json', 'ndjson' and 'xml', defaults to 'info'."
         );
 
         return options;
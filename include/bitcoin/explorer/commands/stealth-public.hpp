@@ -141,6 +141,19 @@ public:
         load_input(get_shared_secret_argument(), "SHARED_SECRET", variables, input);
     }
 
+    /**
+     * Bind program arguments directly, without the program options parser.
+     * @param[in]  argc  The number of elements in the argv parameter.
+     * @param[in]  argv  Array of command line arguments excluding process.
+     * @return           True if all arguments are bound.
+     */
+    BCX_API virtual bool bind_arguments(int argc, const char* argv[])
+    {
+        return argc == 3 &&
+            bind_token(argument_.spend_pubkey, argv[1]) &&
+            bind_token(argument_.shared_secret, argv[2]);
+    }
+
     /**
      * Load program option definitions.
      * BUGBUG: see boost bug/fix: svn.boost.org/trac/boost/ticket/8009
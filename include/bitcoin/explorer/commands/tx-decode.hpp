@@ -150,7 +150,7 @@ public:
         (
             "format,f",
             value<primitives::encoding>(&option_.format),
-            "The output format. Options are 'info', 'json' and 'xml', defaults to 'info'."
+            "The output format. Options are 'csv', 'info', 'json', 'ndjson', 'tsv' and 'xml', defaults to 'info'."
         )
         (
             "TRANSACTION",
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_CONNECTION_MANAGER_HPP
+#define BX_CONNECTION_MANAGER_HPP
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/command.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Class to share server connections between commands in a process.
+ * Each server connection is a single socket over which any number of calls
+ * may be outstanding, and remains open after the command completes.
+ */
+class connection_manager
+{
+public:
+
+    /**
+     * Get the connection manager that is shared by the process.
+     * @return  The connection manager.
+     */
+    BCX_API static connection_manager& instance();
+
+    /**
+     * Get the servers configured for the network of the specified command,
+     * in order of preference. If the command has a server ranking file the
+     * ranked servers are preferred in ranked order.
+     * @param[in]  command  The command.
+     * @return              The server addresses.
+     */
+    BCX_API static std::vector<std::string> servers(command& command);
+
+    /**
+     * Get the client for the specified server, connecting on first use.
+     * @param[in]  server   The server address.
+     * @param[in]  timeout  The call timeout.
+     * @param[in]  retries  The number of retries allowed.
+     * @return              The connected client, or nullptr on failure.
+     */
+    BCX_API virtual std::shared_ptr<obelisk_client> connect(
+        const std::string& server, const client::period_ms& timeout,
+        uint8_t retries);
+
+    /**
+     * Get the client for the specified servers, connecting on first use.
+     * Calls are hedged across the servers, in order of preference.
+     * @param[in]  servers  The server addresses, in order of preference.
+     * @param[in]  timeout  The call timeout.
+     * @param[in]  retries  The number of retries allowed.
+     * @param[in]  hedge    The initial delay before a call is hedged.
+     * @return              The connected client, or nullptr on failure.
+     */
+    BCX_API virtual std::shared_ptr<obelisk_client> connect(
+        const std::vector<std::string>& servers,
+        const client::period_ms& timeout, uint8_t retries,
+        const client::period_ms& hedge);
+
+    /**
+     * Close all connections.
+     */
+    BCX_API virtual void disconnect();
+
+    /**
+     * Get the wire metrics of the calls of all connections, by command.
+     * @return  The metrics.
+     */
+    BCX_API virtual wire_report metrics();
+
+    /**
+     * Discard the wire metrics of all connections.
+     */
+    BCX_API virtual void reset_metrics();
+
+private:
+
+    /**
+     * Clients are distinguished by call policy as well as server, since the
+     * codec of each client is constructed with the policy.
+     */
+    typedef std::tuple<std::vector<std::string>, client::period_ms::rep,
+        uint8_t, client::period_ms::rep> key;
+
+    /* The context must outlive the clients, so is declared first. */
+    czmqpp::context context_;
+    std::map<key, std::shared_ptr<obelisk_client>> clients_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -110,8 +110,12 @@ enum console_result : int
  */
 enum class encoding_engine
 {
+    binary,
+    csv,
     info,
     json,
+    ndjson,
+    tsv,
     xml
 };
 
@@ -125,4 +129,14 @@ struct BCX_API wrapped_data
     bc::data_chunk payload;
 };
 
+/**
+ * Definition of the totals of a set of balance rows.
+ */
+struct BCX_API balance_totals
+{
+    uint64_t confirmed;
+    uint64_t received;
+    uint64_t unspent;
+};
+
 #endif
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_DELIMITED_WRITER_HPP
+#define BX_DELIMITED_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Determine whether an encoding is a delimited text encoding.
+ * @param[in]  engine  The encoding.
+ * @return             True if the encoding is csv or tsv.
+ */
+BCX_API bool is_delimited(encoding_engine engine);
+
+/**
+ * Writer of the delimited text encodings, which writes each row of a table
+ * as a line of fields in a fixed column order, directly from the rows rather
+ * than from a property tree. Numbers and hashes are written directly to the
+ * stream. The csv encoding separates fields with a comma, and a field that
+ * contains a comma, a quote or a line break is quoted, with its quotes
+ * doubled. The tsv encoding separates fields with a tab, and escapes the
+ * backslashes, tabs and line breaks of a field as a C string literal does. A
+ * field that is missing from the property tree of a row, such as the spend of
+ * an unspent transfer, is empty.
+ */
+class delimited_writer
+{
+public:
+
+    /**
+     * Construct the writer.
+     * @param[out] output  The output stream to write to.
+     * @param[in]  engine  The delimited encoding, csv or tsv.
+     */
+    BCX_API delimited_writer(std::ostream& output, encoding_engine engine);
+
+    /**
+     * Write the column names of the history table.
+     */
+    BCX_API virtual void history_columns();
+
+    /**
+     * Write the history table rows of the history rows of an address.
+     * @param[in]  rows             The set of history rows.
+     * @param[in]  history_address  The payment address for the history rows.
+     */
+    BCX_API virtual void history(const std::vector<client::history_row>& rows,
+        const payment_address& history_address);
+
+    /**
+     * Write the column names of the balance table.
+     */
+    BCX_API virtual void balance_columns();
+
+    /**
+     * Write the balance table row of the balance rows of an address.
+     * @param[in]  rows             The set of balance rows.
+     * @param[in]  balance_address  The payment address for the balance rows.
+     */
+    BCX_API virtual void balance(const std::vector<balance_row>& rows,
+        const payment_address& balance_address);
+
+    /**
+     * Write the column names of the stealth table.
+     */
+    BCX_API virtual void stealth_columns();
+
+    /**
+     * Write the stealth table rows of a set of stealth rows.
+     * @param[in]  rows  The set of stealth rows.
+     */
+    BCX_API virtual void stealth(const std::vector<client::stealth_row>& rows);
+
+    /**
+     * Write the column names of the transaction table.
+     */
+    BCX_API virtual void transaction_columns();
+
+    /**
+     * Write the transaction table rows of a transaction, one for each input
+     * followed by one for each output.
+     * @param[in]  tx  The transaction.
+     */
+    BCX_API virtual void transaction(const tx_type& tx);
+
+private:
+    void columns(const std::vector<std::string>& names);
+    void separate();
+    void field(const std::string& text);
+    void field(uint64_t value);
+    void field(const hash_digest& hash);
+    void field(const data_chunk& data);
+    void base16_field(const uint8_t* data, size_t size);
+    void end_row();
+
+    std::ostream& output_;
+    char delimiter_;
+    const char* special_;
+    bool first_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <bitcoin/explorer/command.hpp>
 #include <bitcoin/explorer/define.hpp>
@@ -30,6 +31,16 @@
 
 namespace libbitcoin {
 namespace explorer {
+
+/**
+ * The command line switch that selects batch dispatch.
+ */
+#define BX_BATCH_OPTION "--batch"
+
+/**
+ * The batch request that writes the wire metrics of the process as JSON.
+ */
+#define BX_STATS_OPTION "--stats"
    
 /**
  * Dispatch the command with the raw arguments as provided on the command line.
@@ -43,6 +54,41 @@ namespace explorer {
 BCX_API console_result dispatch(int argc, const char* argv[],
     std::istream& input, std::ostream& output, std::ostream& error);
 
+/**
+ * Invoke a command for each line of the input stream within this process.
+ * Each line is a command name followed by its arguments, quoted as in a
+ * unix shell. Empty lines are skipped. The result of each command is written
+ * to the output stream as a header line of the form:
+ * "<console_result> <output byte count> <error byte count>", followed by the
+ * command output bytes and then the command error bytes. The output stream is
+ * flushed after each frame so that a driver may interleave requests. A line
+ * of "--stats" is answered with the wire metrics of the process as JSON.
+ * A failure to read the input stream ends the batch with an error.
+ * @param[in]  input   The input stream of command lines (e.g. STDIO).
+ * @param[in]  output  The output stream for framed results (e.g. STDOUT).
+ * @param[in]  error   The error stream for input failures (e.g. STDERR).
+ * @return             The appropriate console return code { -1, 0, 1 }.
+ */
+BCX_API console_result dispatch_batch(std::istream& input,
+    std::ostream& output, std::ostream& error);
+
+/**
+ * Invoke the command identified by the specified arguments, as received from
+ * a driver process. The command is not given an input stream, so stdin
+ * fallbacks are empty. Exceptions are reported to the error stream. The
+ * single argument "--stats" writes the wire metrics of the process as JSON,
+ * covering the calls since the process started or since the last command
+ * invoked with its stats option. The batch option and the serve and
+ * watch-address commands are rejected, as each runs until the process is
+ * signalled and so would block the caller.
+ * @param[in]  args    The command symbolic name followed by its arguments.
+ * @param[in]  output  The output stream for the command.
+ * @param[in]  error   The error stream for the command.
+ * @return             The appropriate console return code { -1, 0, 1 }.
+ */
+BCX_API console_result dispatch_command(const std::vector<std::string>& args,
+    std::ostream& output, std::ostream& error);
+
 /**
  * Invoke the command identified by the specified arguments.
  * The first argument in the array is the command symbolic name.
@@ -56,6 +102,18 @@ BCX_API console_result dispatch(int argc, const char* argv[],
 BCX_API console_result dispatch_invoke(int argc, const char* argv[],
     std::istream& input, std::ostream& output, std::ostream& error);
 
+/**
+ * Bind command line arguments and default settings without the program
+ * options parser. This succeeds only for commands with simple positional
+ * arguments when all are provided, no option (including help or config) is
+ * specified and the environment does not specify a configuration file.
+ * @param[in]  instance  The command instance for the current command.
+ * @param[in]  argc      The number of elements in the argv parameter.
+ * @param[in]  argv      Array of command line arguments excluding process.
+ * @return               True if the command is ready to invoke.
+ */
+BCX_API bool bind_variables(command& instance, int argc, const char* argv[]);
+
 /**
  * Get the config option value from the variable map.
  * @param[in]  variables  The variable map to read the config option from.
@@ -71,6 +129,13 @@ BCX_API boost::filesystem::path get_config_option(
  */
 BCX_API bool get_help_option(po::variables_map& variables);
 
+/**
+ * Get the stats option value from the variable map.
+ * @param[in]  variables  The variable map to read the stats option from.
+ * @return                True if the stats option is set.
+ */
+BCX_API bool get_stats_option(po::variables_map& variables);
+
 /**
  * Load command line variables.
  * @param[out] variables  The variable map to populate.
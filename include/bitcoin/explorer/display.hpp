@@ -70,6 +70,24 @@ BCX_API void display_invalid_parameter(std::ostream& stream,
 BCX_API void display_unexpected_exception(std::ostream& stream,
     const std::string& message);
 
+/**
+ * Write an error message to a stream that the specified explorer command
+ * cannot be invoked as a request to a running process.
+ * @param[in]  stream   The stream to write into.
+ * @param[in]  command  The value that was attempted as a command.
+ */
+BCX_API void display_invalid_request(std::ostream& stream,
+    const std::string& command);
+
+/**
+ * Write an error message to a stream that the command does not write the
+ * specified output format.
+ * @param[in]  stream  The stream to write into.
+ * @param[in]  engine  The unsupported output format.
+ */
+BCX_API void display_unsupported_format(std::ostream& stream,
+    const primitives::encoding& engine);
+
 /**
  * Write usage instructions (help) to a tream for the explorer command line.
  * @param[in]  stream   The stream to write into.
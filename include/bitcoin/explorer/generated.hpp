@@ -74,10 +74,13 @@
 #include <bitcoin/explorer/commands/input-set.hpp>
 #include <bitcoin/explorer/commands/input-sign.hpp>
 #include <bitcoin/explorer/commands/input-validate.hpp>
+#include <bitcoin/explorer/commands/load-test.hpp>
 #include <bitcoin/explorer/commands/mnemonic-decode.hpp>
 #include <bitcoin/explorer/commands/mnemonic-encode.hpp>
 #include <bitcoin/explorer/commands/mpk.hpp>
 #include <bitcoin/explorer/commands/newseed.hpp>
+#include <bitcoin/explorer/commands/prewarm-tx.hpp>
+#include <bitcoin/explorer/commands/probe-servers.hpp>
 #include <bitcoin/explorer/commands/qrcode.hpp>
 #include <bitcoin/explorer/commands/ripemd160.hpp>
 #include <bitcoin/explorer/commands/satoshi-to-btc.hpp>
@@ -89,6 +92,7 @@
 #include <bitcoin/explorer/commands/send-tx-node.hpp>
 #include <bitcoin/explorer/commands/send-tx-p2p.hpp>
 #include <bitcoin/explorer/commands/sendtx-bci.hpp>
+#include <bitcoin/explorer/commands/serve.hpp>
 #include <bitcoin/explorer/commands/settings.hpp>
 #include <bitcoin/explorer/commands/sha160.hpp>
 #include <bitcoin/explorer/commands/sha256.hpp>
@@ -101,6 +105,7 @@
 #include <bitcoin/explorer/commands/stealth-public.hpp>
 #include <bitcoin/explorer/commands/stealth-secret.hpp>
 #include <bitcoin/explorer/commands/stealth-shared.hpp>
+#include <bitcoin/explorer/commands/sync-headers.hpp>
 #include <bitcoin/explorer/commands/tx-decode.hpp>
 #include <bitcoin/explorer/commands/tx-encode.hpp>
 #include <bitcoin/explorer/commands/tx-sign.hpp>
@@ -124,6 +129,8 @@ namespace explorer {
 /**
  * Various shared localizable strings.
  */
+#define BX_BATCH_READ_FAILURE \
+    "Could not read the batch input."
 #define BX_COMMANDS_HEADER \
     "Info: The bx commands are:"
 #define BX_COMMANDS_HOME_PAGE \
@@ -136,12 +143,18 @@ namespace explorer {
     "Could not connect to server: %1%"
 #define BX_DEPRECATED_COMMAND \
     "The '%1%' command has been replaced by '%2%'."
+#define BX_HEADER_CACHE_FAILURE \
+    "Could not open the header cache: %1%"
 #define BX_HELP_DESCRIPTION \
     "Get a description and instructions for this command."
+#define BX_HISTORY_CACHE_FAILURE \
+    "Could not open the history cache: %1%"
 #define BX_INVALID_COMMAND \
     "'%1%' is not a bx command. Enter 'bx help' for a list of commands."
 #define BX_INVALID_PARAMETER \
     "Error: %1%"
+#define BX_INVALID_REQUEST \
+    "The '%1%' command cannot be sent as a request."
 #define BX_PRINTER_ARGUMENT_TABLE_HEADER \
     "Arguments (positional):"
 #define BX_PRINTER_DESCRIPTION_FORMAT \
@@ -152,8 +165,25 @@ namespace explorer {
     "Usage: %1% %2% %3%"
 #define BX_PRINTER_VALUE_TEXT \
     "VALUE"
+#define BX_STATS_DESCRIPTION \
+    "Write the wire metrics of the server calls made by the command to STDERR, in the output format of the command."
+#define BX_TRANSACTION_CACHE_FAILURE \
+    "Could not open the transaction cache: %1%"
 #define BX_UNEXPECTED_EXCEPTION \
     "Unexpected error: %1%"
+#define BX_UNSUPPORTED_FORMAT \
+    "The '%1%' format is not supported by this command."
+
+/**
+ * Command metadata that is available without constructing the command.
+ */
+struct command_metadata
+{
+    const char* name;
+    const char* category;
+    const char* description;
+    bool obsolete;
+};
 
 /**
  * Invoke a specified function on all commands.
@@ -162,6 +192,14 @@ namespace explorer {
 BCX_API void broadcast(
     const std::function<void(std::shared_ptr<command>)> func);
 
+/**
+ * Invoke a specified function on the metadata of all commands.
+ * No command is constructed, so this is preferred for listing commands.
+ * @param[in]  func  The function to invoke on the metadata of each command.
+ */
+BCX_API void broadcast_metadata(
+    const std::function<void(const command_metadata&)> func);
+
 /**
  * Find the command identified by the specified symbolic command name.
  * @param[in]  symbol  The symbolic command name.
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_HEADER_STORE_HPP
+#define BX_HEADER_STORE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Class to persist a verified chain of block headers between invocations.
+ * The file is memory mapped and holds the 80 byte satoshi serialization of
+ * each header at a fixed stride, so the header at a height is read directly.
+ * The number of headers is committed only after the headers are written.
+ * Linkage, proof of work and difficulty retargeting are verified, but the
+ * chain is not compared to the work of any other, so a server can still
+ * withhold a stronger chain.
+ * The file is locked against other processes for the lifetime of the store.
+ */
+class header_store
+{
+public:
+
+    /**
+     * Verify the linkage and proof of work of a sequence of headers. Hashes
+     * and proof of work are computed in parallel, linkage in order.
+     * @param[in]  headers   The headers, in height order.
+     * @param[in]  previous  The hash of the header preceding the first.
+     * @param[in]  threads   The number of threads, zero for one per core.
+     * @return               The number of leading headers that are valid.
+     */
+    BCX_API static size_t verify(
+        const std::vector<block_header_type>& headers,
+        const hash_digest& previous, size_t threads=0);
+
+    /**
+     * Open or create the header file at the specified path.
+     * @param[in]  path  The path of the header file.
+     */
+    BCX_API header_store(const boost::filesystem::path& path);
+
+    /**
+     * Determine whether the header file is open and well formed.
+     * @return  True if the store is usable.
+     */
+    BCX_API virtual bool valid() const;
+
+    /**
+     * Get the number of stored headers, which are those of heights below it.
+     * @return  The number of headers.
+     */
+    BCX_API virtual size_t count() const;
+
+    /**
+     * Get the hash of the last stored header.
+     * @return  The hash, or null_hash if no headers are stored.
+     */
+    BCX_API virtual hash_digest top_hash() const;
+
+    /**
+     * Get the header at a height.
+     * @param[out] header  The header.
+     * @param[in]  height  The block height.
+     * @return             True if the header is stored.
+     */
+    BCX_API virtual bool read(block_header_type& header, size_t height) const;
+
+    /**
+     * Get a header by its hash, searching down from the last stored header.
+     * Only the last stored header is hashed, a miss reads the chain once.
+     * @param[out] header  The header.
+     * @param[in]  hash    The block hash.
+     * @return             True if the header is stored.
+     */
+    BCX_API virtual bool find(block_header_type& header,
+        const hash_digest& hash) const;
+
+    /**
+     * Verify the difficulty of headers that continue the stored chain. Each
+     * header carries the bits of its predecessor, other than at a retarget
+     * height, where the bits are scaled by the timespan of the preceding
+     * period. On testnet a header more than twenty minutes after its
+     * predecessor may instead carry the minimum difficulty.
+     * @param[in]  headers  The headers that follow the last stored header.
+     * @param[in]  testnet  Apply the testnet minimum difficulty rule.
+     * @return              The number of leading headers that are valid.
+     */
+    BCX_API virtual size_t verify_difficulty(
+        const std::vector<block_header_type>& headers, bool testnet) const;
+
+    /**
+     * Append headers that have been verified against the last stored header.
+     * @param[in]  headers  The headers, in height order.
+     * @return              True if the headers were stored.
+     */
+    BCX_API virtual bool append(
+        const std::vector<block_header_type>& headers);
+
+    /**
+     * Remove the headers at and above a height, such as those of a chain
+     * that has been replaced by a reorganization.
+     * @param[in]  count  The number of headers to retain.
+     * @return            True if the headers were removed.
+     */
+    BCX_API virtual bool truncate(size_t count);
+
+private:
+
+    bool load();
+    void commit(size_t count);
+
+    std::shared_ptr<boost::interprocess::file_lock> lock_;
+    std::unique_ptr<mmfile> file_;
+    size_t count_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
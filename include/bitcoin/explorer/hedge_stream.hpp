@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_HEDGE_STREAM_HPP
+#define BX_HEDGE_STREAM_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Message stream to hedge calls across a set of servers. Each call is sent to
+ * the fastest known server and, if no reply arrives within the hedge delay,
+ * is duplicated to the next fastest server. Duplicates share the call id, so
+ * the codec accepts the first reply and ignores any later reply as unknown.
+ */
+class hedge_stream
+  : public client::message_stream
+{
+public:
+
+    /**
+     * The number of latency samples required before the hedge delay is
+     * taken from the observed latency distribution.
+     */
+    BCX_API static const size_t minimum_samples;
+
+    /**
+     * The number of most recent latency samples retained.
+     */
+    BCX_API static const size_t maximum_samples;
+
+    /**
+     * The latency percentile at which calls are hedged.
+     */
+    BCX_API static const size_t hedge_percentile;
+
+    /**
+     * Initialization constructor.
+     * @param[in]  delay   The hedge delay used until sufficient latency has
+     *                     been observed, zero disables hedging.
+     * @param[in]  expiry  The period after which an unanswered call is
+     *                     abandoned, zero never abandons a call.
+     */
+    BCX_API hedge_stream(const client::period_ms& delay,
+        const client::period_ms& expiry=client::period_ms(0));
+
+    /**
+     * Add a server, in order of preference.
+     * @param[in]  server  The outbound message stream of the server.
+     * @return             The index of the server.
+     */
+    BCX_API virtual size_t add(std::shared_ptr<client::message_stream> server);
+
+    /**
+     * Send a call to the fastest known server.
+     * @param[in]  data  The call message.
+     */
+    BCX_API virtual void write(const data_stack& data);
+
+    /**
+     * Record a reply, which cancels any pending hedge of the call.
+     * @param[in]  server  The index of the replying server.
+     * @param[in]  data    The reply message.
+     */
+    BCX_API virtual void reply(size_t server, const data_stack& data);
+
+    /**
+     * Hedge each call that has waited beyond the hedge delay.
+     * @return  The period until the next hedge, zero if none is pending.
+     */
+    BCX_API virtual client::period_ms wakeup();
+
+    /**
+     * Get the current hedge delay.
+     * @return  The hedge delay, zero if hedging is disabled.
+     */
+    BCX_API virtual client::period_ms delay() const;
+
+    /**
+     * Get the number of calls resent by the codec, as identified by the
+     * reuse of an outstanding call id.
+     * @return  The number of retries.
+     */
+    BCX_API virtual size_t retries() const;
+
+    /**
+     * Get the number of calls duplicated to another server.
+     * @return  The number of hedges.
+     */
+    BCX_API virtual size_t hedges() const;
+
+private:
+
+    typedef std::chrono::steady_clock clock;
+
+    struct call
+    {
+        data_stack data;
+        clock::time_point sent;
+        clock::time_point hedge;
+        std::vector<size_t> order;
+        size_t next;
+    };
+
+    std::vector<size_t> order() const;
+    void sample(size_t server, const clock::duration& latency);
+
+    const client::period_ms delay_;
+    const client::period_ms expiry_;
+    std::vector<std::shared_ptr<client::message_stream>> servers_;
+    std::vector<clock::duration::rep> averages_;
+    std::vector<client::period_ms::rep> samples_;
+    size_t sample_;
+    size_t retries_;
+    size_t hedges_;
+    std::map<data_chunk, call> calls_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_HISTORY_CACHE_HPP
+#define BX_HISTORY_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Class to persist the confirmed history of addresses between invocations.
+ * The file is memory mapped and append-only. An address is refreshed from a
+ * few blocks below the height to which it is synced, so that a receive or
+ * spend removed or moved by a reorganization is corrected. Each record holds
+ * the confirmed rows of an address fetched from its refresh height, which
+ * replace the cached rows received or spent at or above that height, along
+ * with the synced height. Unconfirmed rows are merged into the result but
+ * never persisted. The file is locked against other processes for the
+ * lifetime of the cache.
+ */
+class history_cache
+{
+public:
+
+    /**
+     * Open or create the cache file at the specified path.
+     * @param[in]  path  The path of the cache file.
+     */
+    BCX_API history_cache(const boost::filesystem::path& path);
+
+    /**
+     * Determine whether the cache file is open and well formed.
+     * @return  True if the cache is usable.
+     */
+    BCX_API virtual bool valid() const;
+
+    /**
+     * Get the height from which the address must be refreshed.
+     * @param[in]  address  The payment address.
+     * @return              The synced height less the reorganization depth,
+     *                      zero if the address is unknown.
+     */
+    BCX_API virtual size_t height(const payment_address& address) const;
+
+    /**
+     * Merge rows fetched from the refresh height into the cached history,
+     * replacing the cached rows received or spent at or above that height.
+     * @param[in]  address  The payment address.
+     * @param[in]  rows     The rows fetched from the refresh height.
+     * @return              The complete history of the address.
+     */
+    BCX_API virtual client::history_list merge(
+        const payment_address& address, const client::history_list& rows);
+
+private:
+
+    typedef std::pair<uint8_t, short_hash> key;
+
+    struct entry
+    {
+        uint32_t height;
+        std::vector<size_t> records;
+    };
+
+    bool load();
+    client::history_list read(const entry& cached) const;
+    bool append(const key& address, uint32_t from, uint32_t height,
+        const client::history_list& rows);
+
+    std::shared_ptr<boost::interprocess::file_lock> lock_;
+    std::unique_ptr<mmfile> file_;
+    size_t end_;
+    std::map<key, entry> entries_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
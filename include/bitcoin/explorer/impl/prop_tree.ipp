@@ -23,6 +23,7 @@
 #include <string>
 #include <boost/property_tree/ptree.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
 
 /* NOTE: don't declare 'using namespace foo' in headers. */
 
@@ -54,6 +55,18 @@ pt::ptree prop_value_list(const std::string& name, const Values& values)
     return list;
 }
 
+template <typename Values>
+void prop_tree_list(stream_writer& writer, const std::string& name,
+    const Values& values)
+{
+    for (const auto& value: values)
+    {
+        writer.open(name);
+        prop_list(writer, value);
+        writer.close();
+    }
+}
+
 } // namespace primitives
 } // namespace explorer
 } // namespace libbitcoin
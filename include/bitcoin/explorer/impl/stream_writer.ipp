@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_STREAM_WRITER_IPP
+#define BX_STREAM_WRITER_IPP
+
+#include <string>
+#include <boost/property_tree/ptree.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+// Values are translated as pt::ptree::put translates them, which is what
+// keeps the streamed encodings identical to those of the tree.
+template <typename Value>
+void stream_writer::put(const std::string& name, const Value& value)
+{
+    typedef typename pt::translator_between<std::string, Value>::type
+        translator;
+
+    const auto text = translator().put_value(value);
+    if (text)
+        write(name, *text);
+}
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -71,6 +71,24 @@ Consequent if_else(bool antecedent, const Consequent consequent,
         return alternative;
 }
 
+template <typename Value>
+bool bind_token(Value& value, const char* token)
+{
+    if (token == nullptr || token[0] == '-')
+        return false;
+
+    try
+    {
+        value = boost::lexical_cast<Value>(std::string(token));
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+
+    return true;
+}
+
 template <typename Value>
 void deserialize(Value& value, const std::string& text)
 {
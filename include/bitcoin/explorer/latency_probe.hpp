@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_LATENCY_PROBE_HPP
+#define BX_LATENCY_PROBE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * The observed latency and height of a server, with the latency of each
+ * answered request in microseconds.
+ */
+struct BCX_API server_probe
+{
+    std::string server;
+    wire_histogram latencies;
+    size_t failures;
+    size_t height;
+    size_t lag;
+};
+
+/**
+ * Class to measure and rank the responsiveness of a set of servers. Each
+ * server is sent a sequence of last height requests, one at a time, and the
+ * servers are probed in parallel.
+ */
+class latency_probe
+{
+public:
+
+    /**
+     * The number of blocks a server may lag the highest server and remain
+     * healthy.
+     */
+    BCX_API static const size_t maximum_lag;
+
+    /**
+     * Initialization constructor.
+     * @param[in]  timeout  The request timeout.
+     * @param[in]  samples  The number of requests to send to each server.
+     */
+    BCX_API latency_probe(const client::period_ms& timeout, size_t samples);
+
+    /**
+     * Probe the specified servers in parallel.
+     * @param[in]  servers  The server addresses.
+     * @return              The probe of each server, in ranked order.
+     */
+    BCX_API virtual std::vector<server_probe> probe(
+        const std::vector<std::string>& servers);
+
+    /**
+     * Determine whether a probed server is healthy. A healthy server has
+     * answered every request and does not lag beyond the maximum.
+     * @param[in]  probe  The server probe.
+     * @return            True if the server is healthy.
+     */
+    BCX_API static bool healthy(const server_probe& probe);
+
+    /**
+     * Compute the height lag of each probe and order the probes by health
+     * and then by median latency.
+     * @param[in,out]  probes  The server probes to rank.
+     */
+    BCX_API static void rank(std::vector<server_probe>& probes);
+
+private:
+
+    /**
+     * Probe a single server.
+     * @param[in]  context  The zmq context.
+     * @param[in]  probe    The probe to populate, with the server address set.
+     */
+    void probe_server(czmqpp::context& context, server_probe& probe);
+
+    const client::period_ms timeout_;
+    const size_t samples_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
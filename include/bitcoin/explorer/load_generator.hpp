@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_LOAD_GENERATOR_HPP
+#define BX_LOAD_GENERATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * The outcome of a load test against a server, with the latency of each
+ * completed call in microseconds.
+ */
+struct BCX_API load_report
+{
+    client::period_ms::rep duration;
+    size_t concurrency;
+    size_t rate;
+    size_t calls;
+    size_t completed;
+    size_t failures;
+    size_t timeouts;
+    size_t retries;
+    size_t hedges;
+    wire_histogram latencies;
+};
+
+/**
+ * Class to drive load against a server. Last height, block header,
+ * transaction and history calls are issued in rotation, keeping up to the
+ * concurrency limit outstanding, paced to a target rate, for a fixed
+ * duration. Calls that fall behind the schedule are not made up later.
+ */
+class load_generator
+{
+public:
+
+    /**
+     * Initialization constructor.
+     * @param[in]  concurrency  The maximum number of outstanding calls.
+     * @param[in]  rate         The target calls per second, zero is unpaced.
+     */
+    BCX_API load_generator(size_t concurrency, size_t rate);
+
+    /**
+     * Issue calls for the duration, then wait for the outstanding calls to
+     * complete or expire.
+     * @param[in]  client    The connected client.
+     * @param[in]  duration  The period over which calls are issued.
+     * @return               The report of the run.
+     */
+    BCX_API virtual load_report run(obelisk_client& client,
+        const client::period_ms& duration);
+
+    /**
+     * Get the number of calls completed per second.
+     * @param[in]  report  The load report.
+     * @return             The throughput.
+     */
+    BCX_API static double throughput(const load_report& report);
+
+private:
+
+    struct tally
+    {
+        load_report report;
+        size_t outstanding;
+    };
+
+    void issue(obelisk_client& client, std::shared_ptr<tally> state);
+
+    const size_t concurrency_;
+    const size_t rate_;
+    size_t call_;
+    const payment_address address_;
+    const hash_digest transaction_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -20,9 +20,18 @@
 #ifndef BX_OBELISK_CLIENT_HPP
 #define BX_OBELISK_CLIENT_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 #include <czmq++/czmqpp.hpp>
 #include <bitcoin/client.hpp>
+#include <bitcoin/explorer/coalesce_stream.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/hedge_stream.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
 
 /* NOTE: don't declare 'using namespace foo' in headers. */
 
@@ -36,18 +45,27 @@ class obelisk_client
 {
 public:
 
+    /**
+     * A handler invoked as polling wakes, which returns false to stop.
+     */
+    typedef std::function<bool()> poll_handler;
+
     /**
      * Initialization constructor.
      * @param[in]  context  The zmq context.
      * @param[in]  timeout  The call timeout, defaults to zero.
      * @param[in]  retries  The number of retries allowed, defaults to zero.
+     * @param[in]  hedge    The initial delay before a call is duplicated to
+     *                      the next server, defaults to zero (no hedging).
      */
     BCX_API obelisk_client(czmqpp::context& context,
         const client::period_ms& timeout=client::period_ms(0),
-        uint8_t retries=0);
+        uint8_t retries=0,
+        const client::period_ms& hedge=client::period_ms(0));
 
     /**
-     * Connect to the specified server address.
+     * Connect to the specified server address. Each additional server is
+     * used to hedge calls that are slow to be answered.
      * @param[in]  address  The server address.
      * @return              The connection status, negative for failure.
      */
@@ -59,12 +77,40 @@ public:
      */
     BCX_API virtual std::shared_ptr<client::obelisk_codec> get_codec();
     
+    /**
+     * Get the value of the stream property, which counts retries and hedges.
+     * @return The stream.
+     */
+    BCX_API virtual std::shared_ptr<hedge_stream> get_stream();
+
+    /**
+     * Get the value of the coalesce stream property, which counts the calls
+     * answered by the reply to an identical call.
+     * @return The coalesce stream.
+     */
+    BCX_API virtual std::shared_ptr<coalesce_stream> get_coalesce_stream();
+
+    /**
+     * Get the value of the metrics property, which records the latency,
+     * size, retries and timeouts of each call by command.
+     * @return The metrics.
+     */
+    BCX_API virtual std::shared_ptr<wire_metrics> get_metrics();
+
     /**
      * Resolve callback functions.
      * @return True if not terminated before completion.
      */
     BCX_API virtual bool resolve_callbacks();
 
+    /**
+     * Wait up to the period for one reply, then signal the error callbacks
+     * of any expired calls, so the caller can issue calls as others resolve.
+     * @param[in]  period  The longest wait, zero returns once no call is due.
+     * @return             True if not terminated.
+     */
+    BCX_API virtual bool poll(const client::period_ms& period);
+
     /**
      * Poll the connection until the request times out or terminates.
      * @param[in]  timeout  The poll timeout, defaults to zero.
@@ -72,10 +118,35 @@ public:
     BCX_API virtual void poll_until_termination(
         const client::period_ms& timeout=client::period_ms(0));
 
+    /**
+     * Poll the connection until it terminates or the handler returns false.
+     * The handler is invoked after each reply and each expiry of the timeout.
+     * @param[in]  timeout  The poll timeout.
+     * @param[in]  handler  The handler invoked as polling wakes.
+     */
+    BCX_API virtual void poll_until_termination(
+        const client::period_ms& timeout, const poll_handler& handler);
+
 private:
 
-    czmqpp::socket socket_;
-    std::shared_ptr<client::socket_stream> stream_;
+    /**
+     * Read one reply from the server socket that is ready.
+     * @param[in]  ready  The socket returned by the poller.
+     */
+    void receive(czmqpp::socket& ready);
+
+    /**
+     * Forget the coalesced calls once the codec has none outstanding.
+     */
+    void forget_abandoned();
+
+    czmqpp::context& context_;
+    std::vector<std::shared_ptr<czmqpp::socket>> sockets_;
+    std::vector<std::shared_ptr<client::socket_stream>> streams_;
+    std::vector<std::shared_ptr<client::message_stream>> replies_;
+    std::shared_ptr<hedge_stream> hedge_;
+    std::shared_ptr<coalesce_stream> coalesce_;
+    std::shared_ptr<wire_metrics> metrics_;
     std::shared_ptr<client::obelisk_codec> codec_;
 };
 
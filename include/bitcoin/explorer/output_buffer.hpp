@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_OUTPUT_BUFFER_HPP
+#define BX_OUTPUT_BUFFER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * The conditions under which buffered output is written through to its
+ * stream. Output is written through once the size is buffered or once the
+ * interval has elapsed since it was last written through, as checked on each
+ * flush of the buffer and on each call to write_due. A zero size or interval
+ * is not a condition. With neither condition each flush writes through, as
+ * for interactive use.
+ */
+struct BCX_API flush_policy
+{
+    size_t size;
+    client::period_ms interval;
+};
+
+/**
+ * Stream buffer that holds output for a stream according to a flush policy,
+ * so that a flush per line or row does not cost a write to the stream. The
+ * held output is written through when the buffer is destroyed.
+ */
+class output_buffer
+  : public std::streambuf
+{
+public:
+
+    /**
+     * Initialization constructor.
+     * @param[out] sink    The stream to which output is written through.
+     * @param[in]  policy  The flush policy.
+     */
+    BCX_API output_buffer(std::ostream& sink, const flush_policy& policy);
+
+    /**
+     * Write through any held output.
+     */
+    BCX_API virtual ~output_buffer();
+
+    /**
+     * Write through any held output and flush the stream, regardless of the
+     * flush policy.
+     */
+    BCX_API virtual void write_through();
+
+    /**
+     * Write through any held output if the flush policy makes it due, for
+     * periodic calls while no output is being written.
+     */
+    BCX_API virtual void write_due();
+
+    /**
+     * Get the size of the output held.
+     * @return  The size of the output held.
+     */
+    BCX_API virtual size_t held() const;
+
+protected:
+
+    /**
+     * Hold the output written so far, and the character if not eof.
+     */
+    virtual int_type overflow(int_type character);
+
+    /**
+     * Hold the output written so far and write through if due.
+     */
+    virtual int sync();
+
+private:
+
+    typedef std::chrono::steady_clock clock;
+
+    bool buffered() const;
+    bool due() const;
+    void hold();
+
+    std::ostream& sink_;
+    const flush_policy policy_;
+    std::vector<char> chunk_;
+    std::string held_;
+    clock::time_point written_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -26,6 +26,8 @@
 #include <boost/property_tree/ptree.hpp>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/latency_probe.hpp>
+#include <bitcoin/explorer/load_generator.hpp>
 #include <bitcoin/explorer/primitives/base2.hpp>
 #include <bitcoin/explorer/primitives/header.hpp>
 #include <bitcoin/explorer/primitives/input.hpp>
@@ -34,6 +36,8 @@
 #include <bitcoin/explorer/primitives/stealth.hpp>
 #include <bitcoin/explorer/primitives/transaction.hpp>
 #include <bitcoin/explorer/primitives/wrapper.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
 
 /* NOTE: don't declare 'using namespace foo' in headers. */
 
@@ -76,6 +80,17 @@ pt::ptree prop_tree_list(const std::string& name, const Values& values);
 template <typename Values>
 pt::ptree prop_value_list(const std::string& name, const Values& values);
 
+/**
+ * Stream an array of elements.
+ * @param      <Values>  The array element type.
+ * @param[out] writer    The writer to stream the elements to.
+ * @param[in]  name      The name of the list elements.
+ * @param[in]  values    The enumerable with elements of type Values.
+ */
+template <typename Values>
+void prop_tree_list(stream_writer& writer, const std::string& name,
+    const Values& values);
+
 /**
  * Generate a property list for a block header.
  * @param[in]  header  The header.
@@ -119,6 +134,47 @@ BCX_API pt::ptree prop_tree(const client::history_row& row);
  */
 BCX_API pt::ptree prop_tree(const std::vector<client::history_row>& rows);
 
+/**
+ * Generate a property tree for a set of history rows of an address.
+ * @param[in]  rows             The set of history rows.
+ * @param[in]  history_address  The payment address for the history rows.
+ * @return                      A property tree.
+ */
+BCX_API pt::ptree prop_tree(const std::vector<client::history_row>& rows,
+    const payment_address& history_address);
+
+/**
+ * Generate a property list for a history row, including the transactions of
+ * its received and spent hashes where they are available.
+ * @param[in]  row           The history row.
+ * @param[in]  transactions  The transactions indexed by hash.
+ * @return                   A property list.
+ */
+BCX_API pt::ptree prop_list(const client::history_row& row,
+    const std::map<hash_digest, tx_type>& transactions);
+
+/**
+ * Generate a property tree for a set of history rows, including the
+ * transactions of their received and spent hashes.
+ * @param[in]  rows          The set of history rows.
+ * @param[in]  transactions  The transactions indexed by hash.
+ * @return                   A property tree.
+ */
+BCX_API pt::ptree prop_tree(const std::vector<client::history_row>& rows,
+    const std::map<hash_digest, tx_type>& transactions);
+
+/**
+ * Generate a property tree for a set of history rows of an address,
+ * including the transactions of their received and spent hashes.
+ * @param[in]  rows             The set of history rows.
+ * @param[in]  history_address  The payment address for the history rows.
+ * @param[in]  transactions     The transactions indexed by hash.
+ * @return                      A property tree.
+ */
+BCX_API pt::ptree prop_tree(const std::vector<client::history_row>& rows,
+    const payment_address& history_address,
+    const std::map<hash_digest, tx_type>& transactions);
+
 /**
  * Generate a property list from balance rows for an address.
  * @param[in]  rows             The set of balance rows.
@@ -137,6 +193,22 @@ BCX_API pt::ptree prop_list(const std::vector<balance_row>& rows,
 BCX_API pt::ptree prop_tree(const std::vector<balance_row>& rows,
     const payment_address& balance_address);
 
+/**
+ * Generate a property list from the balance totals of a set of addresses.
+ * @param[in]  totals     The balance totals.
+ * @param[in]  addresses  The number of addresses in the totals.
+ * @return                A property list.
+ */
+BCX_API pt::ptree prop_list(const balance_totals& totals, size_t addresses);
+
+/**
+ * Generate a property tree from the balance totals of a set of addresses.
+ * @param[in]  totals     The balance totals.
+ * @param[in]  addresses  The number of addresses in the totals.
+ * @return                A property tree.
+ */
+BCX_API pt::ptree prop_tree(const balance_totals& totals, size_t addresses);
+
 /**
  * Generate a property list for a transaction input.
  * @param[in]  tx_input  The input.
@@ -358,6 +430,34 @@ BCX_API pt::ptree prop_list(const bc::hash_digest& hash, size_t height,
 BCX_API pt::ptree prop_tree(const bc::hash_digest& hash, size_t height,
     size_t index);
 
+/**
+ * Generate a property list for a load report.
+ * @param[in]  report  The load report.
+ * @return             A property list.
+ */
+BCX_API pt::ptree prop_list(const load_report& report);
+
+/**
+ * Generate a property tree for a load report.
+ * @param[in]  report  The load report.
+ * @return             A property tree.
+ */
+BCX_API pt::ptree prop_tree(const load_report& report);
+
+/**
+ * Generate a property list for a server probe.
+ * @param[in]  probe  The server probe.
+ * @return            A property list.
+ */
+BCX_API pt::ptree prop_list(const server_probe& probe);
+
+/**
+ * Generate a property tree for a set of server probes.
+ * @param[in]  probes  The set of server probes, in ranked order.
+ * @return             A property tree.
+ */
+BCX_API pt::ptree prop_tree(const std::vector<server_probe>& probes);
+
 /**
  * Create a property tree for the settings command.
  * @param[in]  settings   The list of settings.
@@ -372,6 +472,119 @@ BCX_API pt::ptree prop_tree(const settings_list& settings);
  */
 BCX_API pt::ptree prop_tree(const uri_parse_result& uri);
 
+/**
+ * Generate a property list for a histogram of durations.
+ * @param[in]  histogram  The histogram, in microseconds.
+ * @return                A property list.
+ */
+BCX_API pt::ptree prop_list(const wire_histogram& histogram);
+
+/**
+ * Generate a property list for the call metrics of a command.
+ * @param[in]  command  The command.
+ * @param[in]  metrics  The call metrics.
+ * @return              A property list.
+ */
+BCX_API pt::ptree prop_list(const std::string& command,
+    const call_metrics& metrics);
+
+/**
+ * Generate a property tree for the wire metrics of a set of commands.
+ * @param[in]  report  The call metrics by command.
+ * @return             A property tree.
+ */
+BCX_API pt::ptree prop_tree(const wire_report& report);
+
+// The streamed overloads write the same properties as the corresponding
+// property tree overloads, without holding the tree for the whole output.
+
+/**
+ * Stream the properties of a transaction input.
+ * @param[out] writer    The writer to stream the properties to.
+ * @param[in]  tx_input  The transaction input.
+ */
+BCX_API void prop_list(stream_writer& writer, const tx_input_type& tx_input);
+
+/**
+ * Stream the properties of a transaction output.
+ * @param[out] writer     The writer to stream the properties to.
+ * @param[in]  tx_output  The transaction output.
+ */
+BCX_API void prop_list(stream_writer& writer, const tx_output_type& tx_output);
+
+/**
+ * Stream the properties of a transaction.
+ * @param[out] writer       The writer to stream the properties to.
+ * @param[in]  transaction  The transaction.
+ */
+BCX_API void prop_list(stream_writer& writer, const transaction& transaction);
+
+/**
+ * Stream the property tree of a transaction.
+ * @param[out] writer       The writer to stream the tree to.
+ * @param[in]  transaction  The transaction.
+ */
+BCX_API void prop_tree(stream_writer& writer, const transaction& transaction);
+
+/**
+ * Stream the properties of a history row.
+ * @param[out] writer  The writer to stream the properties to.
+ * @param[in]  row     The history row.
+ */
+BCX_API void prop_list(stream_writer& writer, const client::history_row& row);
+
+/**
+ * Stream the properties of a history row, including the transactions of its
+ * received and spent hashes where they are available.
+ * @param[out] writer        The writer to stream the properties to.
+ * @param[in]  row           The history row.
+ * @param[in]  transactions  The transactions indexed by hash.
+ */
+BCX_API void prop_list(stream_writer& writer, const client::history_row& row,
+    const std::map<hash_digest, tx_type>& transactions);
+
+/**
+ * Stream the property tree of a set of history rows.
+ * @param[out] writer  The writer to stream the tree to.
+ * @param[in]  rows    The set of history rows.
+ */
+BCX_API void prop_tree(stream_writer& writer,
+    const std::vector<client::history_row>& rows);
+
+/**
+ * Stream the property tree of a set of history rows of an address.
+ * @param[out] writer           The writer to stream the tree to.
+ * @param[in]  rows             The set of history rows.
+ * @param[in]  history_address  The payment address for the history rows.
+ */
+BCX_API void prop_tree(stream_writer& writer,
+    const std::vector<client::history_row>& rows,
+    const payment_address& history_address);
+
+/**
+ * Stream the property tree of a set of history rows, including the
+ * transactions of their received and spent hashes.
+ * @param[out] writer        The writer to stream the tree to.
+ * @param[in]  rows          The set of history rows.
+ * @param[in]  transactions  The transactions indexed by hash.
+ */
+BCX_API void prop_tree(stream_writer& writer,
+    const std::vector<client::history_row>& rows,
+    const std::map<hash_digest, tx_type>& transactions);
+
+/**
+ * Stream the property tree of a set of history rows of an address,
+ * including the transactions of their received and spent hashes.
+ * @param[out] writer           The writer to stream the tree to.
+ * @param[in]  rows             The set of history rows.
+ * @param[in]  history_address  The payment address for the history rows.
+ * @param[in]  transactions     The transactions indexed by hash.
+ */
+BCX_API void prop_tree(stream_writer& writer,
+    const std::vector<client::history_row>& rows,
+    const payment_address& history_address,
+    const std::map<hash_digest, tx_type>& transactions);
+
 } // namespace primitives
 } // namespace explorer
 } // namespace libbitcoin
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_STREAM_WRITER_HPP
+#define BX_STREAM_WRITER_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/property_tree/ptree.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/primitives/encoding.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Writer of the output encodings that emits each element to the stream as it
+ * is produced, rather than first building a property tree. The output is
+ * byte-identical to write_stream for the equivalent property tree.
+ * An element is opened, populated with named values and child elements and
+ * then closed. An element without values is written as an empty value, as
+ * the property tree writers do. Names must not be empty, since the json
+ * writer encodes a tree of unnamed elements as an array.
+ *
+ * The ndjson encoding writes each row as a compact json object on its own
+ * line, which is flushed as the row is closed. A row is an element of a list,
+ * such as an input of a transaction, or a top level element that is not a
+ * list. A row is written within the elements that contain it, with the values
+ * that precede it in those elements, so that each row is self-contained and
+ * has the paths of the json encoding. The rows of an element are written
+ * before the element itself, which excludes them. A list with values but no
+ * rows is written as a row of its values, so that it is not lost.
+ */
+class stream_writer
+{
+public:
+
+    /**
+     * Construct the writer and write the document prologue.
+     * @param[out] output  The output stream to write to.
+     * @param[in]  engine  The stream writing engine type to use.
+     */
+    BCX_API stream_writer(std::ostream& output,
+        encoding_engine engine=encoding_engine::info);
+
+    /**
+     * Open a child element of the current element.
+     * @param[in]  name  The name of the element.
+     */
+    BCX_API virtual void open(const std::string& name);
+
+    /**
+     * Open a child element of the current element whose child elements are
+     * rows. This is the same as open other than for ndjson.
+     * @param[in]  name  The name of the element.
+     */
+    BCX_API virtual void open_list(const std::string& name);
+
+    /**
+     * Close the current element.
+     */
+    BCX_API virtual void close();
+
+    /**
+     * Write a named value to the current element, formatted as the property
+     * tree would format it.
+     * @param[in]  name   The name of the value.
+     * @param[in]  value  The value.
+     */
+    template <typename Value>
+    void put(const std::string& name, const Value& value);
+
+    /**
+     * Write a named text value to the current element.
+     * @param[in]  name  The name of the value.
+     * @param[in]  text  The text of the value.
+     */
+    BCX_API virtual void write(const std::string& name,
+        const std::string& text);
+
+    /**
+     * Write the elements of a property tree to the current element, for
+     * content that is not otherwise streamed.
+     * @param[in]  tree  The property tree.
+     */
+    BCX_API virtual void write(const pt::ptree& tree);
+
+    /**
+     * Close any open elements and write the document epilogue, after which
+     * the writer is no longer usable.
+     */
+    BCX_API virtual void finish();
+
+private:
+    struct element
+    {
+        std::string name;
+        bool opened;
+        bool empty;
+        bool list;
+        bool rows;
+        std::string values;
+    };
+
+    bool is_row(size_t depth) const;
+    void open_element(const std::string& name, bool list);
+    void open_pending();
+    void close_row();
+    void write_value(const std::string& name, const std::string& text);
+    void indent(size_t level);
+
+    std::ostream& output_;
+    encoding_engine engine_;
+    std::vector<element> elements_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#include <bitcoin/explorer/impl/stream_writer.ipp>
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_TRANSACTION_CACHE_HPP
+#define BX_TRANSACTION_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Class to persist transactions between invocations, keyed by hash. The file
+ * is memory mapped and holds the satoshi serialization of each transaction
+ * with the time of its last use. When a store would exceed the capacity the
+ * least recently used transactions are evicted and the file is compacted.
+ * The file is locked against other processes for the lifetime of the cache.
+ */
+class transaction_cache
+{
+public:
+
+    /**
+     * Open or create the cache file at the specified path.
+     * @param[in]  path      The path of the cache file.
+     * @param[in]  capacity  The maximum size of the file in bytes.
+     */
+    BCX_API transaction_cache(const boost::filesystem::path& path,
+        size_t capacity);
+
+    /**
+     * Determine whether the cache file is open and well formed.
+     * @return  True if the cache is usable.
+     */
+    BCX_API virtual bool valid() const;
+
+    /**
+     * Get the number of cached transactions.
+     * @return  The number of transactions.
+     */
+    BCX_API virtual size_t count() const;
+
+    /**
+     * Determine whether a transaction is cached, without marking its use.
+     * @param[in]  hash  The transaction hash.
+     * @return           True if cached.
+     */
+    BCX_API virtual bool contains(const hash_digest& hash) const;
+
+    /**
+     * Get a cached transaction and mark its use.
+     * @param[out] tx    The transaction.
+     * @param[in]  hash  The transaction hash.
+     * @return           True if the transaction was cached.
+     */
+    BCX_API virtual bool find(tx_type& tx, const hash_digest& hash);
+
+    /**
+     * Cache a transaction, evicting the least recently used as required.
+     * @param[in]  tx  The transaction.
+     * @return         True if cached, false if larger than the capacity.
+     */
+    BCX_API virtual bool store(const tx_type& tx);
+
+private:
+
+    struct entry
+    {
+        size_t offset;
+        uint32_t length;
+        uint64_t used;
+    };
+
+    bool load();
+    void touch(const hash_digest& hash, entry& cached);
+    void evict(size_t required);
+    void compact();
+    void commit(size_t end);
+
+    const size_t capacity_;
+    std::shared_ptr<boost::interprocess::file_lock> lock_;
+    std::unique_ptr<mmfile> file_;
+    size_t end_;
+    uint64_t clock_;
+    std::map<hash_digest, entry> entries_;
+    std::map<uint64_t, hash_digest> recency_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
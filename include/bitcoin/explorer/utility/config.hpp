@@ -22,6 +22,8 @@
 
 #include <cstdint>
 #include <string>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
 #include <bitcoin/explorer/define.hpp>
 
 /* NOTE: don't declare 'using namespace foo' in headers. */
@@ -47,6 +49,18 @@ namespace explorer {
 // */
 //BCX_API std::string config_default();
 
+/**
+ * Parse the configuration settings file. The parsed settings are retained
+ * for the life of the process and reused for subsequent reads of the same
+ * path, until the modification time or size of the file changes.
+ * @param[in]  path         The path of the configuration settings file.
+ * @param[in]  definitions  The configuration setting definitions.
+ * @return                  The parsed settings, bound to the definitions.
+ */
+BCX_API po::parsed_options parse_config_snapshot(
+    const boost::filesystem::path& path,
+    const po::options_description& definitions) throw(po::reading_file);
+
 } // namespace explorer
 } // namespace libbitcoin
 
@@ -21,6 +21,7 @@
 #define BX_ENVIRONMENT_HPP
 
 #include <string>
+#include <boost/program_options.hpp>
 #include <bitcoin/explorer/define.hpp>
 
 /* NOTE: don't declare 'using namespace foo' in headers. */
@@ -33,11 +34,25 @@ namespace explorer {
  */
 #define BX_ENVIRONMENT_VARIABLE_PREFIX "BX_"
 
+/**
+ * The environment variable that specifies the configuration settings file.
+ */
+#define BX_CONFIG_ENVIRONMENT_VARIABLE BX_ENVIRONMENT_VARIABLE_PREFIX "CONFIG"
+
 /**
  * The name of the linux environment variable that defines the home directory.
  */
 #define BX_LINUX_HOME_ENVIRONMENT_VARIABLE "HOME"
 
+/**
+ * Parse the prefixed environment variables. The environment is read once per
+ * process and the snapshot is reused for subsequent parses.
+ * @param[in]  definitions  The environment variable definitions.
+ * @return                  The parsed variables, bound to the definitions.
+ */
+BCX_API po::parsed_options parse_environment_snapshot(
+    const po::options_description& definitions);
+
 ///**
 // * Get the user's home directory.
 // *
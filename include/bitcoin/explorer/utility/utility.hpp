@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <iostream>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <system_error>
 #include <tuple>
@@ -33,6 +34,8 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/range/algorithm/find_if.hpp>
 #include <boost/lexical_cast.hpp>
 #include <bitcoin/bitcoin.hpp>
@@ -68,6 +71,17 @@ template <typename Consequent, typename Alternate>
 Consequent if_else(bool antecedent, const Consequent consequent,
     const Alternate alternative);
 
+/**
+ * Bind a command line token to the specified type as program_options would,
+ * rejecting tokens that the parser would treat as options.
+ * @param      <Value>  The bound type.
+ * @param[out] value    The bound value.
+ * @param[in]  token    The command line token.
+ * @return              True if the token was bound.
+ */
+template <typename Value>
+bool bind_token(Value& value, const char* token);
+
 /**
  * Convert a text string to the specified type.
  * @param      <Value>  The converted type.
@@ -192,6 +206,15 @@ template <typename Instance>
 void write_file(std::ostream& output, const std::string& path,
     const Instance& instance, bool terminate=true);
 
+/**
+ * Add the values of a set of balance rows to a set of balance totals. This
+ * allows totals to be computed incrementally as rows become available.
+ * @param[out] totals  The totals to add to.
+ * @param[in]  rows    The set of balance rows to add.
+ */
+BCX_API void accumulate_balance(balance_totals& totals,
+    const std::vector<balance_row>& rows);
+
 /**
  * Convert a bool to a literal string. The result not considered localizable.
  * @param[in]  value      The value to convert.
@@ -215,6 +238,25 @@ BCX_API std::string join(const std::vector<std::string>& words,
  */
 BCX_API bool is_base2(const std::string& text);
 
+/**
+ * Determine whether write_stream encodes a tree in the format, which is not
+ * so for the binary and delimited formats.
+ * @param[in]  engine  The output format.
+ * @return             True if the format encodes a tree.
+ */
+BCX_API bool is_tree_encoding(encoding_engine engine);
+
+/**
+ * Lock a file against other processes, blocking while another process holds
+ * it. The lock is taken on a sibling file with a ".lock" extension, because a
+ * POSIX record lock on the file itself is dropped when any descriptor onto
+ * that file is closed, such as by a memory map.
+ * @param[in]  path  The path of the file to lock.
+ * @return           The held lock, or nullptr if it could not be taken.
+ */
+BCX_API std::shared_ptr<boost::interprocess::file_lock> lock_file(
+    const boost::filesystem::path& path);
+
 /**
  * Generate a new ec key from a seed.
  * @param[in]  seed  The seed for key randomness.
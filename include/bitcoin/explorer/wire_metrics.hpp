@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_WIRE_METRICS_HPP
+#define BX_WIRE_METRICS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Histogram of durations in microseconds with log-linear buckets, in the
+ * manner of HDR histograms. Each power of two is divided into sixteen
+ * buckets, so any recorded value is reported to within one sixteenth.
+ */
+class wire_histogram
+{
+public:
+
+    /**
+     * Default constructor.
+     */
+    BCX_API wire_histogram();
+
+    /**
+     * Record a value.
+     * @param[in]  value  The value in microseconds.
+     */
+    BCX_API virtual void record(uint64_t value);
+
+    /**
+     * Add the values of another histogram to this one.
+     * @param[in]  other  The other histogram.
+     */
+    BCX_API virtual void merge(const wire_histogram& other);
+
+    /**
+     * Get the number of recorded values.
+     * @return  The number of values.
+     */
+    BCX_API virtual size_t count() const;
+
+    /**
+     * Get the smallest recorded value.
+     * @return  The value, zero if none is recorded.
+     */
+    BCX_API virtual uint64_t minimum() const;
+
+    /**
+     * Get the largest recorded value.
+     * @return  The value, zero if none is recorded.
+     */
+    BCX_API virtual uint64_t maximum() const;
+
+    /**
+     * Get the mean of the recorded values.
+     * @return  The mean, zero if none is recorded.
+     */
+    BCX_API virtual uint64_t mean() const;
+
+    /**
+     * Get the value at the specified percentile, as the upper bound of the
+     * bucket that contains it, limited to the largest recorded value.
+     * @param[in]  percentile  The percentile, from 0 to 100.
+     * @return                 The value, zero if none is recorded.
+     */
+    BCX_API virtual uint64_t percentile(size_t percentile) const;
+
+private:
+
+    static size_t bucket(uint64_t value);
+    static uint64_t upper_bound(size_t bucket);
+
+    std::vector<uint64_t> counts_;
+    size_t count_;
+    uint64_t minimum_;
+    uint64_t maximum_;
+    uint64_t total_;
+};
+
+/**
+ * Metrics of the calls of one command type. The first byte of a reply is
+ * taken as its receipt from the socket, since replies arrive whole, and its
+ * completion as the return of the codec, which runs the handler.
+ */
+struct BCX_API call_metrics
+{
+    size_t calls;
+    size_t replies;
+    size_t retries;
+    size_t timeouts;
+    uint64_t sent_bytes;
+    uint64_t received_bytes;
+    wire_histogram first_byte;
+    wire_histogram completion;
+};
+
+/**
+ * Map of call metrics by command.
+ */
+typedef std::map<std::string, call_metrics> wire_report;
+
+/**
+ * Message stream to record the metrics of each call written by the codec and
+ * of its reply. A call that is written again under the same id is a retry.
+ */
+class wire_metrics
+  : public client::message_stream
+{
+public:
+
+    /**
+     * Initialization constructor.
+     * @param[in]  next    The stream to which calls are sent.
+     * @param[in]  expiry  The period after which an unanswered call is
+     *                     counted as timed out, zero never times out.
+     */
+    BCX_API wire_metrics(std::shared_ptr<client::message_stream> next,
+        const client::period_ms& expiry=client::period_ms(0));
+
+    /**
+     * Record and send a call.
+     * @param[in]  data  The call message.
+     */
+    BCX_API virtual void write(const data_stack& data);
+
+    /**
+     * Record the receipt of a reply, before it is passed to the codec.
+     * @param[in]  data  The reply message.
+     */
+    BCX_API virtual void received(const data_stack& data);
+
+    /**
+     * Record the completion of a reply, after it is passed to the codec.
+     * @param[in]  data  The reply message.
+     */
+    BCX_API virtual void completed(const data_stack& data);
+
+    /**
+     * Get the metrics recorded since construction or the last reset, after
+     * counting the expired calls as timed out.
+     * @return  The metrics by command.
+     */
+    BCX_API virtual wire_report report();
+
+    /**
+     * Discard the recorded metrics, retaining the calls in flight.
+     */
+    BCX_API virtual void reset();
+
+    /**
+     * Add each command of a report to another.
+     * @param[out] to    The report to add to.
+     * @param[in]  from  The report to add.
+     */
+    BCX_API static void merge(wire_report& to, const wire_report& from);
+
+private:
+
+    typedef std::chrono::steady_clock clock;
+
+    struct call
+    {
+        std::string command;
+        clock::time_point sent;
+        clock::time_point received;
+    };
+
+    static uint64_t microseconds(const clock::duration& duration);
+
+    const std::shared_ptr<client::message_stream> next_;
+    const client::period_ms expiry_;
+    std::map<data_chunk, call> calls_;
+    wire_report report_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
@@ -23,8 +23,8 @@
 #include <cstdint>
 #include <functional>
 #include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/callback_state.hpp>
 #include <bitcoin/explorer/command.hpp>
-#include <bitcoin/explorer/utility/utility.hpp>
 
 namespace libbitcoin {
 namespace explorer {
@@ -48,21 +48,16 @@ threadpool& async_client::get_threadpool()
     return threadpool_;
 }
 
-void async_client::poll(bool& done, uint32_t period_ms,
+void async_client::poll(callback_state& state, uint32_t period_ms,
     std::function<void()> action)
 {
-    while (!done)
+    while (!state.wait(0))
     {
         if (action)
             action();
-        sleep(period_ms);
-    }
-}
 
-// Test wrapper (not testable).
-void async_client::sleep(uint32_t period_ms)
-{
-    sleep_ms(period_ms);
+        state.wait(period_ms);
+    }
 }
 
 // Not yet unit testable (nonvirtual pool).
@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/binary_writer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/binary_format.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+// Edit with care - the layouts must match the records of binary_format.hpp.
+
+static data_chunk make_record(binary::record_type type, size_t size)
+{
+    data_chunk record(binary::record_prefix_size + size);
+    auto serial = make_serializer(record.begin());
+    serial.write_byte(type);
+    serial.write_4_bytes(static_cast<uint32_t>(size));
+    return record;
+}
+
+static data_chunk make_record(binary::record_type type,
+    const data_chunk& payload)
+{
+    auto record = make_record(type, payload.size());
+    std::copy(payload.begin(), payload.end(),
+        record.begin() + binary::record_prefix_size);
+    return record;
+}
+
+// The address hash is written as it is encoded in the address.
+template <typename Iterator>
+static void write_address(serializer<Iterator>& serial,
+    const payment_address& address)
+{
+    serial.write_byte(address.version());
+    serial.write_data(address.hash());
+}
+
+data_chunk binary_record(const payment_address& address)
+{
+    auto record = make_record(binary::address,
+        sizeof(binary::address_record));
+    auto serial = make_serializer(record.begin() + binary::record_prefix_size);
+    write_address(serial, address);
+    return record;
+}
+
+data_chunk binary_record(const history_row& row)
+{
+    auto record = make_record(binary::transfer,
+        sizeof(binary::transfer_record));
+    auto serial = make_serializer(record.begin() + binary::record_prefix_size);
+    serial.write_hash(row.output.hash);
+    serial.write_4_bytes(row.output.index);
+    serial.write_4_bytes(static_cast<uint32_t>(row.output_height));
+    serial.write_hash(row.spend.hash);
+    serial.write_4_bytes(row.spend.index);
+    serial.write_4_bytes(static_cast<uint32_t>(row.spend_height));
+    serial.write_8_bytes(row.value);
+    return record;
+}
+
+data_chunk binary_record(const std::vector<balance_row>& rows,
+    const payment_address& balance_address)
+{
+    balance_totals totals = { 0, 0, 0 };
+    accumulate_balance(totals, rows);
+
+    auto record = make_record(binary::balance,
+        sizeof(binary::balance_record));
+    auto serial = make_serializer(record.begin() + binary::record_prefix_size);
+    serial.write_8_bytes(totals.confirmed);
+    serial.write_8_bytes(totals.received);
+    serial.write_8_bytes(totals.unspent);
+    write_address(serial, balance_address);
+    return record;
+}
+
+data_chunk binary_record(const balance_totals& totals, size_t addresses)
+{
+    auto record = make_record(binary::total, sizeof(binary::total_record));
+    auto serial = make_serializer(record.begin() + binary::record_prefix_size);
+    serial.write_8_bytes(addresses);
+    serial.write_8_bytes(totals.confirmed);
+    serial.write_8_bytes(totals.received);
+    serial.write_8_bytes(totals.unspent);
+    return record;
+}
+
+data_chunk binary_record(const block_header_type& header)
+{
+    return make_record(binary::header, serialize_satoshi_item(header));
+}
+
+data_chunk binary_record(const tx_type& tx)
+{
+    return make_record(binary::transaction, serialize_satoshi_item(tx));
+}
+
+// The key is not padded or truncated, a key of another size has no record.
+data_chunk binary_record(const stealth_row& row)
+{
+    static const size_t key_size = sizeof(
+        binary::stealth_record().ephemeral_public_key);
+
+    if (row.ephemkey.size() != key_size)
+        return data_chunk();
+
+    auto record = make_record(binary::stealth,
+        sizeof(binary::stealth_record));
+    auto serial = make_serializer(record.begin() + binary::record_prefix_size);
+    serial.write_data(row.ephemkey);
+    write_address(serial, row.address);
+    serial.write_hash(row.transaction_hash);
+    return record;
+}
+
+static void append_transaction(data_chunk& records, const hash_digest& hash,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    const auto it = transactions.find(hash);
+    if (it != transactions.end())
+        extend_data(records, binary_record(it->second));
+}
+
+static data_chunk make_records(const std::vector<history_row>& rows,
+    const payment_address* history_address,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    data_chunk records;
+    if (history_address != nullptr)
+        records = binary_record(*history_address);
+
+    for (const auto& row: rows)
+    {
+        extend_data(records, binary_record(row));
+        append_transaction(records, row.output.hash, transactions);
+        if (row.spend.hash != null_hash)
+            append_transaction(records, row.spend.hash, transactions);
+    }
+
+    return records;
+}
+
+data_chunk binary_records(const std::vector<history_row>& rows)
+{
+    static const std::map<hash_digest, tx_type> no_transactions;
+    return make_records(rows, nullptr, no_transactions);
+}
+
+data_chunk binary_records(const std::vector<history_row>& rows,
+    const payment_address& history_address)
+{
+    static const std::map<hash_digest, tx_type> no_transactions;
+    return make_records(rows, &history_address, no_transactions);
+}
+
+data_chunk binary_records(const std::vector<history_row>& rows,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    return make_records(rows, nullptr, transactions);
+}
+
+data_chunk binary_records(const std::vector<history_row>& rows,
+    const payment_address& history_address,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    return make_records(rows, &history_address, transactions);
+}
+
+data_chunk binary_records(const std::vector<stealth_row>& rows)
+{
+    data_chunk records;
+    for (const auto& row: rows)
+    {
+        const auto record = binary_record(row);
+        if (record.empty())
+            return data_chunk();
+
+        extend_data(records, record);
+    }
+
+    return records;
+}
+
+} // namespace explorer
+} // namespace libbitcoin
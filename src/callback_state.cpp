@@ -20,14 +20,20 @@
 
 #include <bitcoin/explorer/callback_state.hpp>
 
+#include <chrono>
 #include <iostream>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <boost/format.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <bitcoin/explorer/primitives/encoding.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
+#include <bitcoin/explorer/output_buffer.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
 using namespace pt;
@@ -37,9 +43,14 @@ namespace explorer {
     
 callback_state::callback_state(std::ostream& error, std::ostream& output,
     const encoding_engine engine)
+    : callback_state(error, output, engine, { 0, client::period_ms(0) })
+{
+}
+
+callback_state::callback_state(std::ostream& error, std::ostream& output,
+    const encoding_engine engine, const flush_policy& policy)
     : stopped_(true), refcount_(0), result_(console_result::okay), 
-    engine_(engine), error_(error), output_(output)
-    
+    engine_(engine), error_(error), buffer_(output, policy), output_(&buffer_)
 {
 }
 
@@ -79,12 +90,54 @@ void callback_state::error(const std::string& message)
     error(format(message));
 }
 
+// The output stream flushes according to the flush policy.
 void callback_state::output(const pt::ptree tree)
 {
     write_stream(output_, tree, engine_);
+    output_.flush();
 }
 
-// std::endl adds "/n" and flushes the stream.
+// Within an enclosing list the elements are written to its document.
+void callback_state::stream_output(const stream_handler& handler)
+{
+    if (writer_)
+    {
+        handler(*writer_);
+        output_.flush();
+        return;
+    }
+
+    stream_writer writer(output_, engine_);
+    handler(writer);
+    writer.finish();
+    output_.flush();
+}
+
+void callback_state::open_stream_output(const std::string& name)
+{
+    writer_.reset(new stream_writer(output_, engine_));
+    writer_->open_list(name);
+}
+
+void callback_state::close_stream_output()
+{
+    if (!writer_)
+        return;
+
+    writer_->close();
+    writer_->finish();
+    writer_.reset();
+    output_.flush();
+}
+
+void callback_state::delimited_output(const delimited_handler& handler)
+{
+    delimited_writer writer(output_, engine_);
+    handler(writer);
+    output_.flush();
+}
+
+// std::endl adds "/n" and flushes the stream, as the flush policy allows.
 void callback_state::output(const format& message)
 {
     output_ << message  << std::endl;
@@ -100,8 +153,26 @@ void callback_state::output(uint64_t value)
     output(format("%1%") % value);
 }
 
+void callback_state::output(const data_chunk& records)
+{
+    output_.write(reinterpret_cast<const char*>(records.data()),
+        records.size());
+    output_.flush();
+}
+
+void callback_state::flush()
+{
+    buffer_.write_through();
+}
+
+void callback_state::flush_due()
+{
+    buffer_.write_due();
+}
+
 void callback_state::start()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     refcount_ = 1;
     stopped_ = false;
     result_ = console_result::okay;
@@ -109,16 +180,34 @@ void callback_state::start()
 
 void callback_state::stop(console_result result)
 {
-    refcount_ = 0;
-    stopped_ = true;
-    result_ = result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        refcount_ = 0;
+        stopped_ = true;
+        result_ = result;
+    }
+
+    notify();
 }
 
-bool& callback_state::stopped()
+bool callback_state::stopped()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     return stopped_;
 }
 
+bool callback_state::wait(uint32_t period_ms)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return stopping_.wait_for(lock, std::chrono::milliseconds(period_ms),
+        [this]{ return stopped_; });
+}
+
+void callback_state::notify()
+{
+    stopping_.notify_all();
+}
+
 encoding_engine callback_state::get_engine()
 {
     return engine_;
@@ -126,16 +215,19 @@ encoding_engine callback_state::get_engine()
 
 console_result callback_state::get_result()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     return result_;
 }
 
 void callback_state::set_result(console_result result)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     result_ = result;
 }
 
 size_t callback_state::increment()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (++refcount_ != 0)
         stopped_ = false;
 
@@ -144,14 +236,25 @@ size_t callback_state::increment()
 
 size_t callback_state::decrement()
 {
-    if (--refcount_ == 0)
-        stopped_ = true;
+    size_t refcount;
 
-    return refcount_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--refcount_ == 0)
+            stopped_ = true;
+
+        refcount = refcount_;
+    }
+
+    if (refcount == 0)
+        notify();
+
+    return refcount;
 }
 
 callback_state::operator size_t() const
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     return refcount_;
 }
 
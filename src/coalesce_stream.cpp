@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/coalesce_stream.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+coalesce_stream::coalesce_stream(std::shared_ptr<message_stream> next,
+    const period_ms& expiry)
+  : next_(next), expiry_(expiry), enabled_(true), coalesced_(0)
+{
+}
+
+// An obelisk message is the command, id and payload frames. The request is
+// the command and payload, each prefixed by its size so they cannot collide.
+static bool parse(data_chunk& request, data_chunk& id, const data_stack& data)
+{
+    if (data.size() != 3)
+        return false;
+
+    auto frame = data.begin();
+    const auto& command = *frame;
+    id = *(++frame);
+    const auto& payload = *(++frame);
+
+    request.clear();
+    extend_data(request, to_little_endian(
+        static_cast<uint32_t>(command.size())));
+    extend_data(request, command);
+    extend_data(request, payload);
+    return true;
+}
+
+void coalesce_stream::write(const data_stack& data)
+{
+    const auto now = clock::now();
+    prune(now);
+
+    data_chunk request;
+    data_chunk id;
+    if (!enabled_ || !parse(request, id, data))
+    {
+        next_->write(data);
+        return;
+    }
+
+    // A waiting call that is resent is no longer waiting and is sent alone.
+    const auto waiting = waiting_.find(id);
+    if (waiting != waiting_.end())
+    {
+        auto& ids = calls_[waiting->second].waiting;
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        waiting_.erase(waiting);
+        next_->write(data);
+        return;
+    }
+
+    const auto it = calls_.find(request);
+    if (it != calls_.end() && it->second.id != id &&
+        !expired(it->second, now))
+    {
+        it->second.waiting.push_back(id);
+        it->second.joined = now;
+        waiting_[id] = request;
+        return;
+    }
+
+    // A new call, a resent call or one replacing an expired call. Calls
+    // waiting on an expired call wait on the call that replaces it.
+    if (it != calls_.end() && it->second.id != id)
+        sent_.erase(it->second.id);
+
+    auto& entry = calls_[request];
+    entry.id = id;
+    entry.sent = now;
+    entry.joined = now;
+    sent_[id] = request;
+    next_->write(data);
+}
+
+std::vector<data_stack> coalesce_stream::reply(const data_stack& data)
+{
+    std::vector<data_stack> copies;
+    prune(clock::now());
+    if (data.size() < 2)
+        return copies;
+
+    auto frame = data.begin();
+    const auto& id = *(++frame);
+    const auto sent = sent_.find(id);
+    if (sent == sent_.end())
+        return copies;
+
+    const auto it = calls_.find(sent->second);
+    for (const auto& waiting: it->second.waiting)
+    {
+        auto copy = data;
+        auto copy_frame = copy.begin();
+        *(++copy_frame) = waiting;
+        copies.push_back(copy);
+        waiting_.erase(waiting);
+    }
+
+    coalesced_ += copies.size();
+    calls_.erase(it);
+    sent_.erase(sent);
+    return copies;
+}
+
+void coalesce_stream::clear()
+{
+    calls_.clear();
+    sent_.clear();
+    waiting_.clear();
+}
+
+bool coalesce_stream::enabled() const
+{
+    return enabled_;
+}
+
+void coalesce_stream::set_enabled(bool enabled)
+{
+    enabled_ = enabled;
+}
+
+size_t coalesce_stream::coalesced() const
+{
+    return coalesced_;
+}
+
+bool coalesce_stream::expired(const call& entry,
+    const clock::time_point& now) const
+{
+    return expiry_.count() != 0 && now - entry.sent >= expiry_;
+}
+
+// The codec gives up on each call once it expires, so a call is forgotten
+// once the last call to wait on it has expired.
+void coalesce_stream::prune(const clock::time_point& now)
+{
+    if (expiry_.count() == 0)
+        return;
+
+    for (auto it = calls_.begin(); it != calls_.end();)
+    {
+        const auto& entry = it->second;
+        if (now - entry.joined < expiry_)
+        {
+            ++it;
+            continue;
+        }
+
+        for (const auto& waiting: entry.waiting)
+            waiting_.erase(waiting);
+
+        sent_.erase(entry.id);
+        it = calls_.erase(it);
+    }
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -22,8 +22,10 @@
 
 #include <iostream>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
 #include <bitcoin/explorer/primitives/wrapper.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
 
 using namespace bc::explorer;
 using namespace bc::explorer::commands;
@@ -36,6 +38,12 @@ console_result address_decode::invoke(std::ostream& output,
     const auto& bitcoin_address = get_bitcoin_address_argument();
     const auto& encoding = get_format_option();
 
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
     // TESTNET VERSION REQUIRES RECOMPILE
     const wrapper wrapped(bitcoin_address);
     write_stream(output, prop_tree(wrapped), encoding);
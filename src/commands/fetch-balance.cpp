@@ -20,14 +20,24 @@
 
 #include <bitcoin/explorer/commands/fetch-balance.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/client.hpp>
+#include <bitcoin/explorer/binary_writer.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
 #include <bitcoin/explorer/display.hpp>
+#include <bitcoin/explorer/history_cache.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/output_buffer.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
 
 using namespace bc;
 using namespace bc::client;
@@ -35,56 +45,155 @@ using namespace bc::explorer;
 using namespace bc::explorer::commands;
 using namespace bc::explorer::primitives;
 
+// The set of addresses, the index of the next address to request and the
+// running totals. The request window is maintained by issuing the next request
+// from the handler of each completed request. Totals are accumulated as each
+// response arrives so that no response is retained. With a cache only the
+// rows at or above the refresh height are requested.
+struct balance_queue
+{
+    const std::vector<primitives::address>& addresses;
+    size_t next;
+    size_t completed;
+    balance_totals totals;
+    history_cache* cache;
+};
+
 static void handle_error(callback_state& state, const std::error_code& error)
 {
     state.handle_error(error);
 }
 
-static void handle_callback(callback_state& state, 
+static void handle_callback(callback_state& state, balance_queue& queue,
     const payment_address& address, const std::vector<balance_row>& rows)
 {
-    state.output(prop_tree(rows, address));
+    if (state.get_engine() == encoding_engine::binary)
+        state.output(binary_record(rows, address));
+    else if (is_delimited(state.get_engine()))
+        state.delimited_output([&](delimited_writer& writer)
+        {
+            writer.balance(rows, address);
+        });
+    else
+        state.stream_output([&](stream_writer& writer)
+        {
+            writer.write(prop_tree(rows, address));
+        });
+
+    accumulate_balance(queue.totals, rows);
+    ++queue.completed;
 }
 
-static void fetch_balance_from_address(obelisk_client& client,
-    callback_state& state, const primitives::address& address)
+static void fetch_next_balance(obelisk_client& client, callback_state& state,
+    balance_queue& queue)
 {
+    if (queue.next >= queue.addresses.size())
+        return;
+
     // Do not pass the address by reference here.
-    auto on_done = [&state, address](const client::history_list& rows)
+    const payment_address address = queue.addresses[queue.next++];
+
+    auto on_done = [&client, &state, &queue, address](
+        const client::history_list& rows)
     {
-        handle_callback(state, address, rows);
+        if (queue.cache == nullptr)
+            handle_callback(state, queue, address, rows);
+        else
+            handle_callback(state, queue, address,
+                queue.cache->merge(address, rows));
+
+        fetch_next_balance(client, state, queue);
     };
 
-    auto on_error = [&state](const std::error_code& error)
+    auto on_error = [&client, &state, &queue](const std::error_code& error)
     {
         handle_error(state, error);
+        fetch_next_balance(client, state, queue);
     };
 
-    client.get_codec()->address_fetch_history(on_error, on_done, address);
+    const auto height = queue.cache == nullptr ? size_t(0) :
+        queue.cache->height(address);
+
+    client.get_codec()->address_fetch_history(on_error, on_done, address,
+        static_cast<uint32_t>(height));
 }
 
 console_result fetch_balance::invoke(std::ostream& output, std::ostream& error)
 {
     // Bound parameters.
     const auto& encoding = get_format_option();
-    const auto& address = get_bitcoin_address_argument();
+    const auto& window = get_window_option();
+    const auto& addresses = get_bitcoin_addresses_argument();
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
-    const auto& server = if_else(get_general_network_setting() == "testnet",
-        get_testnet_url_setting(), get_mainnet_url_setting());
+    const auto flush_size = get_general_flush_size_setting();
+    const auto flush_interval = get_general_flush_interval_setting();
+    const auto hedge = get_general_hedge_setting();
+    const auto cache_path = get_cache_history_setting();
+    const auto servers = connection_manager::servers(*this);
 
-    czmqpp::context context;
-    obelisk_client client(context, period_ms(timeout), retries);
+    std::unique_ptr<history_cache> cache;
+    if (!cache_path.empty())
+    {
+        cache.reset(new history_cache(cache_path));
+        if (!cache->valid())
+        {
+            error << format(BX_HISTORY_CACHE_FAILURE) % cache_path.string()
+                << std::endl;
+            return console_result::failure;
+        }
+    }
 
-    if (client.connect(server) < 0)
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
+
+    if (!connection)
     {
-        display_connection_failure(error, server);
+        display_connection_failure(error, join(servers));
         return console_result::failure;
     }
 
-    callback_state state(error, output, encoding);
-    fetch_balance_from_address(client, state, address);
+    auto& client = *connection;
+
+    const flush_policy policy = { flush_size, period_ms(flush_interval) };
+    callback_state state(error, output, encoding, policy);
+    const auto delimited = is_delimited(state.get_engine());
+    if (delimited)
+        state.delimited_output([](delimited_writer& writer)
+        {
+            writer.balance_columns();
+        });
+
+    // The balances and total of a set of addresses are written as one
+    // document. A single address retains the unaggregated balance format.
+    const auto binary = state.get_engine() == encoding_engine::binary;
+    const auto enclose = addresses.size() > 1 && !binary && !delimited;
+
+    if (enclose)
+        state.open_stream_output("balances");
+
+    balance_queue queue = { addresses, 0, 0, { 0, 0, 0 }, cache.get() };
+
+    // Fill the request window, a zero window is treated as one.
+    for (size_t request = 0; request < std::max(window, size_t(1)); ++request)
+        fetch_next_balance(client, state, queue);
+
     client.resolve_callbacks();
 
+    // A delimited table has no row for the totals of its addresses.
+    if (addresses.size() > 1 && binary)
+        state.output(binary_record(queue.totals, queue.completed));
+
+    if (enclose)
+    {
+        state.stream_output([&](stream_writer& writer)
+        {
+            writer.write(prop_tree(queue.totals, queue.completed));
+        });
+
+        state.close_stream_output();
+    }
+
     return state.get_result();
 }
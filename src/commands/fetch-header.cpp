@@ -22,9 +22,12 @@
 
 #include <iostream>
 #include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/binary_writer.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
 #include <bitcoin/explorer/display.hpp>
+#include <bitcoin/explorer/header_store.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
 #include <bitcoin/explorer/primitives/encoding.hpp>
 #include <bitcoin/explorer/primitives/header.hpp>
@@ -45,7 +48,10 @@ static void handle_error(callback_state& state, const std::error_code& error)
 static void handle_callback(callback_state& state, 
     const block_header_type& block_header)
 {
-    state.output(prop_tree(block_header));
+    if (state.get_engine() == encoding_engine::binary)
+        state.output(binary_record(block_header));
+    else
+        state.output(prop_tree(block_header));
 }
 
 console_result fetch_header::invoke(std::ostream& output, std::ostream& error)
@@ -56,18 +62,51 @@ console_result fetch_header::invoke(std::ostream& output, std::ostream& error)
     const encoding& encoding = get_format_option();
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
-    const auto& server = if_else(get_general_network_setting() == "testnet",
-        get_testnet_url_setting(), get_mainnet_url_setting());
+    const auto hedge = get_general_hedge_setting();
+    const auto store_path = get_cache_header_setting();
+    const auto servers = connection_manager::servers(*this);
 
-    czmqpp::context context;
-    obelisk_client client(context, period_ms(timeout), retries);
+    if (!is_tree_encoding(encoding) && encoding != encoding_engine::binary)
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
 
-    if (client.connect(server) < 0)
+    // Serve from the header file when the header is stored.
+    if (!store_path.empty())
     {
-        display_connection_failure(error, server);
+        header_store store(store_path);
+        if (!store.valid())
+        {
+            error << format(BX_HEADER_CACHE_FAILURE) % store_path.string()
+                << std::endl;
+            return console_result::failure;
+        }
+
+        block_header_type header;
+        const auto stored = hash == null_hash ? store.read(header, height) :
+            store.find(header, hash);
+
+        if (stored)
+        {
+            callback_state state(error, output, encoding);
+            handle_callback(state, header);
+            return state.get_result();
+        }
+    }
+
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
+
+    if (!connection)
+    {
+        display_connection_failure(error, join(servers));
         return console_result::failure;
     }
 
+    auto& client = *connection;
+
     callback_state state(error, output, encoding);
 
     auto on_done = [&state](const block_header_type& header)
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
 #include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
@@ -48,23 +49,26 @@ console_result fetch_height::invoke(std::ostream& output, std::ostream& error)
     // Bound parameters.
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
+    const auto hedge = get_general_hedge_setting();
     const auto& argument_server = get_server_url_argument();
-    const auto& config_server = if_else(
-        get_general_network_setting() == "testnet",
-        get_testnet_url_setting(), get_mainnet_url_setting());
 
-    const auto& server = if_else(argument_server.empty(), config_server,
-        argument_server);
+    // A server specified as an argument is used alone.
+    auto servers = connection_manager::servers(*this);
+    if (!argument_server.empty())
+        servers = { argument_server };
 
-    czmqpp::context context;
-    obelisk_client client(context, period_ms(timeout), retries);
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
 
-    if (client.connect(server) < 0)
+    if (!connection)
     {
-        display_connection_failure(error, server);
+        display_connection_failure(error, join(servers));
         return console_result::failure;
     }
 
+    auto& client = *connection;
+
     callback_state state(error, output);
 
     auto on_done = [&state](size_t height)
@@ -20,13 +20,27 @@
 
 #include <bitcoin/explorer/commands/fetch-history.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
 #include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/binary_writer.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
 #include <bitcoin/explorer/display.hpp>
+#include <bitcoin/explorer/history_cache.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/output_buffer.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
+#include <bitcoin/explorer/transaction_cache.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
 
 using namespace bc;
 using namespace bc::client;
@@ -40,26 +54,225 @@ static void handle_error(callback_state& state, const std::error_code& error)
 }
 
 static void handle_callback(callback_state& state,
-    const payment_address& address, const std::vector<history_row>& rows)
+    const payment_address& address, const std::vector<history_row>& rows,
+    bool annotate)
 {
-    state.output(prop_tree(rows));
+    if (state.get_engine() == encoding_engine::binary)
+    {
+        state.output(annotate ? binary_records(rows, address) :
+            binary_records(rows));
+        return;
+    }
+
+    // Each row of the table carries its address.
+    if (is_delimited(state.get_engine()))
+    {
+        state.delimited_output([&](delimited_writer& writer)
+        {
+            writer.history(rows, address);
+        });
+
+        return;
+    }
+
+    // A single address retains the unannotated history format.
+    // The rows are streamed, as a history may be very large.
+    state.stream_output([&](stream_writer& writer)
+    {
+        if (annotate)
+            prop_tree(writer, rows, address);
+        else
+            prop_tree(writer, rows);
+    });
+}
+
+// A history awaiting the transactions of its rows.
+struct pending_history
+{
+    payment_address address;
+    client::history_list rows;
+    bool annotate;
+};
+
+// The set of addresses and the index of the next address to request. The
+// request window is maintained by issuing the next request from the handler
+// of each completed request, so the client is never idle for a round trip.
+// With a cache only the rows at or above the refresh height are requested.
+// When expanding, the unique hashes of the rows are queued as histories
+// arrive and their transactions are requested over a window of their own.
+// Each history is written once all of its transactions are resolved.
+struct address_queue
+{
+    const std::vector<primitives::address>& addresses;
+    size_t next;
+    history_cache* cache;
+    bool expand;
+    size_t window;
+    transaction_cache* transactions_cache;
+    std::vector<hash_digest> hashes;
+    std::set<hash_digest> queued;
+    size_t next_hash;
+    size_t outstanding;
+    std::set<hash_digest> resolved;
+    std::map<hash_digest, tx_type> transactions;
+    std::vector<pending_history> pending;
+};
+
+static bool is_resolved(const address_queue& queue,
+    const client::history_list& rows)
+{
+    for (const auto& row: rows)
+    {
+        if (queue.resolved.find(row.output.hash) == queue.resolved.end())
+            return false;
+
+        if (row.spend.hash != null_hash &&
+            queue.resolved.find(row.spend.hash) == queue.resolved.end())
+            return false;
+    }
+
+    return true;
+}
+
+// Write the pending histories whose transactions have all been resolved.
+static void write_resolved(callback_state& state, address_queue& queue)
+{
+    auto history = queue.pending.begin();
+    while (history != queue.pending.end())
+    {
+        if (!is_resolved(queue, history->rows))
+        {
+            ++history;
+            continue;
+        }
+
+        if (state.get_engine() == encoding_engine::binary)
+            state.output(history->annotate ?
+                binary_records(history->rows, history->address,
+                    queue.transactions) :
+                binary_records(history->rows, queue.transactions));
+        else
+            state.stream_output([&](stream_writer& writer)
+            {
+                if (history->annotate)
+                    prop_tree(writer, history->rows, history->address,
+                        queue.transactions);
+                else
+                    prop_tree(writer, history->rows, queue.transactions);
+            });
+
+        history = queue.pending.erase(history);
+    }
+}
+
+static void fetch_next_transaction(obelisk_client& client,
+    callback_state& state, address_queue& queue)
+{
+    while (queue.next_hash < queue.hashes.size())
+    {
+        const auto hash = queue.hashes[queue.next_hash++];
+
+        // Cached transactions are resolved without a request.
+        tx_type cached;
+        if (queue.transactions_cache != nullptr &&
+            queue.transactions_cache->find(cached, hash))
+        {
+            queue.transactions[hash] = cached;
+            queue.resolved.insert(hash);
+            continue;
+        }
+
+        auto on_done = [&client, &state, &queue, hash](const tx_type& tx)
+        {
+            if (queue.transactions_cache != nullptr)
+                queue.transactions_cache->store(tx);
+
+            queue.transactions[hash] = tx;
+            queue.resolved.insert(hash);
+            --queue.outstanding;
+            write_resolved(state, queue);
+            fetch_next_transaction(client, state, queue);
+        };
+
+        // A history is written without the transactions that failed.
+        auto on_error = [&client, &state, &queue, hash](
+            const std::error_code& error)
+        {
+            handle_error(state, error);
+            queue.resolved.insert(hash);
+            --queue.outstanding;
+            write_resolved(state, queue);
+            fetch_next_transaction(client, state, queue);
+        };
+
+        ++queue.outstanding;
+        client.get_codec()->fetch_transaction(on_error, on_done, hash);
+        return;
+    }
+
+    write_resolved(state, queue);
+}
+
+static void expand_history(obelisk_client& client, callback_state& state,
+    address_queue& queue, const payment_address& address,
+    const client::history_list& rows, bool annotate)
+{
+    for (const auto& row: rows)
+    {
+        if (queue.queued.insert(row.output.hash).second)
+            queue.hashes.push_back(row.output.hash);
+
+        if (row.spend.hash != null_hash &&
+            queue.queued.insert(row.spend.hash).second)
+            queue.hashes.push_back(row.spend.hash);
+    }
+
+    const pending_history history = { address, rows, annotate };
+    queue.pending.push_back(history);
+
+    // Fill the transaction window, a zero window is treated as one.
+    while (queue.outstanding < std::max(queue.window, size_t(1)) &&
+        queue.next_hash < queue.hashes.size())
+        fetch_next_transaction(client, state, queue);
+
+    write_resolved(state, queue);
 }
 
-static void fetch_history_from_address(obelisk_client& client,
-    callback_state& state, const primitives::address& address)
+static void fetch_next_history(obelisk_client& client, callback_state& state,
+    address_queue& queue)
 {
+    if (queue.next >= queue.addresses.size())
+        return;
+
     // Do not pass the address by reference here.
-    auto on_done = [&state, address](const client::history_list& rows)
+    const payment_address address = queue.addresses[queue.next++];
+    const auto annotate = queue.addresses.size() > 1;
+
+    auto on_done = [&client, &state, &queue, address, annotate](
+        const client::history_list& rows)
     {
-        handle_callback(state, address, rows);
+        const auto history = queue.cache == nullptr ? rows :
+            queue.cache->merge(address, rows);
+
+        if (queue.expand)
+            expand_history(client, state, queue, address, history, annotate);
+        else
+            handle_callback(state, address, history, annotate);
+
+        fetch_next_history(client, state, queue);
     };
 
-    auto on_error = [&state](const std::error_code& error)
+    auto on_error = [&client, &state, &queue](const std::error_code& error)
     {
         handle_error(state, error);
+        fetch_next_history(client, state, queue);
     };
 
-    client.get_codec()->fetch_history(on_error, on_done, address);
+    const auto height = queue.cache == nullptr ? size_t(0) :
+        queue.cache->height(address);
+
+    client.get_codec()->fetch_history(on_error, on_done, address,
+        static_cast<uint32_t>(height));
 }
 
 // When you restore your wallet, you should use fetch_history(). 
@@ -72,26 +285,96 @@ static void fetch_history_from_address(obelisk_client& client,
 console_result fetch_history::invoke(std::ostream& output, std::ostream& error)
 {
     // Bound parameters.
+    const auto expand = get_expand_option();
     const auto& encoding = get_format_option();
-    const auto& address = get_bitcoin_address_argument();
+    const auto& window = get_window_option();
+    const auto& addresses = get_bitcoin_addresses_argument();
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
-    const auto& server = if_else(get_general_network_setting() == "testnet",
-        get_testnet_url_setting(), get_mainnet_url_setting());
+    const auto flush_size = get_general_flush_size_setting();
+    const auto flush_interval = get_general_flush_interval_setting();
+    const auto hedge = get_general_hedge_setting();
+    const auto cache_path = get_cache_history_setting();
+    const auto transactions_path = get_cache_transaction_setting();
+    const auto transactions_limit = get_cache_transaction_limit_setting();
+    const auto servers = connection_manager::servers(*this);
 
-    czmqpp::context context;
-    obelisk_client client(context, period_ms(timeout), retries);
+    // A delimited table is flat, so its transfers cannot be expanded.
+    if (expand && is_delimited(encoding))
+    {
+        error << format(BX_FETCH_HISTORY_EXPAND_DELIMITED) % encoding
+            << std::endl;
+        return console_result::failure;
+    }
+
+    std::unique_ptr<history_cache> cache;
+    if (!cache_path.empty())
+    {
+        cache.reset(new history_cache(cache_path));
+        if (!cache->valid())
+        {
+            error << format(BX_HISTORY_CACHE_FAILURE) % cache_path.string()
+                << std::endl;
+            return console_result::failure;
+        }
+    }
+
+    // Expanded transactions are read from and added to the cache.
+    std::unique_ptr<transaction_cache> transactions_cache;
+    if (expand && !transactions_path.empty())
+    {
+        transactions_cache.reset(new transaction_cache(transactions_path,
+            static_cast<size_t>(transactions_limit) * 1024 * 1024));
+
+        if (!transactions_cache->valid())
+        {
+            error << format(BX_TRANSACTION_CACHE_FAILURE) %
+                transactions_path.string() << std::endl;
+            return console_result::failure;
+        }
+    }
+
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
 
-    if (client.connect(server) < 0)
+    if (!connection)
     {
-        display_connection_failure(error, server);
+        display_connection_failure(error, join(servers));
         return console_result::failure;
     }
 
-    callback_state state(error, output, encoding);
-    fetch_history_from_address(client, state, address);
+    auto& client = *connection;
+
+    const flush_policy policy = { flush_size, period_ms(flush_interval) };
+    callback_state state(error, output, encoding, policy);
+
+    if (is_delimited(state.get_engine()))
+        state.delimited_output([](delimited_writer& writer)
+        {
+            writer.history_columns();
+        });
+
+    // The histories of a set of addresses are written as one document.
+    const auto enclose = addresses.size() > 1 &&
+        state.get_engine() != encoding_engine::binary &&
+        !is_delimited(state.get_engine());
+
+    if (enclose)
+        state.open_stream_output("histories");
+
+    address_queue queue = { addresses, 0, cache.get(), expand,
+        window, transactions_cache.get(), {}, {}, 0, 0, {}, {}, {} };
+
+    // Fill the request window, a zero window is treated as one.
+    for (size_t request = 0; request < std::max(window, size_t(1)); ++request)
+        fetch_next_history(client, state, queue);
+
     client.resolve_callbacks();
 
+    if (enclose)
+        state.close_stream_output();
+
     return state.get_result();
 }
 
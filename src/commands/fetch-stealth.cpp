@@ -23,10 +23,14 @@
 #include <iostream>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/client.hpp>
+#include <bitcoin/explorer/binary_writer.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
 #include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/output_buffer.hpp>
 #include <bitcoin/explorer/primitives/base2.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
 
@@ -57,7 +61,26 @@ static void handle_callback(callback_state& state,
     const bc::stealth_prefix& prefix,
     const client::stealth_list& row_list)
 {
-    state.output(prop_tree(row_list));
+    if (state.get_engine() == encoding_engine::binary)
+    {
+        const auto records = binary_records(row_list);
+        if (records.empty() && !row_list.empty())
+        {
+            state.error(BX_FETCH_STEALTH_INVALID_KEY);
+            state.stop(console_result::failure);
+            return;
+        }
+
+        state.output(records);
+    }
+    else if (is_delimited(state.get_engine()))
+        state.delimited_output([&row_list](delimited_writer& writer)
+        {
+            writer.stealth_columns();
+            writer.stealth(row_list);
+        });
+    else
+        state.output(prop_tree(row_list));
 }
 
 static void fetch_stealth_from_prefix(obelisk_client& client,
@@ -83,28 +106,34 @@ console_result fetch_stealth::invoke(std::ostream& output, std::ostream& error)
     // Bound parameters.
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
+    const auto flush_size = get_general_flush_size_setting();
+    const auto flush_interval = get_general_flush_interval_setting();
     const auto height = get_height_option();
     const auto& encoding = get_format_option();
     const stealth_prefix& prefix = get_prefix_argument();
-    const auto& server = if_else(get_general_network_setting() == "testnet",
-        get_testnet_url_setting(), get_mainnet_url_setting());
+    const auto hedge = get_general_hedge_setting();
+    const auto servers = connection_manager::servers(*this);
 
-    czmqpp::context context;
-    obelisk_client client(context, period_ms(timeout), retries);
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
 
-    if (client.connect(server) < 0)
+    if (!connection)
     {
-        display_connection_failure(error, server);
+        display_connection_failure(error, join(servers));
         return console_result::failure;
     }
 
+    auto& client = *connection;
+
     if (prefix.size() > stealth_address::max_prefix_bits)
     {
         error << BX_FETCH_STEALTH_PREFIX_TOO_LONG << std::endl;
         return console_result::failure;
     }
 
-    callback_state state(error, output, encoding);
+    const flush_policy policy = { flush_size, period_ms(flush_interval) };
+    callback_state state(error, output, encoding, policy);
     fetch_stealth_from_prefix(client, state, prefix, height);
     client.resolve_callbacks();
 
@@ -24,6 +24,7 @@
 #include <boost/format.hpp>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
 #include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
@@ -73,18 +74,27 @@ console_result fetch_tx_index::invoke(std::ostream& output, std::ostream& error)
     const auto& hash = get_hash_argument();
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
-    const auto& server = if_else(get_general_network_setting() == "testnet",
-        get_testnet_url_setting(), get_mainnet_url_setting());
+    const auto hedge = get_general_hedge_setting();
+    const auto servers = connection_manager::servers(*this);
 
-    czmqpp::context context;
-    obelisk_client client(context, period_ms(timeout), retries);
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
 
-    if (client.connect(server) < 0)
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
+
+    if (!connection)
     {
-        display_connection_failure(error, server);
+        display_connection_failure(error, join(servers));
         return console_result::failure;
     }
 
+    auto& client = *connection;
+
     callback_state state(error, output, encoding);
     fetch_tx_index_from_hash(client, state, hash);
     client.resolve_callbacks();
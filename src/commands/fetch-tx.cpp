@@ -20,15 +20,22 @@
 
 #include <bitcoin/explorer/commands/fetch-tx.hpp>
 
+#include <cstddef>
 #include <iostream>
+#include <memory>
 #include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/binary_writer.hpp>
 #include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
 #include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
 #include <bitcoin/explorer/primitives/btc256.hpp>
 #include <bitcoin/explorer/primitives/transaction.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
+#include <bitcoin/explorer/transaction_cache.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
 using namespace bc;
@@ -44,14 +51,37 @@ static void handle_error(callback_state& state, const std::error_code& error)
 
 static void handle_callback(callback_state& state, const tx_type& tx)
 {
-    state.output(prop_tree(tx));
+    if (state.get_engine() == encoding_engine::binary)
+    {
+        state.output(binary_record(tx));
+        return;
+    }
+
+    if (is_delimited(state.get_engine()))
+    {
+        state.delimited_output([&tx](delimited_writer& writer)
+        {
+            writer.transaction_columns();
+            writer.transaction(tx);
+        });
+
+        return;
+    }
+
+    state.stream_output([&tx](stream_writer& writer)
+    {
+        prop_tree(writer, tx);
+    });
 }
 
 static void fetch_tx_from_hash(obelisk_client& client, callback_state& state,
-    btc256 hash)
+    btc256 hash, transaction_cache* cache)
 {
-    auto on_done = [&state](const tx_type& tx)
+    auto on_done = [&state, cache](const tx_type& tx)
     {
+        if (cache != nullptr)
+            cache->store(tx);
+
         handle_callback(state, tx);
     };
 
@@ -70,20 +100,48 @@ console_result fetch_tx::invoke(std::ostream& output, std::ostream& error)
     const auto& hash = get_hash_argument();
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
-    const auto& server = if_else(get_general_network_setting() == "testnet",
-        get_testnet_url_setting(), get_mainnet_url_setting());
+    const auto hedge = get_general_hedge_setting();
+    const auto cache_path = get_cache_transaction_setting();
+    const auto cache_limit = get_cache_transaction_limit_setting();
+    const auto servers = connection_manager::servers(*this);
+
+    // A cached transaction is immutable, so the server is not consulted.
+    std::unique_ptr<transaction_cache> cache;
+    if (!cache_path.empty())
+    {
+        cache.reset(new transaction_cache(cache_path,
+            static_cast<size_t>(cache_limit) * 1024 * 1024));
 
-    czmqpp::context context;
-    obelisk_client client(context, period_ms(timeout), retries);
+        if (!cache->valid())
+        {
+            error << format(BX_TRANSACTION_CACHE_FAILURE) %
+                cache_path.string() << std::endl;
+            return console_result::failure;
+        }
 
-    if (client.connect(server) < 0)
+        tx_type tx;
+        if (cache->find(tx, hash))
+        {
+            callback_state state(error, output, encoding);
+            handle_callback(state, tx);
+            return state.get_result();
+        }
+    }
+
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
+
+    if (!connection)
     {
-        display_connection_failure(error, server);
+        display_connection_failure(error, join(servers));
         return console_result::failure;
     }
 
+    auto& client = *connection;
+
     callback_state state(error, output, encoding);
-    fetch_tx_from_hash(client, state, hash);
+    fetch_tx_from_hash(client, state, hash, cache.get());
     client.resolve_callbacks();
 
     return state.get_result();
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/commands/load-test.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
+#include <bitcoin/explorer/load_generator.hpp>
+#include <bitcoin/explorer/prop_tree.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+using namespace bc::explorer::commands;
+using namespace bc::explorer::primitives;
+
+console_result load_test::invoke(std::ostream& output, std::ostream& error)
+{
+    // Bound parameters.
+    const auto& encoding = get_format_option();
+    const auto& concurrency = get_concurrency_option();
+    const auto& rate = get_rate_option();
+    const auto& duration = get_duration_option();
+    const auto& argument_server = get_server_url_argument();
+    const auto retries = get_general_retries_setting();
+    const auto timeout = get_general_wait_setting();
+    const auto hedge = get_general_hedge_setting();
+
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
+    // A server specified as an argument is used alone.
+    auto servers = connection_manager::servers(*this);
+    if (!argument_server.empty())
+        servers = { argument_server };
+
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
+
+    if (!connection)
+    {
+        display_connection_failure(error, join(servers));
+        return console_result::failure;
+    }
+
+    load_generator generator(concurrency, rate);
+    const auto report = generator.run(*connection,
+        std::chrono::duration_cast<period_ms>(
+            std::chrono::seconds(duration)));
+
+    write_stream(output, prop_tree(report), encoding);
+
+    // The report is written in any case, but no completed call is a failure.
+    return report.completed == 0 ? console_result::failure :
+        console_result::okay;
+}
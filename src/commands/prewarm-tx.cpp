@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/commands/prewarm-tx.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
+#include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/primitives/btc256.hpp>
+#include <bitcoin/explorer/transaction_cache.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+using namespace bc::explorer::commands;
+using namespace bc::explorer::primitives;
+
+// The set of hashes, the index of the next hash to request and the number of
+// transactions fetched. The request window is maintained by issuing the next
+// request from the handler of each completed request.
+struct prewarm_queue
+{
+    const std::vector<btc256>& hashes;
+    size_t next;
+    size_t fetched;
+    transaction_cache& cache;
+};
+
+static void fetch_next_transaction(obelisk_client& client,
+    callback_state& state, prewarm_queue& queue)
+{
+    // Transactions already cached are not requested.
+    while (queue.next < queue.hashes.size() &&
+        queue.cache.contains(queue.hashes[queue.next]))
+        ++queue.next;
+
+    if (queue.next >= queue.hashes.size())
+        return;
+
+    const hash_digest hash = queue.hashes[queue.next++];
+
+    auto on_done = [&client, &state, &queue](const tx_type& tx)
+    {
+        queue.cache.store(tx);
+        ++queue.fetched;
+        fetch_next_transaction(client, state, queue);
+    };
+
+    auto on_error = [&client, &state, &queue](const std::error_code& error)
+    {
+        state.handle_error(error);
+        fetch_next_transaction(client, state, queue);
+    };
+
+    client.get_codec()->fetch_transaction(on_error, on_done, hash);
+}
+
+console_result prewarm_tx::invoke(std::ostream& output, std::ostream& error)
+{
+    // Bound parameters.
+    const auto& window = get_window_option();
+    const auto& hashes = get_hashes_argument();
+    const auto retries = get_general_retries_setting();
+    const auto timeout = get_general_wait_setting();
+    const auto hedge = get_general_hedge_setting();
+    const auto cache_path = get_cache_transaction_setting();
+    const auto cache_limit = get_cache_transaction_limit_setting();
+    const auto servers = connection_manager::servers(*this);
+
+    if (cache_path.empty())
+    {
+        error << BX_PREWARM_TX_NO_CACHE << std::endl;
+        return console_result::failure;
+    }
+
+    transaction_cache cache(cache_path,
+        static_cast<size_t>(cache_limit) * 1024 * 1024);
+
+    if (!cache.valid())
+    {
+        error << format(BX_TRANSACTION_CACHE_FAILURE) % cache_path.string()
+            << std::endl;
+        return console_result::failure;
+    }
+
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
+
+    if (!connection)
+    {
+        display_connection_failure(error, join(servers));
+        return console_result::failure;
+    }
+
+    auto& client = *connection;
+
+    callback_state state(error, output);
+    prewarm_queue queue = { hashes, 0, 0, cache };
+
+    // Fill the request window, a zero window is treated as one.
+    for (size_t request = 0; request < std::max(window, size_t(1)); ++request)
+        fetch_next_transaction(client, state, queue);
+
+    client.resolve_callbacks();
+
+    // A transaction may be evicted by a later one if the cache is too small.
+    const auto cached = std::count_if(hashes.begin(), hashes.end(),
+        [&cache](const btc256& hash)
+        {
+            return cache.contains(hash);
+        });
+
+    output << format(BX_PREWARM_TX_CACHED) % cached % hashes.size() %
+        queue.fetched << std::endl;
+
+    return state.get_result();
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/commands/probe-servers.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <boost/filesystem.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
+#include <bitcoin/explorer/latency_probe.hpp>
+#include <bitcoin/explorer/prop_tree.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+using namespace bc::explorer::commands;
+using namespace bc::explorer::primitives;
+
+// The ranking is one server URL per line, in ranked order. It is written to
+// a temporary file in the same directory and renamed over the ranking, so a
+// concurrent reader sees either the previous or the complete new ranking.
+static bool write_ranking(const boost::filesystem::path& path,
+    const std::vector<server_probe>& probes)
+{
+    using namespace boost::filesystem;
+
+    const auto temporary = path.parent_path() /
+        unique_path(path.filename().string() + ".%%%%-%%%%.tmp");
+
+    {
+        std::ofstream file(temporary.string());
+        for (const auto& probe: probes)
+            file << probe.server << std::endl;
+
+        file.close();
+        if (!file)
+        {
+            boost::system::error_code ignored;
+            remove(temporary, ignored);
+            return false;
+        }
+    }
+
+    boost::system::error_code code;
+    rename(temporary, path, code);
+    if (!code)
+        return true;
+
+    boost::system::error_code ignored;
+    remove(temporary, ignored);
+    return false;
+}
+
+console_result probe_servers::invoke(std::ostream& output,
+    std::ostream& error)
+{
+    // Bound parameters.
+    const auto& encoding = get_format_option();
+    const auto& samples = get_samples_option();
+    const auto& arguments = get_server_urls_argument();
+    const auto timeout = get_general_wait_setting();
+    const auto ranking = get_general_ranking_setting();
+
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
+    auto servers = connection_manager::servers(*this);
+    if (!arguments.empty())
+        servers = arguments;
+
+    latency_probe probe(period_ms(timeout), std::max(samples, size_t(1)));
+    const auto probes = probe.probe(servers);
+
+    if (!ranking.empty() && !write_ranking(ranking, probes))
+    {
+        error << format(BX_PROBE_SERVERS_WRITE_FAIL) % ranking.string()
+            << std::endl;
+        return console_result::failure;
+    }
+
+    write_stream(output, prop_tree(probes), encoding);
+    return console_result::okay;
+}
@@ -78,7 +78,7 @@ console_result send_tx_node::invoke(std::ostream& output, std::ostream& error)
     connect(shake, net, host, port,
         std::bind(send_handler, ph::_1, ph::_2, transaction));
 
-    client.poll(state.stopped(), 2000);
+    client.poll(state, 2000);
 
     return state.get_result();
 }
\ No newline at end of file
@@ -153,14 +153,14 @@ console_result send_tx_p2p::invoke(std::ostream& output, std::ostream& error)
     signal(SIGTERM, handle_signal);
     signal(SIGINT, handle_signal);
 
-    // Check the connection count every 2 seconds.
+    // Check the connection count every 2 seconds, returning on completion.
     const auto work = [&prot, &node_count, &check_handler]
     {
         prot.fetch_connection_count(
             std::bind(check_handler, ph::_1, ph::_2, node_count));
     };
 
-    client.poll(state.stopped(), 2000, work);
+    client.poll(state, 2000, work);
     prot.stop(stop_handler);
     
     return state.get_result();
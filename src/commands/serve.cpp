@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/commands/serve.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/dispatch.hpp>
+
+using namespace bc::explorer;
+using namespace bc::explorer::commands;
+
+static czmqpp::data_chunk to_chunk(const std::string& text)
+{
+    return czmqpp::data_chunk(text.begin(), text.end());
+}
+
+// Run one request and populate its reply, the request is the command argv.
+static void handle_request(czmqpp::message& request,
+    czmqpp::message& reply)
+{
+    std::vector<std::string> args;
+    for (const auto& part: request.parts())
+        args.push_back(std::string(part.begin(), part.end()));
+
+    std::ostringstream output;
+    std::ostringstream error;
+    const auto result = dispatch_command(args, output, error);
+
+    const auto code = boost::lexical_cast<std::string>(
+        static_cast<int>(result));
+
+    reply.append(to_chunk(code));
+    reply.append(to_chunk(output.str()));
+    reply.append(to_chunk(error.str()));
+}
+
+// Not unit testable (blocks until the process is interrupted).
+console_result serve::invoke(std::ostream& output, std::ostream& error)
+{
+    // Bound parameters.
+    const auto& endpoint = get_endpoint_argument();
+
+    czmqpp::context context;
+    czmqpp::socket socket(context, ZMQ_REP);
+
+    if (socket.bind(endpoint) < 0)
+    {
+        error << format(BX_SERVE_BIND_FAIL) % endpoint << std::endl;
+        return console_result::failure;
+    }
+
+    output << format(BX_SERVE_STARTED) % endpoint << std::endl;
+
+    // A receive or send fails only when the context is interrupted.
+    while (true)
+    {
+        czmqpp::message request;
+        if (!request.receive(socket))
+            break;
+
+        czmqpp::message reply;
+        handle_request(request, reply);
+
+        if (!reply.send(socket))
+            break;
+    }
+
+    return console_result::okay;
+}
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <map>
+#include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
@@ -35,6 +36,12 @@ console_result settings::invoke(std::ostream& output, std::ostream& error)
     // bound parameters
     const auto& encoding = get_format_option();
 
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
     // TODO: load from metadata into settings list.
     // This must be updated for any settings metadata change.
     settings_list list;
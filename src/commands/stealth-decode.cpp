@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
@@ -36,6 +37,12 @@ console_result stealth_decode::invoke(std::ostream& output,
     const auto& encoding = get_format_option();
     const auto& address = get_stealth_address_argument();
 
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
     write_stream(output, prop_tree(address), encoding);
     return console_result::okay;
 }
@@ -0,0 +1,313 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/commands/sync-headers.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/callback_state.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
+#include <bitcoin/explorer/header_store.hpp>
+#include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+using namespace bc::explorer::commands;
+
+// Headers are verified and stored in batches of one retarget period.
+static const size_t batch_size = 2016;
+
+// The next height to request, the last height to sync, the number of headers
+// stored, the number of stored headers removed as no longer in the server's
+// chain, the request window, the generation of the requests, the headers
+// received out of order and whether the network is testnet, which relaxes the
+// difficulty of slow blocks. The request window is maintained by issuing the
+// next request from the handler of each completed request. A response to a
+// request of an earlier generation, issued before a reorganization was found,
+// is discarded.
+struct sync_queue
+{
+    size_t next;
+    size_t top;
+    size_t synced;
+    size_t removed;
+    size_t window;
+    size_t generation;
+    bool failed;
+    bool testnet;
+    std::map<size_t, block_header_type> pending;
+    const boost::filesystem::path& path;
+    header_store& store;
+};
+
+static void handle_failure(callback_state& state, sync_queue& queue,
+    const format& message)
+{
+    queue.failed = true;
+    state.error(message);
+    state.stop(console_result::failure);
+}
+
+static void fill_window(obelisk_client& client, callback_state& state,
+    sync_queue& queue);
+
+// Walk back from a height until the server's header matches the stored one,
+// then remove the stored headers above it and sync from there. When a new
+// header failed to link to the stored tip and the tip is in the server's
+// chain, the new header itself is invalid.
+static void find_fork(obelisk_client& client, callback_state& state,
+    sync_queue& queue, size_t height, bool unlinked)
+{
+    const auto generation = ++queue.generation;
+
+    auto on_done = [&client, &state, &queue, height, unlinked, generation](
+        const block_header_type& header)
+    {
+        if (queue.failed || generation != queue.generation)
+            return;
+
+        block_header_type stored;
+        if (!queue.store.read(stored, height))
+        {
+            handle_failure(state, queue, format(BX_HEADER_CACHE_FAILURE) %
+                queue.path.string());
+            return;
+        }
+
+        if (hash_block_header(header) != hash_block_header(stored))
+        {
+            if (height == 0)
+                handle_failure(state, queue, format(BX_SYNC_HEADERS_INVALID) % height);
+            else
+                find_fork(client, state, queue, height - 1, unlinked);
+
+            return;
+        }
+
+        const auto count = height + 1;
+        if (unlinked && count == queue.store.count())
+        {
+            handle_failure(state, queue, format(BX_SYNC_HEADERS_INVALID) % count);
+            return;
+        }
+
+        queue.removed += queue.store.count() - count;
+        if (!queue.store.truncate(count))
+        {
+            handle_failure(state, queue, format(BX_HEADER_CACHE_FAILURE) %
+                queue.path.string());
+            return;
+        }
+
+        queue.pending.clear();
+        queue.next = count;
+        fill_window(client, state, queue);
+    };
+
+    auto on_error = [&state, &queue, generation](const std::error_code& error)
+    {
+        if (queue.failed || generation != queue.generation)
+            return;
+
+        queue.failed = true;
+        state.handle_error(error);
+    };
+
+    client.get_codec()->fetch_block_header(on_error, on_done,
+        static_cast<uint32_t>(height));
+}
+
+// Verify and store the headers that continue the stored chain, once a batch
+// is complete or the last height is reached.
+static void store_headers(obelisk_client& client, callback_state& state,
+    sync_queue& queue)
+{
+    const auto from = queue.store.count();
+    std::vector<block_header_type> headers;
+    for (auto it = queue.pending.find(from); it != queue.pending.end() &&
+        it->first == from + headers.size(); ++it)
+        headers.push_back(it->second);
+
+    const auto last = from + headers.size() == queue.top + 1;
+    if (headers.empty() || (headers.size() < batch_size && !last))
+        return;
+
+    const auto size = headers.size();
+    const auto linked = header_store::verify(headers, queue.store.top_hash());
+
+    // The server's chain may have replaced the stored tip while syncing.
+    if (linked == 0 && from > 0)
+    {
+        find_fork(client, state, queue, from - 1, true);
+        return;
+    }
+
+    headers.resize(linked);
+    const auto valid = queue.store.verify_difficulty(headers, queue.testnet);
+    headers.resize(valid);
+    queue.pending.erase(queue.pending.begin(),
+        queue.pending.lower_bound(from + valid));
+
+    if (!queue.store.append(headers))
+    {
+        handle_failure(state, queue, format(BX_HEADER_CACHE_FAILURE) %
+            queue.path.string());
+        return;
+    }
+
+    queue.synced += valid;
+    if (valid < size)
+        handle_failure(state, queue, format(BX_SYNC_HEADERS_INVALID) % (from + valid));
+}
+
+static void fetch_next_header(obelisk_client& client, callback_state& state,
+    sync_queue& queue)
+{
+    if (queue.failed || queue.next > queue.top)
+        return;
+
+    const auto height = queue.next++;
+    const auto generation = queue.generation;
+
+    auto on_done = [&client, &state, &queue, height, generation](
+        const block_header_type& header)
+    {
+        if (queue.failed || generation != queue.generation)
+            return;
+
+        queue.pending[height] = header;
+        store_headers(client, state, queue);
+        fetch_next_header(client, state, queue);
+    };
+
+    auto on_error = [&state, &queue, generation](const std::error_code& error)
+    {
+        if (queue.failed || generation != queue.generation)
+            return;
+
+        queue.failed = true;
+        state.handle_error(error);
+    };
+
+    client.get_codec()->fetch_block_header(on_error, on_done,
+        static_cast<uint32_t>(height));
+}
+
+// Fill the request window, a zero window is treated as one.
+static void fill_window(obelisk_client& client, callback_state& state,
+    sync_queue& queue)
+{
+    for (size_t request = 0; request < std::max(queue.window, size_t(1));
+        ++request)
+        fetch_next_header(client, state, queue);
+}
+
+console_result sync_headers::invoke(std::ostream& output, std::ostream& error)
+{
+    // Bound parameters.
+    const auto height = get_height_option();
+    const auto window = get_window_option();
+    const auto retries = get_general_retries_setting();
+    const auto timeout = get_general_wait_setting();
+    const auto hedge = get_general_hedge_setting();
+    const auto store_path = get_cache_header_setting();
+    const auto servers = connection_manager::servers(*this);
+
+    if (store_path.empty())
+    {
+        error << BX_SYNC_HEADERS_NO_CACHE << std::endl;
+        return console_result::failure;
+    }
+
+    header_store store(store_path);
+    if (!store.valid())
+    {
+        error << format(BX_HEADER_CACHE_FAILURE) % store_path.string()
+            << std::endl;
+        return console_result::failure;
+    }
+
+    auto& connections = connection_manager::instance();
+    const auto connection = connections.connect(servers, period_ms(timeout),
+        retries, period_ms(hedge));
+
+    if (!connection)
+    {
+        display_connection_failure(error, join(servers));
+        return console_result::failure;
+    }
+
+    auto& client = *connection;
+
+    callback_state state(error, output);
+
+    auto on_error = [&state](const std::error_code& error)
+    {
+        state.handle_error(error);
+    };
+
+    // The server's last height is used unless a height is specified.
+    auto top = height;
+    auto on_height = [&top](size_t last_height)
+    {
+        top = last_height;
+    };
+
+    if (top == 0)
+    {
+        client.get_codec()->fetch_last_height(on_error, on_height);
+        client.resolve_callbacks();
+        if (state.get_result() != console_result::okay)
+            return state.get_result();
+    }
+
+    const auto testnet = get_general_network_setting() == "testnet";
+    sync_queue queue = { store.count(), top, 0, 0, window, 0, false, testnet,
+        {}, store_path, store };
+
+    // The stored tip is first compared to the server's chain, so that the
+    // headers of a reorganized chain are removed before syncing.
+    if (queue.next > 0 && top + 1 >= queue.next)
+        find_fork(client, state, queue, queue.next - 1, false);
+    else
+        fill_window(client, state, queue);
+
+    client.resolve_callbacks();
+
+    if (!queue.failed && queue.removed > 0)
+        output << format(BX_SYNC_HEADERS_REMOVED) % queue.removed
+            << std::endl;
+
+    if (!queue.failed)
+        output << format(BX_SYNC_HEADERS_SYNCED) % queue.synced %
+            store.count() << std::endl;
+
+    return state.get_result();
+}
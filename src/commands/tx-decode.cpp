@@ -23,6 +23,8 @@
 #include <iostream>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/delimited_writer.hpp>
+#include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
@@ -37,7 +39,20 @@ console_result tx_decode::invoke(std::ostream& output, std::ostream& error)
     const auto& encoding = get_format_option();
     const auto& transaction = get_transaction_argument();
 
-    write_stream(output, prop_tree(transaction), encoding);
+    if (encoding == encoding_engine::binary)
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
+    if (is_delimited(encoding))
+    {
+        delimited_writer writer(output, encoding);
+        writer.transaction_columns();
+        writer.transaction(transaction);
+    }
+    else
+        write_stream(output, prop_tree(transaction), encoding);
 
     return console_result::okay;
 }
\ No newline at end of file
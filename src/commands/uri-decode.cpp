@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
@@ -33,6 +34,12 @@
      const auto& encoding = get_format_option();
      const auto& uri = get_uri_argument();
 
+     if (!is_tree_encoding(encoding))
+     {
+         display_unsupported_format(error, encoding);
+         return console_result::failure;
+     }
+
      // The uri primitive type is not currently restricted to bitcoin uris.
      if (!starts_with(uri, "bitcoin:"))
      {
@@ -20,6 +20,7 @@
 
 #include <bitcoin/explorer/commands/watch-address.hpp>
 
+#include <csignal>
 #include <iostream>
 #include <czmq++/czmqpp.hpp>
 #include <bitcoin/bitcoin.hpp>
@@ -27,6 +28,7 @@
 #include <bitcoin/explorer/define.hpp>
 #include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/output_buffer.hpp>
 #include <bitcoin/explorer/primitives/address.hpp>
 #include <bitcoin/explorer/primitives/encoding.hpp>
 #include <bitcoin/explorer/primitives/base16.hpp>
@@ -40,13 +42,20 @@ using namespace bc::explorer;
 using namespace bc::explorer::commands;
 using namespace bc::explorer::primitives;
 
+// Set by the signal handler and polled by the command, as nothing else can
+// be safely done from a signal handler.
+static volatile sig_atomic_t stopping = 0;
+
+// The longest period between checks for a stop.
+static const period_ms stop_period(1000);
+
 static void handle_signal(int signal)
 {
     // Can't pass args using lambda capture for a simple function pointer.
-    // This means there's no way to terminate without using a global variable
-    // or process termination. Since the variable would screw with testing all 
-    // other methods we opt for process termination here.
-    exit(console_result::failure);
+    // This means there's no way to stop the command without using a global
+    // variable, so the variable is limited to a flag that only this command
+    // reads.
+    stopping = 1;
 }
 
 static void handle_error(callback_state& state, const std::error_code& error)
@@ -88,12 +97,21 @@ console_result watch_address::invoke(std::ostream& output, std::ostream& error)
     // Bound parameters.
     const auto retries = get_general_retries_setting();
     const auto timeout = get_general_wait_setting();
+    const auto flush_size = get_general_flush_size_setting();
+    const auto flush_interval = get_general_flush_interval_setting();
     const auto& encoding = get_format_option();
     const auto& bitcoin_address = get_bitcoin_address_argument();
     const auto& server = if_else(get_general_network_setting() == "testnet",
         get_testnet_url_setting(), get_mainnet_url_setting());
 
-    callback_state state(error, output, encoding);
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
+    const flush_policy policy = { flush_size, period_ms(flush_interval) };
+    callback_state state(error, output, encoding, policy);
 
     // Do not pass the prefixes by reference here.
     auto on_update = [&state](const address& bitcoin_address, size_t height, 
@@ -118,13 +136,27 @@ console_result watch_address::invoke(std::ostream& output, std::ostream& error)
     subscribe_from_address(client, state, bitcoin_address, subscribed);
 
     // Catch C signals for stopping the program.
+    stopping = 0;
     signal(SIGABRT, handle_signal);
     signal(SIGTERM, handle_signal);
     signal(SIGINT, handle_signal);
 
+    // Wake at the flush interval so that buffered output is not held while
+    // the address is quiet, and to observe a stop.
+    const auto period = flush_interval == 0 ? stop_period :
+        period_ms(flush_interval);
+
+    auto on_wake = [&state]()
+    {
+        state.flush_due();
+        return stopping == 0;
+    };
+
     // poll for subscribe callbacks if any subscriptions were established.
     if (client.resolve_callbacks() && subscribed)
-        client.poll_until_termination();
+        client.poll_until_termination(period, on_wake);
 
-    return state.get_result();
+    // A stop is a failure, as it was when the process terminated on a signal.
+    state.flush();
+    return stopping == 0 ? state.get_result() : console_result::failure;
 }
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/prop_tree.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
@@ -34,6 +35,12 @@ console_result wrap_decode::invoke(std::ostream& output, std::ostream& error)
     const auto& wrapped = get_wrapped_argument();
     const auto& encoding = get_format_option();
 
+    if (!is_tree_encoding(encoding))
+    {
+        display_unsupported_format(error, encoding);
+        return console_result::failure;
+    }
+
     const auto tree = prop_tree(wrapped);
 
     write_stream(output, tree, encoding);
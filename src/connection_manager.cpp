@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/explorer/connection_manager.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/command.hpp>
+#include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+connection_manager& connection_manager::instance()
+{
+    static connection_manager manager;
+    return manager;
+}
+
+static bool contains(const std::vector<std::string>& servers,
+    const std::string& server)
+{
+    return std::find(servers.begin(), servers.end(), server) != servers.end();
+}
+
+// Servers in the ranking file (one per line, as written by probe-servers)
+// are preferred in ranked order, followed by any unranked servers in
+// configured order. Ranked servers that are not configured are ignored.
+static std::vector<std::string> apply_ranking(
+    const std::vector<std::string>& servers,
+    const boost::filesystem::path& path)
+{
+    if (path.empty())
+        return servers;
+
+    std::ifstream file(path.string());
+    if (!file.good())
+        return servers;
+
+    std::string line;
+    std::vector<std::string> ranked;
+    while (std::getline(file, line))
+    {
+        trim(line);
+        if (contains(servers, line) && !contains(ranked, line))
+            ranked.push_back(line);
+    }
+
+    for (const auto& server: servers)
+        if (!contains(ranked, server))
+            ranked.push_back(server);
+
+    return ranked;
+}
+
+std::vector<std::string> connection_manager::servers(command& command)
+{
+    const auto testnet = command.get_general_network_setting() == "testnet";
+    const auto primary = testnet ? command.get_testnet_url_setting() :
+        command.get_mainnet_url_setting();
+    const auto hedges = testnet ? command.get_testnet_servers_setting() :
+        command.get_mainnet_servers_setting();
+
+    std::vector<std::string> addresses{ primary };
+    for (const auto& hedge: hedges)
+        addresses.push_back(hedge);
+
+    return apply_ranking(addresses, command.get_general_ranking_setting());
+}
+
+std::shared_ptr<obelisk_client> connection_manager::connect(
+    const std::string& server, const period_ms& timeout, uint8_t retries)
+{
+    const std::vector<std::string> servers{ server };
+    return connect(servers, timeout, retries, period_ms(0));
+}
+
+std::shared_ptr<obelisk_client> connection_manager::connect(
+    const std::vector<std::string>& servers, const period_ms& timeout,
+    uint8_t retries, const period_ms& hedge)
+{
+    if (servers.empty())
+        return nullptr;
+
+    const auto id = std::make_tuple(servers, timeout.count(), retries,
+        hedge.count());
+
+    const auto it = clients_.find(id);
+    if (it != clients_.end())
+        return it->second;
+
+    const auto client = std::make_shared<obelisk_client>(context_, timeout,
+        retries, hedge);
+
+    for (const auto& server: servers)
+        if (client->connect(server) < 0)
+            return nullptr;
+
+    clients_[id] = client;
+    return client;
+}
+
+void connection_manager::disconnect()
+{
+    clients_.clear();
+}
+
+wire_report connection_manager::metrics()
+{
+    wire_report report;
+    for (const auto& client: clients_)
+        wire_metrics::merge(report, client.second->get_metrics()->report());
+
+    return report;
+}
+
+void connection_manager::reset_metrics()
+{
+    for (const auto& client: clients_)
+        client.second->get_metrics()->reset();
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -0,0 +1,297 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/delimited_writer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/primitives/script.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc::client;
+using namespace bc::explorer::primitives;
+
+namespace libbitcoin {
+namespace explorer {
+
+// Edit with care - the fields of each row must be written in the order of
+// the column names of its table, and formatted as its property tree.
+
+static const char* input_type = "input";
+static const char* output_type = "output";
+
+// The characters that require a field to be quoted or escaped.
+static const char* csv_special = "\",\r\n";
+static const char* tsv_special = "\\\t\r\n";
+
+bool is_delimited(encoding_engine engine)
+{
+    return engine == encoding_engine::csv || engine == encoding_engine::tsv;
+}
+
+delimited_writer::delimited_writer(std::ostream& output,
+    encoding_engine engine)
+  : output_(output), delimiter_(engine == encoding_engine::tsv ? '\t' : ','),
+    special_(engine == encoding_engine::tsv ? tsv_special : csv_special),
+    first_(true)
+{
+}
+
+void delimited_writer::history_columns()
+{
+    columns({ "address", "received_hash", "received_index",
+        "received_height", "spent_hash", "spent_index", "spent_height",
+        "value" });
+}
+
+void delimited_writer::history(const std::vector<history_row>& rows,
+    const payment_address& history_address)
+{
+    const auto owner = history_address.encoded();
+
+    for (const auto& row: rows)
+    {
+        field(owner);
+        field(row.output.hash);
+        field(row.output.index);
+
+        // empty received_height implies pending
+        if (row.output_height == 0)
+            field("");
+        else
+            field(row.output_height);
+
+        // empty spent fields imply unspent
+        if (row.spend.hash == null_hash)
+        {
+            field("");
+            field("");
+            field("");
+        }
+        else
+        {
+            field(row.spend.hash);
+            field(row.spend.index);
+
+            // empty spent_height implies spend unconfirmed
+            if (row.spend_height == 0)
+                field("");
+            else
+                field(row.spend_height);
+        }
+
+        field(row.value);
+        end_row();
+    }
+}
+
+void delimited_writer::balance_columns()
+{
+    columns({ "address", "confirmed", "received", "unspent" });
+}
+
+void delimited_writer::balance(const std::vector<balance_row>& rows,
+    const payment_address& balance_address)
+{
+    balance_totals totals = { 0, 0, 0 };
+    accumulate_balance(totals, rows);
+
+    field(balance_address.encoded());
+    field(totals.confirmed);
+    field(totals.received);
+    field(totals.unspent);
+    end_row();
+}
+
+void delimited_writer::stealth_columns()
+{
+    columns({ "ephemeral_public_key", "paid_address", "transaction_hash" });
+}
+
+void delimited_writer::stealth(const std::vector<stealth_row>& rows)
+{
+    for (const auto& row: rows)
+    {
+        field(row.ephemkey);
+        field(row.address.encoded());
+        field(row.transaction_hash);
+        end_row();
+    }
+}
+
+void delimited_writer::transaction_columns()
+{
+    columns({ "transaction_hash", "type", "index", "address",
+        "previous_output_hash", "previous_output_index", "sequence", "value",
+        "script" });
+}
+
+// The fields that do not apply to an input or to an output are empty.
+void delimited_writer::transaction(const tx_type& tx)
+{
+    const auto hash = hash_transaction(tx);
+
+    for (size_t index = 0; index < tx.inputs.size(); ++index)
+    {
+        const auto& input = tx.inputs[index];
+        payment_address script_address;
+        const auto extracted = extract(script_address, input.script);
+
+        field(hash);
+        field(input_type);
+        field(index);
+        field(extracted ? script_address.encoded() : "");
+        field(input.previous_output.hash);
+        field(input.previous_output.index);
+        field(input.sequence);
+        field("");
+        field(script(input.script).mnemonic());
+        end_row();
+    }
+
+    for (size_t index = 0; index < tx.outputs.size(); ++index)
+    {
+        const auto& output = tx.outputs[index];
+        payment_address output_address;
+        const auto extracted = extract(output_address, output.script);
+
+        field(hash);
+        field(output_type);
+        field(index);
+        field(extracted ? output_address.encoded() : "");
+        field("");
+        field("");
+        field("");
+        field(output.value);
+        field(script(output.script).mnemonic());
+        end_row();
+    }
+}
+
+void delimited_writer::columns(const std::vector<std::string>& names)
+{
+    for (const auto& name: names)
+        field(name);
+
+    end_row();
+}
+
+void delimited_writer::separate()
+{
+    if (!first_)
+        output_ << delimiter_;
+
+    first_ = false;
+}
+
+// A csv field that would otherwise be split or run into the next row is
+// quoted, with its quotes doubled. A tsv field cannot be quoted, so its
+// backslashes, tabs and line breaks are escaped instead.
+void delimited_writer::field(const std::string& text)
+{
+    separate();
+    if (text.find_first_of(special_) == std::string::npos)
+    {
+        output_ << text;
+        return;
+    }
+
+    if (delimiter_ == '\t')
+    {
+        for (const auto character: text)
+        {
+            switch (character)
+            {
+                case '\\':
+                    output_ << "\\\\";
+                    break;
+                case '\t':
+                    output_ << "\\t";
+                    break;
+                case '\n':
+                    output_ << "\\n";
+                    break;
+                case '\r':
+                    output_ << "\\r";
+                    break;
+                default:
+                    output_ << character;
+            }
+        }
+
+        return;
+    }
+
+    output_ << '"';
+    for (const auto character: text)
+    {
+        if (character == '"')
+            output_ << '"';
+
+        output_ << character;
+    }
+
+    output_ << '"';
+}
+
+void delimited_writer::field(uint64_t value)
+{
+    separate();
+    output_ << value;
+}
+
+void delimited_writer::field(const hash_digest& hash)
+{
+    base16_field(hash.data(), hash.size());
+}
+
+void delimited_writer::field(const data_chunk& data)
+{
+    base16_field(data.data(), data.size());
+}
+
+// Base16 is written as the base16 primitive writes it, without an
+// intermediate string.
+void delimited_writer::base16_field(const uint8_t* data, size_t size)
+{
+    static const char* digits = "0123456789abcdef";
+
+    separate();
+    for (size_t index = 0; index < size; ++index)
+    {
+        output_.put(digits[data[index] >> 4]);
+        output_.put(digits[data[index] & 0x0f]);
+    }
+}
+
+void delimited_writer::end_row()
+{
+    output_ << "\n";
+    first_ = true;
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -20,21 +20,27 @@
 
 #include <bitcoin/explorer/dispatch.hpp>
 
-#include <fstream>
+#include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <boost/program_options.hpp>
 #include <boost/throw_exception.hpp>
 #include <bitcoin/explorer/command.hpp>
+#include <bitcoin/explorer/connection_manager.hpp>
 #include <bitcoin/explorer/define.hpp>
 #include <bitcoin/explorer/display.hpp>
 #include <bitcoin/explorer/generated.hpp>
+#include <bitcoin/explorer/primitives/encoding.hpp>
+#include <bitcoin/explorer/prop_tree.hpp>
 #include <bitcoin/explorer/utility/config.hpp>
 #include <bitcoin/explorer/utility/environment.hpp>
 #include <bitcoin/explorer/utility/utility.hpp>
 
 using namespace po;
 using namespace boost::filesystem;
+using namespace bc::explorer::primitives;
 
 #ifdef BOOST_NO_EXCEPTIONS
 
@@ -62,6 +68,9 @@ extern BCX_API void boost::throw_exception(const std::exception& e)
 namespace libbitcoin {
 namespace explorer {
 
+// Header of each batch result frame: result, output size, error size.
+#define BX_BATCH_FRAME "%1% %2% %3%"
+
 // Not unit testable (reliance on untestable function).
 console_result dispatch(int argc, const char* argv[], 
     std::istream& input, std::ostream& output, std::ostream& error)
@@ -72,9 +81,110 @@ console_result dispatch(int argc, const char* argv[],
         return console_result::okay;
     }
 
+    if (argc == 2 && std::string(argv[1]) == BX_BATCH_OPTION)
+        return dispatch_batch(input, output, error);
+
     return dispatch_invoke(argc - 1, &argv[1], input, output, error);
 }
 
+// Write the wire metrics of the process, in the format of the command if
+// it has a format option.
+static void write_stats(std::ostream& stream, variables_map& variables)
+{
+    const auto& format = variables["format"];
+    const auto engine = format.empty() ? encoding_engine::info :
+        static_cast<encoding_engine>(format.as<encoding>());
+
+    const auto report = connection_manager::instance().metrics();
+    write_stream(stream, prop_tree(report), engine);
+}
+
+// A nested server or batch, or a watch, runs until the process is signalled.
+static bool is_request(const std::string& symbol)
+{
+    return symbol != BX_BATCH_OPTION &&
+        symbol != commands::serve::symbol() &&
+        symbol != commands::watch_address::symbol();
+}
+
+console_result dispatch_command(const std::vector<std::string>& args,
+    std::ostream& output, std::ostream& error)
+{
+    if (args.empty())
+    {
+        display_invalid_command(error, "");
+        return console_result::failure;
+    }
+
+    // A machine-readable dump of the metrics of the calls of the process.
+    if (args.size() == 1 && args.front() == BX_STATS_OPTION)
+    {
+        const auto report = connection_manager::instance().metrics();
+        write_stream(output, prop_tree(report), encoding_engine::json);
+        return console_result::okay;
+    }
+
+    // A command that runs until signalled would stop the caller answering.
+    const auto& target = args.front();
+    if (!is_request(target))
+    {
+        display_invalid_request(error, target);
+        return console_result::failure;
+    }
+
+    std::vector<const char*> argv;
+    for (const auto& arg: args)
+        argv.push_back(arg.c_str());
+
+    // The caller's input is reserved for requests.
+    std::istringstream input;
+
+    // Isolate each command so that one failure does not terminate the caller.
+    try
+    {
+        return dispatch_invoke(static_cast<int>(argv.size()), argv.data(),
+            input, output, error);
+    }
+    catch (const std::exception& e)
+    {
+        display_unexpected_exception(error, e.what());
+        return console_result::failure;
+    }
+}
+
+console_result dispatch_batch(std::istream& input, std::ostream& output,
+    std::ostream& error)
+{
+    std::string line;
+    while (std::getline(input, line))
+    {
+        trim(line);
+        if (line.empty())
+            continue;
+
+        std::ostringstream command_output;
+        std::ostringstream command_error;
+        const auto result = dispatch_command(split_unix(line),
+            command_output, command_error);
+
+        const auto out = command_output.str();
+        const auto err = command_error.str();
+        output << format(BX_BATCH_FRAME) % static_cast<int>(result) %
+            out.size() % err.size() << std::endl;
+        output << out << err;
+        output.flush();
+    }
+
+    // The end of input ends the batch, a failed read is an error.
+    if (input.bad())
+    {
+        error << BX_BATCH_READ_FAILURE << std::endl;
+        return console_result::failure;
+    }
+
+    return console_result::okay;
+}
+
 // Not unit testable (reliance on untestable functions).
 console_result dispatch_invoke(int argc, const char* argv[],
     std::istream& input, std::ostream& output, std::ostream& error)
@@ -89,6 +199,10 @@ console_result dispatch_invoke(int argc, const char* argv[],
         return console_result::failure;
     }
 
+    // Simple arguments bypass the parser when there is nothing else to load.
+    if (bind_variables(*command, argc, argv))
+        return command->invoke(output, error);
+
     std::string message;
     variables_map variables;
 
@@ -104,7 +218,32 @@ console_result dispatch_invoke(int argc, const char* argv[],
         return console_result::okay;
     }
 
-    return command->invoke(output, error);
+    // The metrics written are those of the calls made by this command.
+    const auto stats = get_stats_option(variables);
+    if (stats)
+        connection_manager::instance().reset_metrics();
+
+    const auto result = command->invoke(output, error);
+
+    if (stats)
+        write_stats(error, variables);
+
+    return result;
+}
+
+// Not unit testable (reliance on shared test process environment).
+bool bind_variables(command& instance, int argc, const char* argv[])
+{
+    // The environment may specify a configuration file.
+    if (std::getenv(BX_CONFIG_ENVIRONMENT_VARIABLE) != nullptr)
+        return false;
+
+    // Fails on help, config or any other option, as well as missing arguments.
+    if (!instance.bind_arguments(argc, argv))
+        return false;
+
+    instance.load_setting_defaults();
+    return true;
 }
 
 path get_config_option(variables_map& variables)
@@ -131,6 +270,18 @@ bool get_help_option(variables_map& variables)
     return help.as<bool>();
 }
 
+bool get_stats_option(variables_map& variables)
+{
+    // Read stats from the map so we don't require an early notify call.
+    const auto& stats = variables[BX_STATS_VARIABLE];
+
+    // prevent exception in the case where the stats variable is not set.
+    if (stats.empty())
+        return false;
+
+    return stats.as<bool>();
+}
+
 void load_command_variables(variables_map& variables, command& instance,
     std::istream& input, int argc, const char* argv[]) throw()
 {
@@ -172,14 +323,9 @@ void load_configuration_variables(variables_map& variables, command& instance)
     }
     else
     {
-        const auto& path = config_path.generic_string();
-        std::ifstream file(path);
-
-        if (!file.good())
-            BOOST_THROW_EXCEPTION(reading_file(path.c_str()));
-
-        // parse inputs
-        const auto configuration = parse_config_file(file, config_settings);
+        // parse inputs, reusing a prior parse of the unchanged file
+        const auto configuration = parse_config_snapshot(config_path,
+            config_settings);
 
         // map parsed inputs into variables map
         store(configuration, variables);
@@ -193,9 +339,9 @@ void load_environment_variables(variables_map& variables, command& instance)
     options_description environment_variables("environment");
     instance.load_environment(environment_variables);
 
-    // parse inputs
-    const auto environment = parse_environment(environment_variables,
-        BX_ENVIRONMENT_VARIABLE_PREFIX);
+    // parse inputs, from the snapshot of the process environment
+    const auto environment = parse_environment_snapshot(
+        environment_variables);
 
     store(environment, variables);
 }
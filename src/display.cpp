@@ -33,14 +33,13 @@ namespace explorer {
 
 void display_command_names(std::ostream& stream)
 {
-    const auto func = [&stream](std::shared_ptr<command> explorer_command)
+    const auto func = [&stream](const command_metadata& metadata)
     {
-        BITCOIN_ASSERT(explorer_command != nullptr);
-        if (!explorer_command->obsolete())
-            stream << explorer_command->name() << std::endl;
+        if (!metadata.obsolete)
+            stream << metadata.name << std::endl;
     };
 
-    broadcast(func);
+    broadcast_metadata(func);
 }
 
 void display_connection_failure(std::ostream& stream, const std::string& url)
@@ -71,6 +70,18 @@ void display_unexpected_exception(std::ostream& stream,
     stream << format(BX_UNEXPECTED_EXCEPTION) % message << std::endl;
 }
 
+void display_invalid_request(std::ostream& stream,
+    const std::string& command)
+{
+    stream << format(BX_INVALID_REQUEST) % command << std::endl;
+}
+
+void display_unsupported_format(std::ostream& stream,
+    const primitives::encoding& engine)
+{
+    stream << format(BX_UNSUPPORTED_FORMAT) % engine << std::endl;
+}
+
 void display_usage(std::ostream& stream)
 {
     stream 
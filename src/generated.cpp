@@ -19,6 +19,8 @@
  */
 #include <bitcoin/explorer/generated.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -87,10 +89,13 @@ void broadcast(const function<void(shared_ptr<command>)> func)
     func(make_shared<input_set>());
     func(make_shared<input_sign>());
     func(make_shared<input_validate>());
+    func(make_shared<load_test>());
     func(make_shared<mnemonic_decode>());
     func(make_shared<mnemonic_encode>());
     func(make_shared<mpk>());
     func(make_shared<newseed>());
+    func(make_shared<prewarm_tx>());
+    func(make_shared<probe_servers>());
     func(make_shared<qrcode>());
     func(make_shared<ripemd160>());
     func(make_shared<satoshi_to_btc>());
@@ -102,6 +107,7 @@ void broadcast(const function<void(shared_ptr<command>)> func)
     func(make_shared<send_tx_node>());
     func(make_shared<send_tx_p2p>());
     func(make_shared<sendtx_bci>());
+    func(make_shared<serve>());
     func(make_shared<settings>());
     func(make_shared<sha160>());
     func(make_shared<sha256>());
@@ -114,6 +120,7 @@ void broadcast(const function<void(shared_ptr<command>)> func)
     func(make_shared<stealth_public>());
     func(make_shared<stealth_secret>());
     func(make_shared<stealth_shared>());
+    func(make_shared<sync_headers>());
     func(make_shared<tx_decode>());
     func(make_shared<tx_encode>());
     func(make_shared<tx_sign>());
@@ -129,272 +136,294 @@ void broadcast(const function<void(shared_ptr<command>)> func)
     func(make_shared<wrap_encode>());
 }
 
-shared_ptr<command> find(const string& symbol)
+// Lookup table entry, tables are sorted by key for binary search.
+template <typename Value>
+struct entry
 {
-    if (symbol == address_decode::symbol())
-        return make_shared<address_decode>();
-    if (symbol == address_embed::symbol())
-        return make_shared<address_embed>();
-    if (symbol == address_encode::symbol())
-        return make_shared<address_encode>();
-    if (symbol == address_validate::symbol())
-        return make_shared<address_validate>();
-    if (symbol == base16_decode::symbol())
-        return make_shared<base16_decode>();
-    if (symbol == base16_encode::symbol())
-        return make_shared<base16_encode>();
-    if (symbol == base58_decode::symbol())
-        return make_shared<base58_decode>();
-    if (symbol == base58_encode::symbol())
-        return make_shared<base58_encode>();
-    if (symbol == base58check_decode::symbol())
-        return make_shared<base58check_decode>();
-    if (symbol == base58check_encode::symbol())
-        return make_shared<base58check_encode>();
-    if (symbol == bci_fetch_last_height::symbol())
-        return make_shared<bci_fetch_last_height>();
-    if (symbol == bci_history::symbol())
-        return make_shared<bci_history>();
-    if (symbol == bitcoin160::symbol())
-        return make_shared<bitcoin160>();
-    if (symbol == bitcoin256::symbol())
-        return make_shared<bitcoin256>();
-    if (symbol == blke_fetch_transaction::symbol())
-        return make_shared<blke_fetch_transaction>();
-    if (symbol == btc_to_satoshi::symbol())
-        return make_shared<btc_to_satoshi>();
-    if (symbol == ec_add::symbol())
-        return make_shared<ec_add>();
-    if (symbol == ec_add_secrets::symbol())
-        return make_shared<ec_add_secrets>();
-    if (symbol == ec_lock::symbol())
-        return make_shared<ec_lock>();
-    if (symbol == ec_multiply::symbol())
-        return make_shared<ec_multiply>();
-    if (symbol == ec_multiply_secrets::symbol())
-        return make_shared<ec_multiply_secrets>();
-    if (symbol == ec_new::symbol())
-        return make_shared<ec_new>();
-    if (symbol == ec_to_address::symbol())
-        return make_shared<ec_to_address>();
-    if (symbol == ec_to_public::symbol())
-        return make_shared<ec_to_public>();
-    if (symbol == ec_to_wif::symbol())
-        return make_shared<ec_to_wif>();
-    if (symbol == ec_unlock::symbol())
-        return make_shared<ec_unlock>();
-    if (symbol == fetch_balance::symbol())
-        return make_shared<fetch_balance>();
-    if (symbol == fetch_header::symbol())
-        return make_shared<fetch_header>();
-    if (symbol == fetch_height::symbol())
-        return make_shared<fetch_height>();
-    if (symbol == fetch_history::symbol())
-        return make_shared<fetch_history>();
-    if (symbol == fetch_public_key::symbol())
-        return make_shared<fetch_public_key>();
-    if (symbol == fetch_stealth::symbol())
-        return make_shared<fetch_stealth>();
-    if (symbol == fetch_tx::symbol())
-        return make_shared<fetch_tx>();
-    if (symbol == fetch_tx_index::symbol())
-        return make_shared<fetch_tx_index>();
-    if (symbol == fetch_utxo::symbol())
-        return make_shared<fetch_utxo>();
-    if (symbol == genaddr::symbol())
-        return make_shared<genaddr>();
-    if (symbol == genpriv::symbol())
-        return make_shared<genpriv>();
-    if (symbol == genpub::symbol())
-        return make_shared<genpub>();
-    if (symbol == hd_new::symbol())
-        return make_shared<hd_new>();
-    if (symbol == hd_private::symbol())
-        return make_shared<hd_private>();
-    if (symbol == hd_public::symbol())
-        return make_shared<hd_public>();
-    if (symbol == hd_to_address::symbol())
-        return make_shared<hd_to_address>();
-    if (symbol == hd_to_ec::symbol())
-        return make_shared<hd_to_ec>();
-    if (symbol == hd_to_public::symbol())
-        return make_shared<hd_to_public>();
-    if (symbol == hd_to_wif::symbol())
-        return make_shared<hd_to_wif>();
-    if (symbol == help::symbol())
-        return make_shared<help>();
-    if (symbol == initchain::symbol())
-        return make_shared<initchain>();
-    if (symbol == input_set::symbol())
-        return make_shared<input_set>();
-    if (symbol == input_sign::symbol())
-        return make_shared<input_sign>();
-    if (symbol == input_validate::symbol())
-        return make_shared<input_validate>();
-    if (symbol == mnemonic_decode::symbol())
-        return make_shared<mnemonic_decode>();
-    if (symbol == mnemonic_encode::symbol())
-        return make_shared<mnemonic_encode>();
-    if (symbol == mpk::symbol())
-        return make_shared<mpk>();
-    if (symbol == newseed::symbol())
-        return make_shared<newseed>();
-    if (symbol == qrcode::symbol())
-        return make_shared<qrcode>();
-    if (symbol == ripemd160::symbol())
-        return make_shared<ripemd160>();
-    if (symbol == satoshi_to_btc::symbol())
-        return make_shared<satoshi_to_btc>();
-    if (symbol == script_decode::symbol())
-        return make_shared<script_decode>();
-    if (symbol == script_encode::symbol())
-        return make_shared<script_encode>();
-    if (symbol == script_to_address::symbol())
-        return make_shared<script_to_address>();
-    if (symbol == seed::symbol())
-        return make_shared<seed>();
-    if (symbol == send_tx::symbol())
-        return make_shared<send_tx>();
-    if (symbol == send_tx_node::symbol())
-        return make_shared<send_tx_node>();
-    if (symbol == send_tx_p2p::symbol())
-        return make_shared<send_tx_p2p>();
-    if (symbol == sendtx_bci::symbol())
-        return make_shared<sendtx_bci>();
-    if (symbol == settings::symbol())
-        return make_shared<settings>();
-    if (symbol == sha160::symbol())
-        return make_shared<sha160>();
-    if (symbol == sha256::symbol())
-        return make_shared<sha256>();
-    if (symbol == sha512::symbol())
-        return make_shared<sha512>();
-    if (symbol == showblkhead::symbol())
-        return make_shared<showblkhead>();
-    if (symbol == stealth_decode::symbol())
-        return make_shared<stealth_decode>();
-    if (symbol == stealth_encode::symbol())
-        return make_shared<stealth_encode>();
-    if (symbol == stealth_initiate::symbol())
-        return make_shared<stealth_initiate>();
-    if (symbol == stealth_newkey::symbol())
-        return make_shared<stealth_newkey>();
-    if (symbol == stealth_public::symbol())
-        return make_shared<stealth_public>();
-    if (symbol == stealth_secret::symbol())
-        return make_shared<stealth_secret>();
-    if (symbol == stealth_shared::symbol())
-        return make_shared<stealth_shared>();
-    if (symbol == tx_decode::symbol())
-        return make_shared<tx_decode>();
-    if (symbol == tx_encode::symbol())
-        return make_shared<tx_encode>();
-    if (symbol == tx_sign::symbol())
-        return make_shared<tx_sign>();
-    if (symbol == uri_decode::symbol())
-        return make_shared<uri_decode>();
-    if (symbol == uri_encode::symbol())
-        return make_shared<uri_encode>();
-    if (symbol == validate_tx::symbol())
-        return make_shared<validate_tx>();
-    if (symbol == wallet::symbol())
-        return make_shared<wallet>();
-    if (symbol == watch_address::symbol())
-        return make_shared<watch_address>();
-    if (symbol == watch_tx::symbol())
-        return make_shared<watch_tx>();
-    if (symbol == wif_to_ec::symbol())
-        return make_shared<wif_to_ec>();
-    if (symbol == wif_to_public::symbol())
-        return make_shared<wif_to_public>();
-    if (symbol == wrap_decode::symbol())
-        return make_shared<wrap_decode>();
-    if (symbol == wrap_encode::symbol())
-        return make_shared<wrap_encode>();
+    const char* key;
+    Value value;
+};
+
+typedef shared_ptr<command>(*factory)();
 
-    return nullptr;
+// Construct only the command that is matched.
+template <typename Command>
+static shared_ptr<command> construct()
+{
+    return make_shared<Command>();
 }
 
-std::string formerly(const string& former)
+template <typename Value>
+static bool precedes(const entry<Value>& left, const string& right)
+{
+    return right.compare(left.key) > 0;
+}
+
+template <typename Value, size_t Size>
+static const entry<Value>* lookup(const entry<Value> (&table)[Size],
+    const string& key)
+{
+    const auto end = table + Size;
+    const auto it = lower_bound(table, end, key, precedes<Value>);
+    return it == end || key != it->key ? nullptr : it;
+}
+
+static const entry<factory> symbols[] =
+{
+    { "address-decode", &construct<address_decode> },
+    { "address-embed", &construct<address_embed> },
+    { "address-encode", &construct<address_encode> },
+    { "address-validate", &construct<address_validate> },
+    { "base16-decode", &construct<base16_decode> },
+    { "base16-encode", &construct<base16_encode> },
+    { "base58-decode", &construct<base58_decode> },
+    { "base58-encode", &construct<base58_encode> },
+    { "base58check-decode", &construct<base58check_decode> },
+    { "base58check-encode", &construct<base58check_encode> },
+    { "bci-fetch-last-height", &construct<bci_fetch_last_height> },
+    { "bci-history", &construct<bci_history> },
+    { "bitcoin160", &construct<bitcoin160> },
+    { "bitcoin256", &construct<bitcoin256> },
+    { "blke-fetch-transaction", &construct<blke_fetch_transaction> },
+    { "btc-to-satoshi", &construct<btc_to_satoshi> },
+    { "ec-add", &construct<ec_add> },
+    { "ec-add-secrets", &construct<ec_add_secrets> },
+    { "ec-lock", &construct<ec_lock> },
+    { "ec-multiply", &construct<ec_multiply> },
+    { "ec-multiply-secrets", &construct<ec_multiply_secrets> },
+    { "ec-new", &construct<ec_new> },
+    { "ec-to-address", &construct<ec_to_address> },
+    { "ec-to-public", &construct<ec_to_public> },
+    { "ec-to-wif", &construct<ec_to_wif> },
+    { "ec-unlock", &construct<ec_unlock> },
+    { "fetch-balance", &construct<fetch_balance> },
+    { "fetch-header", &construct<fetch_header> },
+    { "fetch-height", &construct<fetch_height> },
+    { "fetch-history", &construct<fetch_history> },
+    { "fetch-public-key", &construct<fetch_public_key> },
+    { "fetch-stealth", &construct<fetch_stealth> },
+    { "fetch-tx", &construct<fetch_tx> },
+    { "fetch-tx-index", &construct<fetch_tx_index> },
+    { "fetch-utxo", &construct<fetch_utxo> },
+    { "genaddr", &construct<genaddr> },
+    { "genpriv", &construct<genpriv> },
+    { "genpub", &construct<genpub> },
+    { "hd-new", &construct<hd_new> },
+    { "hd-private", &construct<hd_private> },
+    { "hd-public", &construct<hd_public> },
+    { "hd-to-address", &construct<hd_to_address> },
+    { "hd-to-ec", &construct<hd_to_ec> },
+    { "hd-to-public", &construct<hd_to_public> },
+    { "hd-to-wif", &construct<hd_to_wif> },
+    { "help", &construct<help> },
+    { "initchain", &construct<initchain> },
+    { "input-set", &construct<input_set> },
+    { "input-sign", &construct<input_sign> },
+    { "input-validate", &construct<input_validate> },
+    { "load-test", &construct<load_test> },
+    { "mnemonic-decode", &construct<mnemonic_decode> },
+    { "mnemonic-encode", &construct<mnemonic_encode> },
+    { "mpk", &construct<mpk> },
+    { "newseed", &construct<newseed> },
+    { "prewarm-tx", &construct<prewarm_tx> },
+    { "probe-servers", &construct<probe_servers> },
+    { "qrcode", &construct<qrcode> },
+    { "ripemd160", &construct<ripemd160> },
+    { "satoshi-to-btc", &construct<satoshi_to_btc> },
+    { "script-decode", &construct<script_decode> },
+    { "script-encode", &construct<script_encode> },
+    { "script-to-address", &construct<script_to_address> },
+    { "seed", &construct<seed> },
+    { "send-tx", &construct<send_tx> },
+    { "send-tx-node", &construct<send_tx_node> },
+    { "send-tx-p2p", &construct<send_tx_p2p> },
+    { "sendtx-bci", &construct<sendtx_bci> },
+    { "serve", &construct<serve> },
+    { "settings", &construct<settings> },
+    { "sha160", &construct<sha160> },
+    { "sha256", &construct<sha256> },
+    { "sha512", &construct<sha512> },
+    { "showblkhead", &construct<showblkhead> },
+    { "stealth-decode", &construct<stealth_decode> },
+    { "stealth-encode", &construct<stealth_encode> },
+    { "stealth-initiate", &construct<stealth_initiate> },
+    { "stealth-newkey", &construct<stealth_newkey> },
+    { "stealth-public", &construct<stealth_public> },
+    { "stealth-secret", &construct<stealth_secret> },
+    { "stealth-shared", &construct<stealth_shared> },
+    { "sync-headers", &construct<sync_headers> },
+    { "tx-decode", &construct<tx_decode> },
+    { "tx-encode", &construct<tx_encode> },
+    { "tx-sign", &construct<tx_sign> },
+    { "uri-decode", &construct<uri_decode> },
+    { "uri-encode", &construct<uri_encode> },
+    { "validate-tx", &construct<validate_tx> },
+    { "wallet", &construct<wallet> },
+    { "watch-address", &construct<watch_address> },
+    { "watch-tx", &construct<watch_tx> },
+    { "wif-to-ec", &construct<wif_to_ec> },
+    { "wif-to-public", &construct<wif_to_public> },
+    { "wrap-decode", &construct<wrap_decode> },
+    { "wrap-encode", &construct<wrap_encode> }
+};
+
+static const entry<const char*> formers[] =
 {
-    if (former == address_decode::formerly())
-        return address_decode::symbol();
-    if (former == address_embed::formerly())
-        return address_embed::symbol();
-    if (former == address_encode::formerly())
-        return address_encode::symbol();
-    if (former == address_validate::formerly())
-        return address_validate::symbol();
-    if (former == btc_to_satoshi::formerly())
-        return btc_to_satoshi::symbol();
-    if (former == ec_add_secrets::formerly())
-        return ec_add_secrets::symbol();
-    if (former == ec_lock::formerly())
-        return ec_lock::symbol();
-    if (former == ec_multiply_secrets::formerly())
-        return ec_multiply_secrets::symbol();
-    if (former == ec_new::formerly())
-        return ec_new::symbol();
-    if (former == ec_to_address::formerly())
-        return ec_to_address::symbol();
-    if (former == ec_to_public::formerly())
-        return ec_to_public::symbol();
-    if (former == fetch_height::formerly())
-        return fetch_height::symbol();
-    if (former == fetch_public_key::formerly())
-        return fetch_public_key::symbol();
-    if (former == fetch_tx::formerly())
-        return fetch_tx::symbol();
-    if (former == fetch_tx_index::formerly())
-        return fetch_tx_index::symbol();
-    if (former == fetch_utxo::formerly())
-        return fetch_utxo::symbol();
-    if (former == hd_new::formerly())
-        return hd_new::symbol();
-    if (former == input_set::formerly())
-        return input_set::symbol();
-    if (former == input_sign::formerly())
-        return input_sign::symbol();
-    if (former == input_validate::formerly())
-        return input_validate::symbol();
-    if (former == mnemonic_encode::formerly())
-        return mnemonic_encode::symbol();
-    if (former == ripemd160::formerly())
-        return ripemd160::symbol();
-    if (former == satoshi_to_btc::formerly())
-        return satoshi_to_btc::symbol();
-    if (former == script_decode::formerly())
-        return script_decode::symbol();
-    if (former == script_encode::formerly())
-        return script_encode::symbol();
-    if (former == script_to_address::formerly())
-        return script_to_address::symbol();
-    if (former == send_tx::formerly())
-        return send_tx::symbol();
-    if (former == send_tx_node::formerly())
-        return send_tx_node::symbol();
-    if (former == send_tx_p2p::formerly())
-        return send_tx_p2p::symbol();
-    if (former == stealth_decode::formerly())
-        return stealth_decode::symbol();
-    if (former == stealth_public::formerly())
-        return stealth_public::symbol();
-    if (former == stealth_secret::formerly())
-        return stealth_secret::symbol();
-    if (former == tx_sign::formerly())
-        return tx_sign::symbol();
-    if (former == validate_tx::formerly())
-        return validate_tx::symbol();
-    if (former == watch_address::formerly())
-        return watch_address::symbol();
-    if (former == watch_tx::formerly())
-        return watch_tx::symbol();
-    if (former == wrap_decode::formerly())
-        return wrap_decode::symbol();
-    if (former == wrap_encode::formerly())
-        return wrap_encode::symbol();
+    { "addr", "ec-to-address" },
+    { "brainwallet", "ec-lock" },
+    { "btc", "satoshi-to-btc" },
+    { "decode-addr", "address-decode" },
+    { "ec-add-modp", "ec-add-secrets" },
+    { "ec-tweak-add", "ec-multiply-secrets" },
+    { "embed-addr", "address-embed" },
+    { "encode-addr", "address-encode" },
+    { "fetch-last-height", "fetch-height" },
+    { "fetch-transaction", "fetch-tx" },
+    { "fetch-transaction-index", "fetch-tx-index" },
+    { "get-pubkey", "fetch-public-key" },
+    { "get-utxo", "fetch-utxo" },
+    { "hd-seed", "hd-new" },
+    { "mnemonic", "mnemonic-encode" },
+    { "monitor", "watch-address" },
+    { "newkey", "ec-new" },
+    { "pubkey", "ec-to-public" },
+    { "rawscript", "script-encode" },
+    { "ripemd-hash", "ripemd160" },
+    { "satoshi", "btc-to-satoshi" },
+    { "scripthash", "script-to-address" },
+    { "sendtx-node", "send-tx-node" },
+    { "sendtx-obelisk", "send-tx" },
+    { "sendtx-p2p", "send-tx-p2p" },
+    { "set-input", "input-set" },
+    { "showscript", "script-decode" },
+    { "sign-input", "input-sign" },
+    { "signtx", "tx-sign" },
+    { "stealth-show-addr", "stealth-decode" },
+    { "stealth-uncover", "stealth-public" },
+    { "stealth-uncover-secret", "stealth-secret" },
+    { "unwrap", "wrap-decode" },
+    { "validaddr", "address-validate" },
+    { "validsig", "input-validate" },
+    { "validtx", "validate-tx" },
+    { "watchtx", "watch-tx" },
+    { "wrap", "wrap-encode" }
+};
 
-    return "";
+static const command_metadata metadata[] =
+{
+    { "address-decode", "WALLET", "Convert a Bitcoin address to its component parts.", false },
+    { "address-embed", "WALLET", "Generate a Bitcoin address with an embedded record of binary data.", false },
+    { "address-encode", "WALLET", "Convert a RIPEMD160 value to a Bitcoin address.", false },
+    { "address-validate", "WALLET", "Validate an address. Returns the address if it is valid.", false },
+    { "base16-decode", "HASH", "Convert a Base16 value to binary data.", false },
+    { "base16-encode", "HASH", "Convert binary data to Base16.", false },
+    { "base58-decode", "HASH", "Convert a Base58 value to Base16.", false },
+    { "base58-encode", "HASH", "Convert a Base16 value to Base58.", false },
+    { "base58check-decode", "HASH", "Convert a Base58Check value to Base16.", false },
+    { "base58check-encode", "HASH", "Convert a Base16 value to Base58Check.", false },
+    { "bci-fetch-last-height", "ONLINE", "Get the last block height from blockchain.info.", true },
+    { "bci-history", "ONLINE", "Get the list of outputs, values and spends for an address from blockchain.info.", true },
+    { "bitcoin160", "HASH", "Perform a RIPEMD160 hash of a SHA256 hash of Base16 data.", false },
+    { "bitcoin256", "HASH", "Perform a SHA256 hash of a SHA256 hash of Base16 data and then reverse the byte order.", false },
+    { "blke-fetch-transaction", "ONLINE", "Get a Bitcoin transaction from blockexplorer.com.", true },
+    { "btc-to-satoshi", "MATH", "Convert BTC to satoshi.", false },
+    { "ec-add", "MATH", "Calculate the EC function POINT + (SECRET * curve-generator-point).", false },
+    { "ec-add-secrets", "MATH", "Calculate the EC function (SECRET + SECRET) % curve-order.", false },
+    { "ec-lock", "WALLET", "Make a passphrase-protected EC private key (BIP38) from an EC private key.", false },
+    { "ec-multiply", "MATH", "Calculate the EC product (POINT * SECRET).", false },
+    { "ec-multiply-secrets", "MATH", "Calculate the EC function (SECRET * SECRET) % curve-order.", false },
+    { "ec-new", "WALLET", "Create a new EC private key from entropy.", false },
+    { "ec-to-address", "WALLET", "Convert an EC public key to a Bitcoin address.", false },
+    { "ec-to-public", "WALLET", "Derive the EC public key of an EC private key. Defaults to the compressed public key format.", false },
+    { "ec-to-wif", "WALLET", "Convert an EC private key to a WIF private key. The result associates with the compressed public key format by default.", false },
+    { "ec-unlock", "WALLET", "Extract the EC private key from a passphrase-protected (BIP38) EC private key.", false },
+    { "fetch-balance", "ONLINE", "Get the balance in satoshi of a set of Bitcoin addresses. The total balance of the set is included for more than one address. Requires an Obelisk server connection.", false },
+    { "fetch-header", "ONLINE", "Get the block header from the specified hash or height. Height is ignored if both are specified. Requires an Obelisk server connection.", false },
+    { "fetch-height", "ONLINE", "Get the last block height. Requires an Obelisk server connection.", false },
+    { "fetch-history", "ONLINE", "Get list of output points, values, and spends for a set of Bitcoin addresses. Requires an Obelisk server connection.", false },
+    { "fetch-public-key", "ONLINE", "Get the EC public key of the address, if it exists on the blockchain. Requires an Obelisk server connection.", false },
+    { "fetch-stealth", "ONLINE", "Get metadata on potential payment transactions by stealth prefix. Requires an Obelisk server connection.", false },
+    { "fetch-tx", "ONLINE", "Get a transaction by its hash. Requires an Obelisk server connection.", false },
+    { "fetch-tx-index", "ONLINE", "Get the block height and index of a transaction. Requires an Obelisk server connection.", false },
+    { "fetch-utxo", "ONLINE", "Get enough unspent transaction outputs from a Bitcoin addresses to pay a number of satoshi. Requires an Obelisk server connection.", false },
+    { "genaddr", "ELECTRUM", "Generate a Bitcoin address deterministically from an Electrum wallet.", true },
+    { "genpriv", "ELECTRUM", "Generate a private key deterministically from an Electrum seed.", true },
+    { "genpub", "ELECTRUM", "Generate a public key deterministically from an Electrum wallet.", true },
+    { "hd-new", "WALLET", "Create a new HD (BIP32) private key from entropy.", false },
+    { "hd-private", "WALLET", "Derive a child HD (BIP32) private key from another HD private key.", false },
+    { "hd-public", "WALLET", "Derive a child HD (BIP32) public key from another HD public or private key.", false },
+    { "hd-to-address", "WALLET", "Convert a HD (BIP32) public or private key to a Bitcoin address.", false },
+    { "hd-to-ec", "WALLET", "Convert a HD (BIP32) public or private key to the equivalent EC public or private key.", false },
+    { "hd-to-public", "WALLET", "Derive the HD (BIP32) public key of a HD private key.", false },
+    { "hd-to-wif", "WALLET", "Convert a HD (BIP32) private key to a WIF private key.", false },
+    { "help", "BX", "Get the list of commands.", false },
+    { "initchain", "ONLINE", "Initialize a new blockchain database.", true },
+    { "input-set", "TRANSACTION", "Assign a script to an existing transaction input.", false },
+    { "input-sign", "TRANSACTION", "Create a Bitcoin signature for a transaction input.", false },
+    { "input-validate", "TRANSACTION", "Validate a transaction signature.", false },
+    { "load-test", "ONLINE", "Measure the throughput of an Obelisk server by keeping a number of height, header, transaction and history requests outstanding, at a target rate, for a fixed duration. Reports throughput, latency percentiles and timeout and retry counts. Requires an Obelisk server connection.", false },
+    { "mnemonic-decode", "WALLET", "Convert an Electrum mnemonic to its seed. WARNING: mnemonic should be generated from a random seed. WARNING: This implementation is deprecated in favor of BIP39.", false },
+    { "mnemonic-encode", "WALLET", "Convert a seed to its Electrum mnemonic. WARNING: This implementation is deprecated in favor of BIP39.", false },
+    { "mpk", "ELECTRUM", "Extract a master public key from a deterministic wallet seed.", true },
+    { "newseed", "ELECTRUM", "Create a new Electrum style deterministic wallet seed.", true },
+    { "prewarm-tx", "ONLINE", "Fetch a set of transactions into the transaction cache, requesting only those not already cached. Requires the cache.transaction setting and an Obelisk server connection.", false },
+    { "probe-servers", "ONLINE", "Measure the latency and height lag of a set of Obelisk servers and rank them by health and median latency. The ranking is written to the general.ranking file, if configured, from which network commands select their servers. Requires Obelisk server connections.", false },
+    { "qrcode", "WALLET", "Generate a QR code image file for a Bitcoin address.", false },
+    { "ripemd160", "HASH", "Perform a RIPEMD160 hash of Base16 data.", false },
+    { "satoshi-to-btc", "MATH", "Convert satoshi to BTC.", false },
+    { "script-decode", "SCRIPT", "Decode a script to plain text tokens.", false },
+    { "script-encode", "SCRIPT", "Base16 encode a plain text script.", false },
+    { "script-to-address", "SCRIPT", "Create a BIP16 pay-to-script-hash address from an encoded script.", false },
+    { "seed", "WALLET", "Generate a pseudorandom seed.", false },
+    { "send-tx", "ONLINE", "Broadcast a transaction to the Bitcoin network via an Obelisk server.", false },
+    { "send-tx-node", "ONLINE", "Broadcast a transaction to the Bitcoin network via a single Bitcoin network node.", false },
+    { "send-tx-p2p", "ONLINE", "Broadcast a transaction to the Bitcoin network via the Bitcoin peer-to-peer network.", false },
+    { "sendtx-bci", "ONLINE", "Broadcast a transaction to the Bitcoin network via blockchain.info.", true },
+    { "serve", "BX", "Run bx commands on behalf of local clients from a single long-running process. Each request is a multipart message of the command name followed by its arguments. Each reply is a multipart message of the console result, the output text and the error text.", false },
+    { "settings", "BX", "Display the loaded configuration settings.", false },
+    { "sha160", "HASH", "Perform a SHA160 (also known as SHA-1) hash of Base16 data.", false },
+    { "sha256", "HASH", "Perform a SHA256 hash of Base16 data.", false },
+    { "sha512", "HASH", "Perform a SHA512 hash of Base16 data.", false },
+    { "showblkhead", "TRANSACTION", "Decode a block header.", true },
+    { "stealth-decode", "STEALTH", "Decode a stealth address.", false },
+    { "stealth-encode", "STEALTH", "Encode a stealth payment address.", false },
+    { "stealth-initiate", "STEALTH", "Create a new stealth public key from which a payment address can be generated.", true },
+    { "stealth-newkey", "STEALTH", "Generate new keys and the associated stealth address.", true },
+    { "stealth-public", "STEALTH", "Derive the stealth public key necessary to address and to identify a stealth payment.", false },
+    { "stealth-secret", "STEALTH", "Derive the stealth private key necessary to spend a stealth payment.", false },
+    { "stealth-shared", "STEALTH", "Derive the secret shared between an ephemeral key pair and a scan key pair. Provide scan SECRET and ephemeral PUBKEY, or ephemeral SECRET and scan PUBKEY.", false },
+    { "sync-headers", "ONLINE", "Fetch block headers from the last stored header to the last height of the server, verify their linkage, proof of work and difficulty and append them to the header file. Stored headers that are no longer in the server's chain are first removed. Requires the cache.header setting and an Obelisk server connection.", false },
+    { "tx-decode", "TRANSACTION", "Decode a Base16 transaction.", false },
+    { "tx-encode", "TRANSACTION", "Encode an unsigned transaction as Base16.", false },
+    { "tx-sign", "TRANSACTION", "Sign a set of transactions using a private key. Output is suitable for sending to Bitcoin network.", false },
+    { "uri-decode", "WALLET", "Validate and decompose a Bitcoin URI into its parts.", false },
+    { "uri-encode", "WALLET", "Compose a Bitcoin URI from specified parts.", false },
+    { "validate-tx", "ONLINE", "Determine if a transaction is valid for submission to the blockchain. Requires an Obelisk server connection.", false },
+    { "wallet", "WALLET", "Experimental command line wallet.", true },
+    { "watch-address", "ONLINE", "Watch the network for transactions in which an address participates. Requires an Obelisk server connection.", false },
+    { "watch-tx", "ONLINE", "Watch the network for a transaction by hash. Requires an Obelisk server connection.", false },
+    { "wif-to-ec", "WALLET", "Convert a WIF private key to an EC private key.", false },
+    { "wif-to-public", "WALLET", "Derive the EC public key from a WIF private key.", false },
+    { "wrap-decode", "HASH", "Validate the checksum of a Base16 data and recover its version byte and data.", false },
+    { "wrap-encode", "HASH", "Add a version byte and checksum to Base16 data.", false }
+};
+
+void broadcast_metadata(const function<void(const command_metadata&)> func)
+{
+    for (const auto& command: metadata)
+        func(command);
+}
+
+shared_ptr<command> find(const string& symbol)
+{
+    const auto match = lookup(symbols, symbol);
+    return match == nullptr ? nullptr : match->value();
+}
+
+std::string formerly(const string& former)
+{
+    const auto match = lookup(formers, former);
+    return match == nullptr ? "" : match->value;
 }
 
 } // namespace explorer
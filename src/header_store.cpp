@@ -0,0 +1,399 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/header_store.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+
+// The file begins with a magic, a format version and the number of headers,
+// which is updated only after the headers are fully written.
+static const uint32_t store_magic = 0x68687862;
+static const uint32_t store_version = 1;
+static const size_t header_size = 4 + 4 + 8;
+static const size_t stride = 80;
+
+static bool create(const boost::filesystem::path& path)
+{
+    data_chunk header(header_size);
+    auto serial = make_serializer(header.begin());
+    serial.write_4_bytes(store_magic);
+    serial.write_4_bytes(store_version);
+    serial.write_8_bytes(0);
+
+    std::ofstream file(path.string(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    return file.good();
+}
+
+// Headers are retargeted every two weeks of ten minute blocks. The minimum
+// difficulty is the proof of work limit of both mainnet and testnet.
+static const size_t retarget_interval = 2016;
+static const uint32_t target_spacing = 10 * 60;
+static const uint32_t target_timespan = 14 * 24 * 60 * 60;
+static const uint32_t minimum_bits = 0x1d00ffff;
+
+// Expand the compact target. A negative or zero target, or one that overflows
+// 256 bits, is invalid. Targets are held as hashes are, in display order, so
+// they compare as big-endian numbers.
+static bool expand(hash_digest& target, uint32_t bits)
+{
+    const auto exponent = static_cast<int>(bits >> 24);
+    const auto mantissa = bits & 0x007fffff;
+    if ((bits & 0x00800000) != 0 || mantissa == 0)
+        return false;
+
+    target = null_hash;
+    for (int byte = 0; byte < 3; ++byte)
+    {
+        const auto value = static_cast<uint8_t>(mantissa >> (8 * byte));
+        const auto significance = exponent - 3 + byte;
+        if (value == 0 || significance < 0)
+            continue;
+
+        if (significance >= static_cast<int>(hash_size))
+            return false;
+
+        target[hash_size - 1 - significance] = value;
+    }
+
+    return true;
+}
+
+// Compress a target to its three most significant bytes, shifted a byte
+// further if required to keep the sign bit clear.
+static uint32_t compress(const hash_digest& target)
+{
+    const auto first = std::find_if(target.begin(), target.end(),
+        [](uint8_t byte) { return byte != 0; });
+
+    auto size = static_cast<uint32_t>(target.end() - first);
+    uint32_t mantissa = 0;
+    for (uint32_t index = 0; index < 3; ++index)
+        mantissa = (mantissa << 8) | (index < size ? first[index] : 0);
+
+    if ((mantissa & 0x00800000) != 0)
+    {
+        mantissa >>= 8;
+        ++size;
+    }
+
+    return (size << 24) | mantissa;
+}
+
+static void multiply(hash_digest& value, uint32_t factor)
+{
+    uint64_t carry = 0;
+    for (auto byte = value.rbegin(); byte != value.rend(); ++byte)
+    {
+        carry += static_cast<uint64_t>(*byte) * factor;
+        *byte = static_cast<uint8_t>(carry);
+        carry >>= 8;
+    }
+}
+
+static void divide(hash_digest& value, uint32_t divisor)
+{
+    uint64_t remainder = 0;
+    for (auto& byte: value)
+    {
+        remainder = (remainder << 8) | byte;
+        byte = static_cast<uint8_t>(remainder / divisor);
+        remainder %= divisor;
+    }
+}
+
+static bool check_proof_of_work(const hash_digest& hash, uint32_t bits)
+{
+    hash_digest target;
+    return expand(target, bits) && !std::lexicographical_compare(
+        target.begin(), target.end(), hash.begin(), hash.end());
+}
+
+// Scale the target of the last header of a period by the timespan of the
+// period, limited to a factor of four either way and to the minimum
+// difficulty. The proof of work limit is the full 224 bit value, not the
+// expansion of the minimum bits.
+static uint32_t retarget_bits(uint32_t bits, uint32_t first_time,
+    uint32_t last_time)
+{
+    const auto span = static_cast<int64_t>(last_time) - first_time;
+    const auto timespan = static_cast<uint32_t>(std::max<int64_t>(
+        target_timespan / 4, std::min<int64_t>(span, target_timespan * 4)));
+
+    hash_digest target;
+    if (!expand(target, bits))
+        return 0;
+
+    multiply(target, timespan);
+    divide(target, target_timespan);
+
+    hash_digest limit;
+    limit.fill(0xff);
+    std::fill(limit.begin(), limit.begin() + 4, 0);
+    if (std::lexicographical_compare(limit.begin(), limit.end(),
+        target.begin(), target.end()))
+        target = limit;
+
+    return compress(target);
+}
+
+size_t header_store::verify(const std::vector<block_header_type>& headers,
+    const hash_digest& previous, size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    // Each thread hashes and checks a contiguous slice of the headers.
+    const auto size = headers.size();
+    std::vector<hash_digest> hashes(size);
+    std::vector<char> worked(size, 0);
+    const auto slice = (size + threads - 1) / threads;
+    auto check = [&headers, &hashes, &worked](size_t begin, size_t end)
+    {
+        for (auto index = begin; index < end; ++index)
+        {
+            hashes[index] = hash_block_header(headers[index]);
+            worked[index] = check_proof_of_work(hashes[index],
+                headers[index].bits) ? 1 : 0;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t begin = 0; begin < size; begin += slice)
+        workers.emplace_back(check, begin, std::min(begin + slice, size));
+
+    for (auto& worker: workers)
+        worker.join();
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        const auto& parent = index == 0 ? previous : hashes[index - 1];
+        if (worked[index] == 0 ||
+            headers[index].previous_block_hash != parent)
+            return index;
+    }
+
+    return size;
+}
+
+header_store::header_store(const boost::filesystem::path& path)
+  : lock_(lock_file(path)), count_(0)
+{
+    if (!lock_)
+        return;
+
+    if (!boost::filesystem::exists(path) && !create(path))
+        return;
+
+    file_.reset(new mmfile(path.string()));
+    if (!load())
+        file_.reset();
+}
+
+bool header_store::valid() const
+{
+    return file_ != nullptr;
+}
+
+size_t header_store::count() const
+{
+    return count_;
+}
+
+hash_digest header_store::top_hash() const
+{
+    block_header_type header;
+    if (count_ == 0 || !read(header, count_ - 1))
+        return null_hash;
+
+    return hash_block_header(header);
+}
+
+bool header_store::read(block_header_type& header, size_t height) const
+{
+    if (height >= count_)
+        return false;
+
+    const auto begin = file_->data() + header_size + height * stride;
+    const data_chunk raw(begin, begin + stride);
+    return deserialize_satoshi_item(header, raw);
+}
+
+// The hash of each stored header but the last is the previous hash of its
+// successor, so stored fields are compared and no header is hashed.
+bool header_store::find(block_header_type& header,
+    const hash_digest& hash) const
+{
+    if (count_ == 0)
+        return false;
+
+    if (top_hash() == hash)
+        return read(header, count_ - 1);
+
+    const auto begin = file_->data() + header_size;
+    for (auto height = count_ - 1; height > 0; --height)
+    {
+        const auto successor = begin + height * stride;
+        auto fields = make_deserializer(successor, successor + stride);
+        fields.read_4_bytes();
+        if (fields.read_hash() == hash)
+            return read(header, height - 1);
+    }
+
+    return false;
+}
+
+size_t header_store::verify_difficulty(
+    const std::vector<block_header_type>& headers, bool testnet) const
+{
+    block_header_type previous;
+    if (count_ > 0 && !read(previous, count_ - 1))
+        return 0;
+
+    // On testnet a header within twenty minutes of its predecessor carries
+    // the bits of the last header of the period that is not of minimum
+    // difficulty, or those of the first header of the period.
+    auto last_bits = minimum_bits;
+    if (testnet && count_ > 0)
+    {
+        auto height = count_ - 1;
+        auto prior = previous;
+        while (height % retarget_interval != 0 && prior.bits == minimum_bits)
+            if (!read(prior, --height))
+                return 0;
+
+        last_bits = prior.bits;
+    }
+
+    for (size_t index = 0; index < headers.size(); ++index)
+    {
+        const auto& header = headers[index];
+        const auto height = count_ + index;
+
+        uint32_t required;
+        if (height == 0)
+            required = minimum_bits;
+        else if (height % retarget_interval == 0)
+        {
+            block_header_type first;
+            const auto first_height = height - retarget_interval;
+            if (first_height >= count_)
+                first = headers[first_height - count_];
+            else if (!read(first, first_height))
+                return index;
+
+            required = retarget_bits(previous.bits, first.timestamp,
+                previous.timestamp);
+        }
+        else if (testnet && static_cast<uint64_t>(header.timestamp) >
+            static_cast<uint64_t>(previous.timestamp) + 2 * target_spacing)
+            required = minimum_bits;
+        else
+            required = testnet ? last_bits : previous.bits;
+
+        if (header.bits != required)
+            return index;
+
+        if (height % retarget_interval == 0 || header.bits != minimum_bits)
+            last_bits = header.bits;
+
+        previous = header;
+    }
+
+    return headers.size();
+}
+
+bool header_store::append(const std::vector<block_header_type>& headers)
+{
+    if (!valid())
+        return false;
+
+    // Grow geometrically so that appends are amortized.
+    const auto end = header_size + (count_ + headers.size()) * stride;
+    if (end > file_->size() &&
+        !file_->resize(std::max(end, file_->size() * 3 / 2)))
+        return false;
+
+    auto offset = header_size + count_ * stride;
+    for (const auto& header: headers)
+    {
+        const auto raw = serialize_satoshi_item(header);
+        if (raw.size() != stride)
+            return false;
+
+        std::copy(raw.begin(), raw.end(), file_->data() + offset);
+        offset += stride;
+    }
+
+    commit(count_ + headers.size());
+    return true;
+}
+
+// The count is committed before the file is shrunk, so that an interruption
+// leaves only unused space.
+bool header_store::truncate(size_t count)
+{
+    if (!valid() || count > count_)
+        return false;
+
+    if (count == count_)
+        return true;
+
+    commit(count);
+    return file_->resize(header_size + count * stride);
+}
+
+bool header_store::load()
+{
+    if (file_->data() == nullptr || file_->size() < header_size)
+        return false;
+
+    const auto begin = file_->data();
+    auto header = make_deserializer(begin, begin + header_size);
+    if (header.read_4_bytes() != store_magic ||
+        header.read_4_bytes() != store_version)
+        return false;
+
+    count_ = static_cast<size_t>(header.read_8_bytes());
+    return header_size + count_ * stride <= file_->size();
+}
+
+// Advance the count recorded in the header, which commits the headers.
+void header_store::commit(size_t count)
+{
+    count_ = count;
+    auto serial = make_serializer(file_->data() + 4 + 4);
+    serial.write_8_bytes(count_);
+}
+
+} // namespace explorer
+} // namespace libbitcoin
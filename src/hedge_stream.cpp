@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/hedge_stream.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+const size_t hedge_stream::minimum_samples = 20;
+const size_t hedge_stream::maximum_samples = 100;
+const size_t hedge_stream::hedge_percentile = 95;
+
+hedge_stream::hedge_stream(const period_ms& delay, const period_ms& expiry)
+  : delay_(delay), expiry_(expiry), sample_(0), retries_(0), hedges_(0)
+{
+}
+
+// The call id is the second frame of an obelisk message.
+static bool parse_id(data_chunk& id, const data_stack& data)
+{
+    if (data.size() < 2)
+        return false;
+
+    auto frame = data.begin();
+    id = *(++frame);
+    return true;
+}
+
+size_t hedge_stream::add(std::shared_ptr<message_stream> server)
+{
+    servers_.push_back(server);
+    averages_.push_back(0);
+    return servers_.size() - 1;
+}
+
+void hedge_stream::write(const data_stack& data)
+{
+    if (servers_.empty())
+        return;
+
+    const auto now = clock::now();
+    const auto ranked = order();
+    servers_[ranked.front()]->write(data);
+
+    data_chunk id;
+    if (!parse_id(id, data))
+        return;
+
+    // A retry by the codec reuses the id and so restarts the call.
+    if (calls_.find(id) != calls_.end())
+        ++retries_;
+
+    const auto hedge = delay();
+    auto& entry = calls_[id];
+    entry.data = data;
+    entry.sent = now;
+    entry.hedge = now + hedge;
+    entry.order = ranked;
+    entry.next = hedge.count() == 0 ? ranked.size() : 1;
+}
+
+void hedge_stream::reply(size_t server, const data_stack& data)
+{
+    data_chunk id;
+    if (!parse_id(id, data))
+        return;
+
+    // A missing call is answered already, or is not ours to hedge.
+    const auto it = calls_.find(id);
+    if (it == calls_.end())
+        return;
+
+    // Latency is measured from the first send, as that is what hedging
+    // is intended to reduce.
+    sample(server, clock::now() - it->second.sent);
+    calls_.erase(it);
+}
+
+period_ms hedge_stream::wakeup()
+{
+    const auto now = clock::now();
+    const auto hedge = delay();
+    auto next = clock::time_point::max();
+
+    for (auto it = calls_.begin(); it != calls_.end();)
+    {
+        auto& entry = it->second;
+        if (expiry_.count() != 0 && now - entry.sent >= expiry_)
+        {
+            it = calls_.erase(it);
+            continue;
+        }
+
+        if (entry.next < entry.order.size() && entry.hedge <= now)
+        {
+            servers_[entry.order[entry.next++]]->write(entry.data);
+            entry.hedge = now + hedge;
+            ++hedges_;
+        }
+
+        if (entry.next < entry.order.size())
+            next = std::min(next, entry.hedge);
+
+        ++it;
+    }
+
+    if (next == clock::time_point::max())
+        return period_ms(0);
+
+    // Round up so that the poller does not wake before the hedge is due.
+    return std::chrono::duration_cast<period_ms>(next - now) + period_ms(1);
+}
+
+period_ms hedge_stream::delay() const
+{
+    if (delay_.count() == 0 || samples_.size() < minimum_samples)
+        return delay_;
+
+    auto sorted = samples_;
+    const auto index = sorted.size() * hedge_percentile / 100;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return period_ms(std::max(sorted[index], period_ms::rep(1)));
+}
+
+size_t hedge_stream::retries() const
+{
+    return retries_;
+}
+
+size_t hedge_stream::hedges() const
+{
+    return hedges_;
+}
+
+// Measured servers in order of average latency, then the unmeasured servers
+// in order of preference.
+std::vector<size_t> hedge_stream::order() const
+{
+    std::vector<size_t> ranked(servers_.size());
+    for (size_t index = 0; index < ranked.size(); ++index)
+        ranked[index] = index;
+
+    const auto faster = [this](size_t left, size_t right)
+    {
+        const auto left_average = averages_[left];
+        const auto right_average = averages_[right];
+        if (left_average == 0 || right_average == 0)
+            return left_average != 0 && right_average == 0;
+
+        return left_average < right_average;
+    };
+
+    std::stable_sort(ranked.begin(), ranked.end(), faster);
+    return ranked;
+}
+
+void hedge_stream::sample(size_t server, const clock::duration& latency)
+{
+    // Exponentially weighted with one eighth given to the new sample.
+    auto& average = averages_[server];
+    const auto ticks = latency.count();
+    average = average == 0 ? ticks : (7 * average + ticks) / 8;
+
+    const auto milliseconds =
+        std::chrono::duration_cast<period_ms>(latency).count();
+
+    if (samples_.size() < maximum_samples)
+    {
+        samples_.push_back(milliseconds);
+        return;
+    }
+
+    samples_[sample_] = milliseconds;
+    sample_ = (sample_ + 1) % maximum_samples;
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -0,0 +1,365 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/history_cache.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+// The file begins with a magic, a format version and the end of the last
+// complete record, which is updated only after a record is fully written.
+static const uint32_t cache_magic = 0x63687862;
+static const uint32_t cache_version = 2;
+static const size_t header_size = 4 + 4 + 8;
+
+// A record is the address version and hash, the height from which it was
+// refreshed, the synced height and the count of rows, followed by the rows.
+static const size_t record_header_size = 1 + short_hash_size + 4 + 4 + 4;
+static const size_t row_size = hash_size + 4 + 4 + 8 + hash_size + 4 + 4;
+
+// An address is refreshed from this depth below its synced height, so that a
+// receive or spend that a reorganization removes or moves is corrected.
+static const uint32_t reorg_depth = 6;
+
+typedef std::pair<hash_digest, uint32_t> point_key;
+
+static point_key key_of(const history_row& row)
+{
+    return std::make_pair(row.output.hash, row.output.index);
+}
+
+static bool confirmed(const history_row& row)
+{
+    return row.output_height != 0;
+}
+
+// An unconfirmed spend may yet be dropped, so it is persisted as unspent.
+static history_row persistent(const history_row& row)
+{
+    auto copy = row;
+    if (copy.spend_height == 0)
+    {
+        copy.spend.hash = null_hash;
+        copy.spend.index = max_uint32;
+    }
+
+    return copy;
+}
+
+static bool same(const history_row& left, const history_row& right)
+{
+    return left.output.hash == right.output.hash &&
+        left.output.index == right.output.index &&
+        left.output_height == right.output_height &&
+        left.value == right.value &&
+        left.spend.hash == right.spend.hash &&
+        left.spend.index == right.spend.index &&
+        left.spend_height == right.spend_height;
+}
+
+// Replace the row of the same output point, or append a new row.
+static bool upsert(history_list& rows, std::map<point_key, size_t>& positions,
+    const history_row& row)
+{
+    const auto key = key_of(row);
+    const auto it = positions.find(key);
+    if (it == positions.end())
+    {
+        positions[key] = rows.size();
+        rows.push_back(row);
+        return true;
+    }
+
+    auto& existing = rows[it->second];
+    const auto changed = !same(existing, row);
+    existing = row;
+    return changed;
+}
+
+// Rows refreshed from a height replace the rows received at or above it and
+// the spends at or above it, so drop those rows and unspend the others.
+static void reset(history_list& rows, std::map<point_key, size_t>& positions,
+    uint32_t from)
+{
+    history_list kept;
+    positions.clear();
+    for (auto row: rows)
+    {
+        if (row.output_height >= from)
+            continue;
+
+        if (row.spend_height >= from)
+        {
+            row.spend.hash = null_hash;
+            row.spend.index = max_uint32;
+            row.spend_height = 0;
+        }
+
+        positions[key_of(row)] = kept.size();
+        kept.push_back(row);
+    }
+
+    rows.swap(kept);
+}
+
+// Determine whether two histories differ, regardless of the order of rows.
+static bool differ(const history_list& left, const history_list& right)
+{
+    if (left.size() != right.size())
+        return true;
+
+    std::map<point_key, size_t> positions;
+    for (size_t index = 0; index < left.size(); ++index)
+        positions[key_of(left[index])] = index;
+
+    for (const auto& row: right)
+    {
+        const auto position = positions.find(key_of(row));
+        if (position == positions.end() || !same(left[position->second], row))
+            return true;
+    }
+
+    return false;
+}
+
+static bool create(const boost::filesystem::path& path)
+{
+    data_chunk header(header_size);
+    auto serial = make_serializer(header.begin());
+    serial.write_4_bytes(cache_magic);
+    serial.write_4_bytes(cache_version);
+    serial.write_8_bytes(header_size);
+
+    std::ofstream file(path.string(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    return file.good();
+}
+
+history_cache::history_cache(const boost::filesystem::path& path)
+  : lock_(lock_file(path)), end_(0)
+{
+    if (!lock_)
+        return;
+
+    if (!boost::filesystem::exists(path) && !create(path))
+        return;
+
+    file_.reset(new mmfile(path.string()));
+    if (!load())
+    {
+        file_.reset();
+        entries_.clear();
+    }
+}
+
+bool history_cache::valid() const
+{
+    return file_ != nullptr;
+}
+
+size_t history_cache::height(const payment_address& address) const
+{
+    const auto it = entries_.find(key(address.version(), address.hash()));
+    if (it == entries_.end() || it->second.height < reorg_depth)
+        return 0;
+
+    return it->second.height - reorg_depth;
+}
+
+history_list history_cache::merge(const payment_address& address,
+    const history_list& rows)
+{
+    const key address_key(address.version(), address.hash());
+    const auto it = entries_.find(address_key);
+    const auto from = static_cast<uint32_t>(height(address));
+
+    history_list cached;
+    auto height = uint32_t(0);
+    if (it != entries_.end())
+    {
+        cached = read(it->second);
+        height = it->second.height;
+    }
+
+    // The rows fetched from the refresh height replace those of the cache,
+    // so a row that the server no longer returns is dropped or unspent.
+    std::map<point_key, size_t> positions;
+    auto merged = cached;
+    reset(merged, positions, from);
+
+    std::map<point_key, size_t> persisted_positions;
+    auto persisted = cached;
+    reset(persisted, persisted_positions, from);
+
+    // Rows are compared in persistent form so that an unconfirmed spend of
+    // a cached row does not rewrite it.
+    history_list refreshed;
+    auto synced = height;
+    for (const auto& row: rows)
+    {
+        upsert(merged, positions, row);
+        if (!confirmed(row))
+            continue;
+
+        const auto stored = persistent(row);
+        upsert(persisted, persisted_positions, stored);
+        refreshed.push_back(stored);
+        synced = std::max(synced, static_cast<uint32_t>(std::max(
+            row.output_height, row.spend_height)));
+    }
+
+    // A record replaces the rows of its range, so it holds all of them.
+    if (valid() && (differ(cached, persisted) || synced > height))
+        append(address_key, from, synced, refreshed);
+
+    return merged;
+}
+
+bool history_cache::load()
+{
+    if (file_->data() == nullptr || file_->size() < header_size)
+        return false;
+
+    const auto begin = file_->data();
+    auto header = make_deserializer(begin, begin + header_size);
+    if (header.read_4_bytes() != cache_magic ||
+        header.read_4_bytes() != cache_version)
+        return false;
+
+    end_ = static_cast<size_t>(header.read_8_bytes());
+    if (end_ < header_size || end_ > file_->size())
+        return false;
+
+    // Records beyond the end are incomplete and are overwritten.
+    auto offset = header_size;
+    while (offset < end_)
+    {
+        if (end_ - offset < record_header_size)
+            return false;
+
+        auto record = make_deserializer(begin + offset, begin + end_);
+        const auto version = record.read_byte();
+        const auto hash = record.read_short_hash();
+        record.read_4_bytes();
+        const auto synced = record.read_4_bytes();
+        const auto count = record.read_4_bytes();
+        const auto size = record_header_size + count * row_size;
+        if (end_ - offset < size)
+            return false;
+
+        auto& cached = entries_[key(version, hash)];
+        cached.height = std::max(cached.height, synced);
+        cached.records.push_back(offset);
+        offset += size;
+    }
+
+    return true;
+}
+
+history_list history_cache::read(const entry& cached) const
+{
+    history_list rows;
+    std::map<point_key, size_t> positions;
+    const auto begin = file_->data();
+
+    for (const auto offset: cached.records)
+    {
+        auto record = make_deserializer(begin + offset, begin + end_);
+        record.read_byte();
+        record.read_short_hash();
+        const auto from = record.read_4_bytes();
+        record.read_4_bytes();
+        const auto count = record.read_4_bytes();
+        reset(rows, positions, from);
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            history_row row;
+            row.output.hash = record.read_hash();
+            row.output.index = record.read_4_bytes();
+            row.output_height = record.read_4_bytes();
+            row.value = record.read_8_bytes();
+            row.spend.hash = record.read_hash();
+            row.spend.index = record.read_4_bytes();
+            row.spend_height = record.read_4_bytes();
+            upsert(rows, positions, row);
+        }
+    }
+
+    return rows;
+}
+
+bool history_cache::append(const key& address, uint32_t from,
+    uint32_t height, const history_list& rows)
+{
+    const auto size = record_header_size + rows.size() * row_size;
+    const auto required = end_ + size;
+
+    // Grow geometrically so that appends are amortized.
+    if (required > file_->size() &&
+        !file_->resize(std::max(required, file_->size() * 3 / 2)))
+        return false;
+
+    auto serial = make_serializer(file_->data() + end_);
+    serial.write_byte(address.first);
+    serial.write_short_hash(address.second);
+    serial.write_4_bytes(from);
+    serial.write_4_bytes(height);
+    serial.write_4_bytes(static_cast<uint32_t>(rows.size()));
+
+    for (const auto& row: rows)
+    {
+        serial.write_hash(row.output.hash);
+        serial.write_4_bytes(row.output.index);
+        serial.write_4_bytes(static_cast<uint32_t>(row.output_height));
+        serial.write_8_bytes(row.value);
+        serial.write_hash(row.spend.hash);
+        serial.write_4_bytes(row.spend.index);
+        serial.write_4_bytes(static_cast<uint32_t>(row.spend_height));
+    }
+
+    auto& cached = entries_[address];
+    cached.height = std::max(cached.height, height);
+    cached.records.push_back(end_);
+    end_ = required;
+
+    // Commit the record by advancing the end recorded in the header.
+    auto header = make_serializer(file_->data() + 4 + 4);
+    header.write_8_bytes(end_);
+    return true;
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/latency_probe.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+const size_t latency_probe::maximum_lag = 1;
+
+latency_probe::latency_probe(const period_ms& timeout, size_t samples)
+  : timeout_(timeout), samples_(samples)
+{
+}
+
+std::vector<server_probe> latency_probe::probe(
+    const std::vector<std::string>& servers)
+{
+    std::vector<server_probe> probes;
+    for (const auto& server: servers)
+        probes.push_back({ server, {}, 0, 0, 0 });
+
+    // The zmq context is thread safe, each socket is used on one thread.
+    czmqpp::context context;
+    std::vector<std::thread> threads;
+    for (auto& probe: probes)
+        threads.emplace_back(&latency_probe::probe_server, this,
+            std::ref(context), std::ref(probe));
+
+    for (auto& thread: threads)
+        thread.join();
+
+    rank(probes);
+    return probes;
+}
+
+// Requests are sent one at a time so that each measures a round trip only.
+void latency_probe::probe_server(czmqpp::context& context,
+    server_probe& probe)
+{
+    typedef std::chrono::steady_clock clock;
+
+    obelisk_client client(context, timeout_);
+    if (client.connect(probe.server) < 0)
+    {
+        probe.failures = samples_;
+        return;
+    }
+
+    for (size_t sample = 0; sample < samples_; ++sample)
+    {
+        const auto start = clock::now();
+
+        auto on_done = [&probe, start](size_t height)
+        {
+            const auto latency = std::chrono::duration_cast<
+                std::chrono::microseconds>(clock::now() - start);
+            probe.latencies.record(latency.count());
+            probe.height = std::max(probe.height, height);
+        };
+
+        auto on_error = [&probe](const std::error_code&)
+        {
+            ++probe.failures;
+        };
+
+        client.get_codec()->fetch_last_height(on_error, on_done);
+        client.resolve_callbacks();
+    }
+}
+
+bool latency_probe::healthy(const server_probe& probe)
+{
+    return probe.failures == 0 && probe.latencies.count() != 0 &&
+        probe.lag <= maximum_lag;
+}
+
+void latency_probe::rank(std::vector<server_probe>& probes)
+{
+    size_t top = 0;
+    for (const auto& probe: probes)
+        top = std::max(top, probe.height);
+
+    // An unresponsive server lags by the full height.
+    for (auto& probe: probes)
+        probe.lag = top - probe.height;
+
+    const auto better = [](const server_probe& left,
+        const server_probe& right)
+    {
+        const auto left_healthy = healthy(left);
+        const auto right_healthy = healthy(right);
+        if (left_healthy != right_healthy)
+            return left_healthy;
+
+        // An unresponsive server has no median, so ranks last.
+        const auto left_count = left.latencies.count();
+        const auto right_count = right.latencies.count();
+        if (left_count == 0 || right_count == 0)
+            return left_count != 0 && right_count == 0;
+
+        return left.latencies.percentile(50) < right.latencies.percentile(50);
+    };
+
+    std::stable_sort(probes.begin(), probes.end(), better);
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/load_generator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/obelisk_client.hpp>
+#include <bitcoin/explorer/primitives/address.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
+
+using namespace bc::client;
+using namespace bc::explorer::primitives;
+
+namespace libbitcoin {
+namespace explorer {
+
+typedef std::chrono::steady_clock clock_type;
+
+// The calls target the genesis block, which every server can answer.
+static const char* genesis_address = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+
+// The longest wait for a reply before rechecking the schedule.
+static const period_ms poll_period(100);
+
+load_generator::load_generator(size_t concurrency, size_t rate)
+  : concurrency_(std::max(concurrency, size_t(1))), rate_(rate), call_(0),
+    address_(address(genesis_address)),
+    transaction_(hash_transaction(genesis_block().transactions.front()))
+{
+}
+
+load_report load_generator::run(obelisk_client& client,
+    const period_ms& duration)
+{
+    // Callbacks of calls abandoned on termination may outlive the run.
+    const auto state = std::make_shared<tally>();
+    auto& report = state->report;
+    report = { 0, concurrency_, rate_, 0, 0, 0, 0, 0, 0, {} };
+    state->outstanding = 0;
+
+    // The connection may be shared, so count retries and hedges by delta.
+    const auto stream = client.get_stream();
+    const auto retries = stream->retries();
+    const auto hedges = stream->hedges();
+
+    // Each call is to load the server, so identical calls are not coalesced.
+    const auto coalesce = client.get_coalesce_stream();
+    const auto coalescing = coalesce->enabled();
+    coalesce->set_enabled(false);
+
+    const auto interval = rate_ == 0 ? clock_type::duration::zero() :
+        clock_type::duration(std::chrono::seconds(1)) / rate_;
+
+    const auto start = clock_type::now();
+    const auto end = start + duration;
+    auto next = start;
+
+    while (true)
+    {
+        const auto now = clock_type::now();
+        const auto sending = now < end;
+        if (!sending && state->outstanding == 0)
+            break;
+
+        while (sending && state->outstanding < concurrency_ && next <= now)
+        {
+            issue(client, state);
+            next += interval;
+        }
+
+        // A saturated client does not accumulate a backlog of calls.
+        if (next <= now)
+            next = now + interval;
+
+        auto wait = poll_period;
+        if (sending && rate_ != 0 && state->outstanding < concurrency_)
+        {
+            const auto due = std::chrono::duration_cast<period_ms>(next - now);
+            wait = std::max(period_ms(1), std::min(wait, due));
+        }
+
+        if (!client.poll(wait))
+            break;
+    }
+
+    report.duration = std::chrono::duration_cast<period_ms>(
+        clock_type::now() - start).count();
+    report.retries = stream->retries() - retries;
+    report.hedges = stream->hedges() - hedges;
+    coalesce->set_enabled(coalescing);
+    return report;
+}
+
+void load_generator::issue(obelisk_client& client,
+    std::shared_ptr<tally> state)
+{
+    const auto sent = clock_type::now();
+    ++state->report.calls;
+    ++state->outstanding;
+
+    const auto complete = [state, sent]()
+    {
+        const auto latency = std::chrono::duration_cast<
+            std::chrono::microseconds>(clock_type::now() - sent);
+        state->report.latencies.record(latency.count());
+        ++state->report.completed;
+        --state->outstanding;
+    };
+
+    const auto on_error = [state](const std::error_code& code)
+    {
+        if (code == error::channel_timeout)
+            ++state->report.timeouts;
+        else
+            ++state->report.failures;
+
+        --state->outstanding;
+    };
+
+    const auto codec = client.get_codec();
+    switch (call_++ % 4)
+    {
+        case 0:
+            codec->fetch_last_height(on_error,
+                [complete](size_t) { complete(); });
+            break;
+        case 1:
+            codec->fetch_block_header(on_error,
+                [complete](const block_header_type&) { complete(); },
+                uint32_t(0));
+            break;
+        case 2:
+            codec->fetch_transaction(on_error,
+                [complete](const tx_type&) { complete(); }, transaction_);
+            break;
+        default:
+            codec->fetch_history(on_error,
+                [complete](const history_list&) { complete(); }, address_);
+            break;
+    }
+}
+
+double load_generator::throughput(const load_report& report)
+{
+    if (report.duration == 0)
+        return 0;
+
+    return report.completed * 1000.0 / report.duration;
+}
+
+} // namespace explorer
+} // namespace libbitcoin
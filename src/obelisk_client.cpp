@@ -20,22 +20,91 @@
 
 #include <bitcoin/explorer/obelisk_client.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
 #include <bitcoin/explorer/async_client.hpp>
+#include <bitcoin/explorer/coalesce_stream.hpp>
 #include <bitcoin/explorer/command.hpp>
+#include <bitcoin/explorer/hedge_stream.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
 
 using namespace bc::client;
 
 namespace libbitcoin {
 namespace explorer {
 
-obelisk_client::obelisk_client(czmqpp::context& context, 
-    const period_ms& timeout, uint8_t retries)
-  : socket_(context, ZMQ_DEALER)
+// Notifies the hedge stream of each reply before passing it to the codec,
+// followed by a copy for each call coalesced with the replied call. The
+// metrics of each are recorded on receipt and on completion by the codec.
+class reply_stream
+  : public message_stream
 {
-    stream_ = std::make_shared<socket_stream>(socket_);
+public:
+    reply_stream(hedge_stream& hedge, coalesce_stream& coalesce,
+        wire_metrics& metrics, message_stream& codec, size_t server)
+      : hedge_(hedge), coalesce_(coalesce), metrics_(metrics), codec_(codec),
+        server_(server)
+    {
+    }
+
+    virtual void write(const data_stack& data)
+    {
+        hedge_.reply(server_, data);
+        const auto copies = coalesce_.reply(data);
+        deliver(data);
+
+        for (const auto& copy: copies)
+            deliver(copy);
+    }
+
+private:
+    void deliver(const data_stack& data)
+    {
+        metrics_.received(data);
+        codec_.write(data);
+        metrics_.completed(data);
+    }
+
+    hedge_stream& hedge_;
+    coalesce_stream& coalesce_;
+    wire_metrics& metrics_;
+    message_stream& codec_;
+    const size_t server_;
+};
+
+// Abandon hedging a call once the codec has given up on it.
+static period_ms expiry(const period_ms& timeout, uint8_t retries)
+{
+    return period_ms(timeout.count() * (retries + 1));
+}
+
+// Zero indicates no wakeup, so combine the periods on that basis.
+static int next_wakeup(const period_ms& left, const period_ms& right)
+{
+    if (left.count() == 0)
+        return static_cast<int>(right.count());
+
+    if (right.count() == 0)
+        return static_cast<int>(left.count());
 
+    return static_cast<int>(std::min(left, right).count());
+}
+
+obelisk_client::obelisk_client(czmqpp::context& context, 
+    const period_ms& timeout, uint8_t retries, const period_ms& hedge)
+  : context_(context),
+    hedge_(std::make_shared<hedge_stream>(hedge, expiry(timeout, retries))),
+    coalesce_(std::make_shared<coalesce_stream>(hedge_,
+        expiry(timeout, retries))),
+    metrics_(std::make_shared<wire_metrics>(coalesce_,
+        expiry(timeout, retries)))
+{
     std::shared_ptr<message_stream> base_stream
-        = std::static_pointer_cast<message_stream>(stream_);
+        = std::static_pointer_cast<message_stream>(metrics_);
 
     codec_ = std::make_shared<obelisk_codec>(base_stream,
         obelisk_codec::on_update_nop, obelisk_codec::on_unknown_nop, timeout,
@@ -44,7 +113,19 @@ obelisk_client::obelisk_client(czmqpp::context& context,
 
 int obelisk_client::connect(const std::string& address)
 {
-    return socket_.connect(address);
+    const auto socket = std::make_shared<czmqpp::socket>(context_, ZMQ_DEALER);
+    const auto result = socket->connect(address);
+    if (result < 0)
+        return result;
+
+    const auto stream = std::make_shared<socket_stream>(*socket);
+    const auto server = hedge_->add(stream);
+    sockets_.push_back(socket);
+    streams_.push_back(stream);
+    replies_.push_back(std::make_shared<reply_stream>(*hedge_, *coalesce_,
+        *metrics_, *codec_, server));
+
+    return result;
 }
 
 std::shared_ptr<obelisk_codec> obelisk_client::get_codec()
@@ -52,52 +133,110 @@ std::shared_ptr<obelisk_codec> obelisk_client::get_codec()
     return codec_;
 }
 
-bool obelisk_client::resolve_callbacks()
+std::shared_ptr<hedge_stream> obelisk_client::get_stream()
+{
+    return hedge_;
+}
+
+std::shared_ptr<coalesce_stream> obelisk_client::get_coalesce_stream()
+{
+    return coalesce_;
+}
+
+std::shared_ptr<wire_metrics> obelisk_client::get_metrics()
+{
+    return metrics_;
+}
+
+// Once the codec has no call outstanding, any call still awaiting a reply
+// was abandoned, even if the calls never expire.
+void obelisk_client::forget_abandoned()
+{
+    if (codec_->outstanding_call_count() == 0)
+        coalesce_->clear();
+}
+
+void obelisk_client::receive(czmqpp::socket& ready)
 {
-    bool success = true;
+    for (size_t server = 0; server < sockets_.size(); ++server)
+    {
+        if (sockets_[server]->self() == ready.self())
+        {
+            streams_[server]->signal_response(replies_[server]);
+            return;
+        }
+    }
+}
 
-    auto delay = static_cast<int>(codec_->wakeup().count());
+// Wake only when a server socket is readable, a call deadline expires or a
+// call is due to be hedged. The codec wakeup signals the error callbacks of
+// expired calls and returns zero once no call remains outstanding.
+bool obelisk_client::resolve_callbacks()
+{
     czmqpp::poller poller;
-    poller.add(stream_->get_socket());
+    for (const auto& socket: sockets_)
+        poller.add(*socket);
+
+    auto delay = next_wakeup(codec_->wakeup(), hedge_->wakeup());
 
     while (delay > 0)
     {
-        poller.wait(delay);
+        auto ready = poller.wait(delay);
 
         if (poller.terminated())
-        {
-            success = false;
-            break;
-        }
+            return false;
 
         if (!poller.expired())
-        {
-            stream_->signal_response(codec_);
+            receive(ready);
 
-            if (codec_->outstanding_call_count() == 0)
-            {
-                delay = 0;
-            }
-        }
-        else
-        {
-            // recompute the delay and signal the appropriate error callbacks
-            // due to the timeout.
-            delay = static_cast<int>(codec_->wakeup().count());
-        }
+        // Return as soon as the last callback has fired.
+        if (codec_->outstanding_call_count() == 0)
+            break;
+
+        delay = next_wakeup(codec_->wakeup(), hedge_->wakeup());
     }
 
-    return success;
+    forget_abandoned();
+    return true;
+}
+
+bool obelisk_client::poll(const period_ms& period)
+{
+    czmqpp::poller poller;
+    for (const auto& socket: sockets_)
+        poller.add(*socket);
+
+    const period_ms due(next_wakeup(codec_->wakeup(), hedge_->wakeup()));
+    auto ready = poller.wait(next_wakeup(period, due));
+
+    if (poller.terminated())
+        return false;
+
+    if (!poller.expired())
+        receive(ready);
+
+    // Signal the error callbacks of calls that expired while waiting.
+    codec_->wakeup();
+    hedge_->wakeup();
+    forget_abandoned();
+    return true;
 }
 
 void obelisk_client::poll_until_termination(const period_ms& timeout)
+{
+    poll_until_termination(timeout, []{ return true; });
+}
+
+void obelisk_client::poll_until_termination(const period_ms& timeout,
+    const poll_handler& handler)
 {
     czmqpp::poller poller;
-    poller.add(stream_->get_socket());
+    for (const auto& socket: sockets_)
+        poller.add(*socket);
 
     while (true)
     {
-        poller.wait(static_cast<int>(timeout.count()));
+        auto ready = poller.wait(static_cast<int>(timeout.count()));
 
         if (poller.terminated())
         {
@@ -106,7 +245,12 @@ void obelisk_client::poll_until_termination(const period_ms& timeout)
 
         if (!poller.expired())
         {
-            stream_->signal_response(codec_);
+            receive(ready);
+        }
+
+        if (!handler())
+        {
+            break;
         }
     }
 }
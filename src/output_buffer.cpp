@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/output_buffer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+
+// Output is gathered in a chunk of this size before it is held.
+static const size_t chunk_size = 4096;
+
+output_buffer::output_buffer(std::ostream& sink, const flush_policy& policy)
+  : sink_(sink), policy_(policy), chunk_(chunk_size), written_(clock::now())
+{
+    setp(chunk_.data(), chunk_.data() + chunk_.size());
+}
+
+output_buffer::~output_buffer()
+{
+    write_through();
+}
+
+void output_buffer::write_through()
+{
+    hold();
+    if (!held_.empty())
+        sink_.write(held_.data(), held_.size());
+
+    sink_.flush();
+    held_.clear();
+    written_ = clock::now();
+}
+
+void output_buffer::write_due()
+{
+    hold();
+    if (!held_.empty() && due())
+        write_through();
+}
+
+size_t output_buffer::held() const
+{
+    return held_.size() + (pptr() - pbase());
+}
+
+// Unbuffered output is written through as each chunk fills, as the stream
+// would write it.
+output_buffer::int_type output_buffer::overflow(int_type character)
+{
+    hold();
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+        held_.push_back(traits_type::to_char_type(character));
+
+    if (!buffered() || (policy_.size != 0 && held_.size() >= policy_.size))
+        write_through();
+
+    return traits_type::not_eof(character);
+}
+
+int output_buffer::sync()
+{
+    if (due())
+        write_through();
+    else
+        hold();
+
+    return sink_.good() ? 0 : -1;
+}
+
+bool output_buffer::buffered() const
+{
+    return policy_.size != 0 || policy_.interval.count() != 0;
+}
+
+bool output_buffer::due() const
+{
+    if (!buffered())
+        return true;
+
+    if (policy_.size != 0 && held() >= policy_.size)
+        return true;
+
+    return policy_.interval.count() != 0 &&
+        clock::now() - written_ >= policy_.interval;
+}
+
+// Move the output written so far from the chunk to the held output.
+void output_buffer::hold()
+{
+    held_.append(pbase(), pptr());
+    setp(chunk_.data(), chunk_.data() + chunk_.size());
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -32,8 +32,12 @@ namespace explorer {
 namespace primitives {
 
 // DRY
+static const char* encoding_binary = "binary";
+static const char* encoding_csv = "csv";
 static const char* encoding_info = "info";
 static const char* encoding_json = "json";
+static const char* encoding_ndjson = "ndjson";
+static const char* encoding_tsv = "tsv";
 static const char* encoding_xml = "xml";
 
 encoding::encoding()
@@ -66,10 +70,18 @@ std::istream& operator>>(std::istream& input, encoding& argument)
     std::string text;
     input >> text;
 
-    if (text == encoding_info)
+    if (text == encoding_binary)
+        argument.value_ = encoding_engine::binary;
+    else if (text == encoding_csv)
+        argument.value_ = encoding_engine::csv;
+    else if (text == encoding_info)
         argument.value_ = encoding_engine::info;
     else if (text == encoding_json)
         argument.value_ = encoding_engine::json;
+    else if (text == encoding_ndjson)
+        argument.value_ = encoding_engine::ndjson;
+    else if (text == encoding_tsv)
+        argument.value_ = encoding_engine::tsv;
     else if (text == encoding_xml)
         argument.value_ = encoding_engine::xml;
     else
@@ -84,12 +96,24 @@ std::ostream& operator<<(std::ostream& output, const encoding& argument)
 
     switch (argument.value_)
     {
+        case encoding_engine::binary:
+            value = encoding_binary;
+            break;
+        case encoding_engine::csv:
+            value = encoding_csv;
+            break;
         case encoding_engine::info:
             value = encoding_info;
             break;
         case encoding_engine::json:
             value = encoding_json;
             break;
+        case encoding_engine::ndjson:
+            value = encoding_ndjson;
+            break;
+        case encoding_engine::tsv:
+            value = encoding_tsv;
+            break;
         case encoding_engine::xml:
             value = encoding_xml;
             break;
@@ -97,6 +121,7 @@ std::ostream& operator<<(std::ostream& output, const encoding& argument)
             BITCOIN_ASSERT_MSG(false, "Unexpected encoding value.");
     }
 
+    output << value;
     return output;
 }
 
@@ -20,11 +20,14 @@
 
 #include <bitcoin/explorer/prop_tree.hpp>
 
+#include <map>
 #include <string>
 #include <vector>
 #include <boost/property_tree/ptree.hpp>
 #include <bitcoin/client.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/latency_probe.hpp>
+#include <bitcoin/explorer/load_generator.hpp>
 #include <bitcoin/explorer/primitives/address.hpp>
 #include <bitcoin/explorer/primitives/base2.hpp>
 #include <bitcoin/explorer/primitives/btc256.hpp>
@@ -36,6 +39,9 @@
 #include <bitcoin/explorer/primitives/script.hpp>
 #include <bitcoin/explorer/primitives/transaction.hpp>
 #include <bitcoin/explorer/primitives/wrapper.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+#include <bitcoin/explorer/wire_metrics.hpp>
 
 using namespace pt;
 using namespace bc::client;
@@ -123,34 +129,77 @@ ptree prop_tree(const std::vector<history_row>& rows)
     tree.add_child("transfers", prop_tree_list("transfer", rows));
     return tree;
 }
+ptree prop_tree(const std::vector<history_row>& rows,
+    const payment_address& history_address)
+{
+    ptree list;
+    list.put("address", address(history_address));
+    for (const auto& row: rows)
+        list.add_child("transfer", prop_list(row));
 
-// balance
+    ptree tree;
+    tree.add_child("transfers", list);
+    return tree;
+}
 
-ptree prop_list(const std::vector<balance_row>& rows,
-    const payment_address& balance_address)
+ptree prop_list(const history_row& row,
+    const std::map<hash_digest, tx_type>& transactions)
 {
-    ptree tree;
-    uint64_t total_recieved = 0;
-    uint64_t confirmed_balance = 0;
-    uint64_t unspent_balance = 0;
+    auto tree = prop_list(row);
 
-    for (const auto& row: rows)
+    const auto received = transactions.find(row.output.hash);
+    if (received != transactions.end())
+        tree.add_child("received.transaction",
+            prop_list(transaction(received->second)));
+
+    if (row.spend.hash != null_hash)
     {
-        total_recieved += row.value;
+        const auto spent = transactions.find(row.spend.hash);
+        if (spent != transactions.end())
+            tree.add_child("spent.transaction",
+                prop_list(transaction(spent->second)));
+    }
 
-        // spend unconfirmed (or no spend attempted)
-        if (row.spend.hash == null_hash)
-            unspent_balance += row.value;
+    return tree;
+}
+ptree prop_tree(const std::vector<history_row>& rows,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    ptree list;
+    for (const auto& row: rows)
+        list.add_child("transfer", prop_list(row, transactions));
 
-        if (row.output_height != 0 &&
-            (row.spend.hash == null_hash || row.spend_height == 0))
-            confirmed_balance += row.value;
-    }
+    ptree tree;
+    tree.add_child("transfers", list);
+    return tree;
+}
+ptree prop_tree(const std::vector<history_row>& rows,
+    const payment_address& history_address,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    ptree list;
+    list.put("address", address(history_address));
+    for (const auto& row: rows)
+        list.add_child("transfer", prop_list(row, transactions));
+
+    ptree tree;
+    tree.add_child("transfers", list);
+    return tree;
+}
+
+// balance
 
+ptree prop_list(const std::vector<balance_row>& rows,
+    const payment_address& balance_address)
+{
+    balance_totals totals = { 0, 0, 0 };
+    accumulate_balance(totals, rows);
+
+    ptree tree;
     tree.put("address", address(balance_address));
-    tree.put("confirmed", confirmed_balance);
-    tree.put("received", total_recieved);
-    tree.put("unspent", unspent_balance);
+    tree.put("confirmed", totals.confirmed);
+    tree.put("received", totals.received);
+    tree.put("unspent", totals.unspent);
     return tree;
 }
 ptree prop_tree(const std::vector<balance_row>& rows,
@@ -161,6 +210,22 @@ ptree prop_tree(const std::vector<balance_row>& rows,
     return tree;
 }
 
+ptree prop_list(const balance_totals& totals, size_t addresses)
+{
+    ptree tree;
+    tree.put("addresses", addresses);
+    tree.put("confirmed", totals.confirmed);
+    tree.put("received", totals.received);
+    tree.put("unspent", totals.unspent);
+    return tree;
+}
+ptree prop_tree(const balance_totals& totals, size_t addresses)
+{
+    ptree tree;
+    tree.add_child("total", prop_list(totals, addresses));
+    return tree;
+}
+
 // inputs
 
 ptree prop_list(const tx_input_type& tx_input)
@@ -423,6 +488,61 @@ ptree prop_tree(const hash_digest& hash, size_t height, size_t index)
     return tree;
 }
 
+// load
+
+ptree prop_list(const load_report& report)
+{
+    ptree tree;
+    tree.put("duration", report.duration);
+    tree.put("concurrency", report.concurrency);
+    tree.put("rate", report.rate);
+    tree.put("calls", report.calls);
+    tree.put("completed", report.completed);
+    tree.put("failures", report.failures);
+    tree.put("timeouts", report.timeouts);
+    tree.put("retries", report.retries);
+    tree.put("hedges", report.hedges);
+    tree.put("throughput", load_generator::throughput(report));
+
+    // missing latency implies no completed call
+    if (report.latencies.count() != 0)
+        tree.add_child("latency", prop_list(report.latencies));
+
+    return tree;
+}
+
+ptree prop_tree(const load_report& report)
+{
+    ptree tree;
+    tree.add_child("load_test", prop_list(report));
+    return tree;
+}
+
+// servers
+
+ptree prop_list(const server_probe& probe)
+{
+    ptree tree;
+    tree.put("url", probe.server);
+    tree.put("healthy", bool_to_string(latency_probe::healthy(probe)));
+    tree.put("height", probe.height);
+    tree.put("lag", probe.lag);
+    tree.put("failures", probe.failures);
+
+    // missing latency implies no response
+    if (probe.latencies.count() != 0)
+        tree.add_child("latency", prop_list(probe.latencies));
+
+    return tree;
+}
+
+ptree prop_tree(const std::vector<server_probe>& probes)
+{
+    ptree tree;
+    tree.add_child("servers", prop_tree_list("server", probes));
+    return tree;
+}
+
 // settings
 
 ptree prop_tree(const settings_list& settings)
@@ -468,6 +588,212 @@ ptree prop_tree(const uri_parse_result& uri)
     return tree;
 }
 
+// wire
+
+ptree prop_list(const wire_histogram& histogram)
+{
+    ptree tree;
+    tree.put("count", histogram.count());
+    tree.put("minimum", histogram.minimum());
+    tree.put("mean", histogram.mean());
+    tree.put("median", histogram.percentile(50));
+    tree.put("percentile_90", histogram.percentile(90));
+    tree.put("percentile_99", histogram.percentile(99));
+    tree.put("maximum", histogram.maximum());
+    return tree;
+}
+
+ptree prop_list(const std::string& command, const call_metrics& metrics)
+{
+    ptree tree;
+    tree.put("command", command);
+    tree.put("calls", metrics.calls);
+    tree.put("replies", metrics.replies);
+    tree.put("retries", metrics.retries);
+    tree.put("timeouts", metrics.timeouts);
+    tree.put("sent_bytes", metrics.sent_bytes);
+    tree.put("received_bytes", metrics.received_bytes);
+
+    // missing latency implies no reply
+    if (metrics.first_byte.count() != 0)
+        tree.add_child("first_byte", prop_list(metrics.first_byte));
+
+    if (metrics.completion.count() != 0)
+        tree.add_child("completion", prop_list(metrics.completion));
+
+    return tree;
+}
+
+ptree prop_tree(const wire_report& report)
+{
+    ptree list;
+    for (const auto& command: report)
+        list.add_child("call", prop_list(command.first, command.second));
+
+    ptree tree;
+    tree.add_child("wire_metrics", list);
+    return tree;
+}
+
+// streamed
+
+// Edit with care - these must write the properties (and in the same order)
+// of the corresponding property tree overloads above.
+
+void prop_list(stream_writer& writer, const tx_input_type& tx_input)
+{
+    payment_address script_address;
+    if (extract(script_address, tx_input.script))
+        writer.put("address", address(script_address));
+
+    writer.open("previous_output");
+    writer.put("hash", base16(tx_input.previous_output.hash));
+    writer.put("index", tx_input.previous_output.index);
+    writer.close();
+    writer.put("script", script(tx_input.script).mnemonic());
+    writer.put("sequence", tx_input.sequence);
+}
+
+void prop_list(stream_writer& writer, const tx_output_type& tx_output)
+{
+    payment_address output_address;
+    if (extract(output_address, tx_output.script))
+        writer.put("address", address(output_address));
+
+    writer.put("script", script(tx_output.script).mnemonic());
+
+    stealth_info stealth;
+    if (extract_stealth_info(stealth, tx_output.script))
+    {
+        writer.open("stealth");
+        writer.put("bit_field", stealth.bitfield);
+        writer.put("ephemeral_public_key", ec_public(stealth.ephem_pubkey));
+        writer.close();
+    }
+
+    writer.put("value", tx_output.value);
+}
+
+void prop_list(stream_writer& writer, const transaction& transaction)
+{
+    const tx_type& tx = transaction;
+
+    writer.put("hash", base16(hash_transaction(tx)));
+    writer.open_list("inputs");
+    prop_tree_list(writer, "input", tx.inputs);
+    writer.close();
+    writer.put("lock_time", tx.locktime);
+    writer.open_list("outputs");
+    prop_tree_list(writer, "output", tx.outputs);
+    writer.close();
+    writer.put("version", tx.version);
+}
+
+void prop_tree(stream_writer& writer, const transaction& transaction)
+{
+    writer.open("transaction");
+    prop_list(writer, transaction);
+    writer.close();
+}
+
+// The transaction of a hash, if available, follows the other properties of
+// the received or spent point.
+static void prop_transaction(stream_writer& writer, const hash_digest& hash,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    const auto it = transactions.find(hash);
+    if (it == transactions.end())
+        return;
+
+    writer.open("transaction");
+    prop_list(writer, transaction(it->second));
+    writer.close();
+}
+
+void prop_list(stream_writer& writer, const history_row& row)
+{
+    static const std::map<hash_digest, tx_type> no_transactions;
+    prop_list(writer, row, no_transactions);
+}
+
+void prop_list(stream_writer& writer, const history_row& row,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    writer.open("received");
+    writer.put("hash", base16(row.output.hash));
+
+    // missing received.height implies pending
+    if (row.output_height != 0)
+        writer.put("height", row.output_height);
+
+    writer.put("index", row.output.index);
+    prop_transaction(writer, row.output.hash, transactions);
+    writer.close();
+
+    // missing input implies unspent
+    if (row.spend.hash != null_hash)
+    {
+        writer.open("spent");
+        writer.put("hash", base16(row.spend.hash));
+
+        // missing input.height implies spend unconfirmed
+        if (row.spend_height != 0)
+            writer.put("height", row.spend_height);
+
+        writer.put("index", row.spend.index);
+        prop_transaction(writer, row.spend.hash, transactions);
+        writer.close();
+    }
+
+    writer.put("value", row.value);
+}
+
+void prop_tree(stream_writer& writer, const std::vector<history_row>& rows)
+{
+    writer.open_list("transfers");
+    prop_tree_list(writer, "transfer", rows);
+    writer.close();
+}
+
+void prop_tree(stream_writer& writer, const std::vector<history_row>& rows,
+    const payment_address& history_address)
+{
+    writer.open_list("transfers");
+    writer.put("address", address(history_address));
+    prop_tree_list(writer, "transfer", rows);
+    writer.close();
+}
+
+void prop_tree(stream_writer& writer, const std::vector<history_row>& rows,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    writer.open_list("transfers");
+    for (const auto& row: rows)
+    {
+        writer.open("transfer");
+        prop_list(writer, row, transactions);
+        writer.close();
+    }
+
+    writer.close();
+}
+
+void prop_tree(stream_writer& writer, const std::vector<history_row>& rows,
+    const payment_address& history_address,
+    const std::map<hash_digest, tx_type>& transactions)
+{
+    writer.open_list("transfers");
+    writer.put("address", address(history_address));
+    for (const auto& row: rows)
+    {
+        writer.open("transfer");
+        prop_list(writer, row, transactions);
+        writer.close();
+    }
+
+    writer.close();
+}
+
 } // namespace primitives
 } // namespace explorer
 } // namespace libbitcoin
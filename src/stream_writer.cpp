@@ -0,0 +1,421 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/stream_writer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <boost/property_tree/ptree.hpp>
+#include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/primitives/encoding.hpp>
+
+using namespace pt;
+
+namespace libbitcoin {
+namespace explorer {
+
+// Edit with care - each encoding reproduces the corresponding property tree
+// writer (as configured by write_stream), including its escaping. The ndjson
+// encoding uses the escaping of json.
+
+static std::string escape_json(const std::string& text)
+{
+    static const char* digits = "0123456789ABCDEF";
+
+    std::string escaped;
+    for (const auto character: text)
+    {
+        const auto code = static_cast<uint8_t>(character);
+        if (code == 0x20 || code == 0x21 || (code >= 0x23 && code <= 0x2e) ||
+            (code >= 0x30 && code <= 0x5b) || code >= 0x5d)
+            escaped += character;
+        else if (character == '\b')
+            escaped += "\\b";
+        else if (character == '\f')
+            escaped += "\\f";
+        else if (character == '\n')
+            escaped += "\\n";
+        else if (character == '\r')
+            escaped += "\\r";
+        else if (character == '\t')
+            escaped += "\\t";
+        else if (character == '/')
+            escaped += "\\/";
+        else if (character == '"')
+            escaped += "\\\"";
+        else if (character == '\\')
+            escaped += "\\\\";
+        else
+        {
+            escaped += "\\u00";
+            escaped += digits[code / 16];
+            escaped += digits[code % 16];
+        }
+    }
+
+    return escaped;
+}
+
+static std::string escape_info(const std::string& text)
+{
+    std::string escaped;
+    for (const auto character: text)
+    {
+        switch (character)
+        {
+            case '\0': escaped += "\\0"; break;
+            case '\a': escaped += "\\a"; break;
+            case '\b': escaped += "\\b"; break;
+            case '\f': escaped += "\\f"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\v': escaped += "\\v"; break;
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            default: escaped += character; break;
+        }
+    }
+
+    return escaped;
+}
+
+// Info keys and values are quoted unless they are simple.
+static std::string quote_info(const std::string& text)
+{
+    const auto escaped = escape_info(text);
+    if (!escaped.empty() && escaped.find_first_of(" \t{};\n\"") ==
+        std::string::npos)
+        return escaped;
+
+    return "\"" + escaped + "\"";
+}
+
+static std::string escape_xml(const std::string& text)
+{
+    // Text of only spaces is encoded so that it survives a round trip.
+    if (!text.empty() && text.find_first_not_of(' ') == std::string::npos)
+        return "&#32;" + std::string(text.size() - 1, ' ');
+
+    std::string escaped;
+    for (const auto character: text)
+    {
+        switch (character)
+        {
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '&': escaped += "&amp;"; break;
+            case '"': escaped += "&quot;"; break;
+            case '\'': escaped += "&apos;"; break;
+            default: escaped += character; break;
+        }
+    }
+
+    return escaped;
+}
+
+stream_writer::stream_writer(std::ostream& output, encoding_engine engine)
+  : output_(output), engine_(engine)
+{
+    const element root = { "", true, true, false, false, "" };
+    elements_.push_back(root);
+
+    switch (engine_)
+    {
+        case encoding_engine::json:
+            output_ << "{";
+            break;
+        case encoding_engine::xml:
+            output_ << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+            break;
+        default:
+            break;
+    }
+}
+
+void stream_writer::open(const std::string& name)
+{
+    open_element(name, false);
+}
+
+void stream_writer::open_list(const std::string& name)
+{
+    open_element(name, true);
+}
+
+void stream_writer::close()
+{
+    // The root element is closed by finish.
+    if (elements_.size() < 2)
+        return;
+
+    if (engine_ == encoding_engine::ndjson)
+    {
+        close_row();
+        return;
+    }
+
+    const auto closing = elements_.back();
+    elements_.pop_back();
+
+    // An element without content is written as an empty value.
+    if (!closing.opened)
+    {
+        write_value(closing.name, "");
+        return;
+    }
+
+    const auto level = elements_.size();
+    switch (engine_)
+    {
+        case encoding_engine::json:
+            output_ << "\n";
+            indent(level);
+            output_ << "}";
+            break;
+        case encoding_engine::xml:
+            output_ << "</" << closing.name << ">";
+            break;
+        default:
+            indent(level - 1);
+            output_ << "}\n";
+            break;
+    }
+}
+
+void stream_writer::write(const std::string& name, const std::string& text)
+{
+    open_pending();
+    write_value(name, text);
+}
+
+// A list is a tree whose elements (children with children) share one name.
+// Its values, if any, describe all of its elements, as is the case when it is
+// named as the plural of its elements (e.g. an address of its transfers).
+static bool is_list(const std::string& name, const ptree& tree)
+{
+    const std::string* element = nullptr;
+    auto values = false;
+    for (const auto& child: tree)
+    {
+        if (child.second.empty())
+        {
+            values = true;
+            continue;
+        }
+
+        if (element != nullptr && child.first != *element)
+            return false;
+
+        element = &child.first;
+    }
+
+    return element != nullptr && (!values || name == *element + "s");
+}
+
+// A tree node with children is an element, otherwise it is a value.
+void stream_writer::write(const ptree& tree)
+{
+    for (const auto& child: tree)
+    {
+        if (child.second.empty())
+        {
+            write(child.first, child.second.data());
+            continue;
+        }
+
+        if (is_list(child.first, child.second))
+            open_list(child.first);
+        else
+            open(child.first);
+
+        write(child.second);
+        close();
+    }
+}
+
+void stream_writer::finish()
+{
+    if (elements_.empty())
+        return;
+
+    while (elements_.size() > 1)
+        close();
+
+    elements_.clear();
+    switch (engine_)
+    {
+        case encoding_engine::json:
+            output_ << "\n}" << std::endl;
+            break;
+        case encoding_engine::xml:
+            output_ << std::endl;
+            break;
+        default:
+            break;
+    }
+}
+
+// A row is an element of a list or a top level element that is not a list.
+bool stream_writer::is_row(size_t depth) const
+{
+    if (elements_[depth - 1].list)
+        return true;
+
+    return depth == 1 && !elements_[depth].list;
+}
+
+void stream_writer::open_element(const std::string& name, bool list)
+{
+    open_pending();
+    const element child = { name, false, true, list, false, "" };
+    elements_.push_back(child);
+}
+
+// The current element is opened on its first content, as a child of the
+// element below it (which is always open).
+void stream_writer::open_pending()
+{
+    auto& pending = elements_.back();
+    if (pending.opened)
+        return;
+
+    const auto level = elements_.size() - 1;
+    auto& parent = elements_[level - 1];
+    switch (engine_)
+    {
+        case encoding_engine::json:
+            output_ << (parent.empty ? "\n" : ",\n");
+            indent(level);
+            output_ << "\"" << escape_json(pending.name) << "\": {";
+            break;
+        case encoding_engine::ndjson:
+            // The members of ndjson elements are held until a row is written.
+            pending.opened = true;
+            return;
+        case encoding_engine::xml:
+            output_ << "<" << pending.name << ">";
+            break;
+        default:
+            indent(level - 1);
+            output_ << quote_info(pending.name) << "\n";
+            indent(level - 1);
+            output_ << "{\n";
+            break;
+    }
+
+    parent.empty = false;
+    pending.opened = true;
+}
+
+// An ndjson element is written as a member of its parent, or as a row if it
+// is a row. A row is written on its own line within each of the elements that
+// contain it, with the members that they hold so far, and flushed. An element
+// without content, including an empty list, is written as an empty value and
+// any other list is written only in its rows. A list with values but no rows
+// is written as a row of its values.
+void stream_writer::close_row()
+{
+    const auto depth = elements_.size() - 1;
+    const auto closing = elements_.back();
+    elements_.pop_back();
+
+    if (closing.list && closing.rows)
+        return;
+
+    const auto row = is_row(depth) || (closing.list && !closing.empty);
+
+    auto member = "\"" + escape_json(closing.name) + "\":" +
+        (closing.empty ? "\"\"" : "{" + closing.values + "}");
+
+    if (!row)
+    {
+        auto& parent = elements_.back();
+        parent.values += (parent.values.empty() ? "" : ",") + member;
+        parent.empty = false;
+        return;
+    }
+
+    // The root holds no members, as its values are rows of their own.
+    for (auto level = elements_.size() - 1; level > 0; --level)
+    {
+        auto& container = elements_[level];
+        member = "\"" + escape_json(container.name) + "\":{" +
+            container.values + (container.values.empty() ? "" : ",") +
+            member + "}";
+        container.empty = false;
+        container.rows = true;
+    }
+
+    elements_.front().rows = true;
+    output_ << "{" << member << "}" << std::endl;
+}
+
+void stream_writer::write_value(const std::string& name,
+    const std::string& text)
+{
+    auto& parent = elements_.back();
+    const auto level = elements_.size();
+    switch (engine_)
+    {
+        case encoding_engine::json:
+            output_ << (parent.empty ? "\n" : ",\n");
+            indent(level);
+            output_ << "\"" << escape_json(name) << "\": \"" <<
+                escape_json(text) << "\"";
+            break;
+        case encoding_engine::ndjson:
+        {
+            const auto pair = "\"" + escape_json(name) + "\":\"" +
+                escape_json(text) + "\"";
+
+            // A top level value is a row of its own.
+            if (level == 1)
+                output_ << "{" << pair << "}" << std::endl;
+            else
+                parent.values += (parent.values.empty() ? "" : ",") + pair;
+
+            break;
+        }
+        case encoding_engine::xml:
+            if (text.empty())
+                output_ << "<" << name << "/>";
+            else
+                output_ << "<" << name << ">" << escape_xml(text) << "</" <<
+                    name << ">";
+            break;
+        default:
+            indent(level - 1);
+            output_ << quote_info(name) << " " <<
+                (text.empty() ? "\"\"" : quote_info(text)) << "\n";
+            break;
+    }
+
+    parent.empty = false;
+}
+
+void stream_writer::indent(size_t level)
+{
+    output_ << std::string(4 * level, ' ');
+}
+
+} // namespace explorer
+} // namespace libbitcoin
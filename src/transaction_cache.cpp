@@ -0,0 +1,273 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/transaction_cache.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+namespace libbitcoin {
+namespace explorer {
+
+// The file begins with a magic, a format version and the end of the last
+// complete record, which is updated only after a record is fully written.
+static const uint32_t cache_magic = 0x63747862;
+static const uint32_t cache_version = 1;
+static const size_t header_size = 4 + 4 + 8;
+
+// A record is the transaction hash, the clock of its last use and the length
+// of its serialization, followed by the serialization.
+static const size_t record_header_size = hash_size + 8 + 4;
+static const size_t used_offset = hash_size;
+
+static bool create(const boost::filesystem::path& path)
+{
+    data_chunk header(header_size);
+    auto serial = make_serializer(header.begin());
+    serial.write_4_bytes(cache_magic);
+    serial.write_4_bytes(cache_version);
+    serial.write_8_bytes(header_size);
+
+    std::ofstream file(path.string(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    return file.good();
+}
+
+transaction_cache::transaction_cache(const boost::filesystem::path& path,
+    size_t capacity)
+  : capacity_(std::max(capacity, header_size)), lock_(lock_file(path)),
+    end_(0), clock_(0)
+{
+    if (!lock_)
+        return;
+
+    if (!boost::filesystem::exists(path) && !create(path))
+        return;
+
+    file_.reset(new mmfile(path.string()));
+    if (!load())
+    {
+        file_.reset();
+        entries_.clear();
+        recency_.clear();
+    }
+}
+
+bool transaction_cache::valid() const
+{
+    return file_ != nullptr;
+}
+
+size_t transaction_cache::count() const
+{
+    return entries_.size();
+}
+
+bool transaction_cache::contains(const hash_digest& hash) const
+{
+    return entries_.find(hash) != entries_.end();
+}
+
+bool transaction_cache::find(tx_type& tx, const hash_digest& hash)
+{
+    const auto it = entries_.find(hash);
+    if (it == entries_.end())
+        return false;
+
+    const auto begin = file_->data() + it->second.offset + record_header_size;
+    const data_chunk raw(begin, begin + it->second.length);
+    if (!deserialize_satoshi_item(tx, raw))
+        return false;
+
+    touch(hash, it->second);
+    return true;
+}
+
+bool transaction_cache::store(const tx_type& tx)
+{
+    if (!valid())
+        return false;
+
+    const auto hash = hash_transaction(tx);
+    const auto it = entries_.find(hash);
+    if (it != entries_.end())
+    {
+        touch(hash, it->second);
+        return true;
+    }
+
+    const auto raw = serialize_satoshi_item(tx);
+    const auto size = record_header_size + raw.size();
+    if (header_size + size > capacity_)
+        return false;
+
+    if (end_ + size > capacity_)
+        evict(size);
+
+    // Grow geometrically, up to the capacity, so that appends are amortized.
+    const auto required = end_ + size;
+    if (required > file_->size())
+    {
+        const auto grown = std::min(capacity_, file_->size() * 3 / 2);
+        if (!file_->resize(std::max(required, grown)))
+            return false;
+    }
+
+    const auto used = clock_++;
+    auto serial = make_serializer(file_->data() + end_);
+    serial.write_hash(hash);
+    serial.write_8_bytes(used);
+    serial.write_4_bytes(static_cast<uint32_t>(raw.size()));
+    serial.write_data(raw);
+
+    const entry cached = { end_, static_cast<uint32_t>(raw.size()), used };
+    entries_[hash] = cached;
+    recency_[used] = hash;
+    commit(required);
+    return true;
+}
+
+bool transaction_cache::load()
+{
+    if (file_->data() == nullptr || file_->size() < header_size)
+        return false;
+
+    const auto begin = file_->data();
+    auto header = make_deserializer(begin, begin + header_size);
+    if (header.read_4_bytes() != cache_magic ||
+        header.read_4_bytes() != cache_version)
+        return false;
+
+    end_ = static_cast<size_t>(header.read_8_bytes());
+    if (end_ < header_size || end_ > file_->size())
+        return false;
+
+    auto offset = header_size;
+    while (offset < end_)
+    {
+        if (end_ - offset < record_header_size)
+            return false;
+
+        auto record = make_deserializer(begin + offset, begin + end_);
+        const auto hash = record.read_hash();
+        const auto used = record.read_8_bytes();
+        const auto length = record.read_4_bytes();
+        if (end_ - offset - record_header_size < length)
+            return false;
+
+        // A hash recorded more than once keeps its most recent use, and its
+        // other records are dropped by the next compaction.
+        const auto it = entries_.find(hash);
+        if (it == entries_.end() || it->second.used < used)
+        {
+            if (it != entries_.end())
+                recency_.erase(it->second.used);
+
+            const entry cached = { offset, length, used };
+            entries_[hash] = cached;
+            recency_[used] = hash;
+        }
+
+        clock_ = std::max(clock_, used + 1);
+        offset += record_header_size + length;
+    }
+
+    return true;
+}
+
+// The clock of the last use is updated in place.
+void transaction_cache::touch(const hash_digest& hash, entry& cached)
+{
+    recency_.erase(cached.used);
+    cached.used = clock_++;
+    recency_[cached.used] = hash;
+
+    auto serial = make_serializer(file_->data() + cached.offset + used_offset);
+    serial.write_8_bytes(cached.used);
+}
+
+// Evict the least recently used until the record fits, then compact.
+void transaction_cache::evict(size_t required)
+{
+    auto live = header_size;
+    for (const auto& cached: entries_)
+        live += record_header_size + cached.second.length;
+
+    while (!recency_.empty() && live + required > capacity_)
+    {
+        const auto oldest = recency_.begin();
+        const auto it = entries_.find(oldest->second);
+        if (it != entries_.end() && it->second.used == oldest->first)
+        {
+            live -= record_header_size + it->second.length;
+            entries_.erase(it);
+        }
+
+        recency_.erase(oldest);
+    }
+
+    compact();
+}
+
+// Move the remaining records down over the evicted records, in file order.
+// The file is emptied for the duration, so an interruption loses the cache
+// rather than corrupting it.
+void transaction_cache::compact()
+{
+    commit(header_size);
+
+    std::map<size_t, entry*> ordered;
+    for (auto& cached: entries_)
+        ordered[cached.second.offset] = &cached.second;
+
+    auto end = header_size;
+    const auto begin = file_->data();
+    for (const auto& record: ordered)
+    {
+        const auto size = record_header_size + record.second->length;
+        if (record.first != end)
+            std::memmove(begin + end, begin + record.first, size);
+
+        record.second->offset = end;
+        end += size;
+    }
+
+    commit(end);
+}
+
+// Advance the end recorded in the header, which commits a record.
+void transaction_cache::commit(size_t end)
+{
+    end_ = end;
+    auto serial = make_serializer(file_->data() + 4 + 4);
+    serial.write_8_bytes(end_);
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -20,13 +20,69 @@
 
 #include <bitcoin/explorer/utility/config.hpp>
 
+#include <ctime>
+#include <cstdint>
+#include <fstream>
+#include <map>
 #include <string>
+#include <vector>
 #include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/throw_exception.hpp>
+#include <bitcoin/explorer/define.hpp>
 #include <bitcoin/explorer/utility/environment.hpp>
 
+using namespace po;
+using namespace boost::filesystem;
+
 namespace libbitcoin {
 namespace explorer {
 
+// The parse of a configuration settings file and the file state it reflects.
+struct config_snapshot
+{
+    std::time_t modified;
+    uintmax_t size;
+    std::vector<option> options;
+};
+
+// Not unit testable (without creating actual config files).
+parsed_options parse_config_snapshot(const path& config_path,
+    const options_description& definitions) throw(reading_file)
+{
+    static std::map<std::string, config_snapshot> snapshots;
+
+    // Snapshots are not retained for a file that cannot be stat'd.
+    boost::system::error_code code;
+    const auto modified = last_write_time(config_path, code);
+    const auto size = code ? 0 : file_size(config_path, code);
+    const auto key = config_path.generic_string();
+
+    if (!code)
+    {
+        const auto it = snapshots.find(key);
+        if (it != snapshots.end() && it->second.modified == modified &&
+            it->second.size == size)
+        {
+            parsed_options parsed(&definitions);
+            parsed.options = it->second.options;
+            return parsed;
+        }
+    }
+
+    std::ifstream file(key);
+    if (!file.good())
+        BOOST_THROW_EXCEPTION(reading_file(key.c_str()));
+
+    const auto parsed = parse_config_file(file, definitions);
+
+    if (!code)
+        snapshots[key] = { modified, size, parsed.options };
+
+    return parsed;
+}
+
 // This is disabled so that we can throw an error in the case where a
 // config file is explicitly specified but not otherwise. This ensures
 // that the user can easily confirm that the config file is in use.
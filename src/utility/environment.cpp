@@ -28,10 +28,32 @@
     #include <unistd.h>
 #endif
 #include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <bitcoin/explorer/define.hpp>
+
+using namespace po;
 
 namespace libbitcoin {
 namespace explorer {
 
+// Not unit testable (reliance on shared test process environment).
+parsed_options parse_environment_snapshot(
+    const options_description& definitions)
+{
+    // All commands share the environment definitions, so the first parse
+    // captures every variable, and is filtered for safety on reuse.
+    static const auto snapshot = parse_environment(definitions,
+        BX_ENVIRONMENT_VARIABLE_PREFIX).options;
+
+    parsed_options parsed(&definitions);
+    for (const auto& variable: snapshot)
+        if (definitions.find_nothrow(variable.string_key, false) != nullptr)
+            parsed.options.push_back(variable);
+
+    return parsed;
+}
+
 //std::string home_directory()
 //{
 //#ifdef _WIN32
@@ -19,8 +19,10 @@
  */
 #include <bitcoin/explorer/utility/utility.hpp>
 
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <signal.h>
 #include <cstdint>
@@ -31,12 +33,16 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/info_parser.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/explorer/define.hpp>
+#include <bitcoin/explorer/stream_writer.hpp>
 #include <bitcoin/explorer/utility/compat.hpp>
 
 using namespace boost::posix_time;
@@ -44,6 +50,23 @@ using namespace boost::posix_time;
 namespace libbitcoin {
 namespace explorer {
 
+void accumulate_balance(balance_totals& totals,
+    const std::vector<balance_row>& rows)
+{
+    for (const auto& row: rows)
+    {
+        totals.received += row.value;
+
+        // spend unconfirmed (or no spend attempted)
+        if (row.spend.hash == null_hash)
+            totals.unspent += row.value;
+
+        if (row.output_height != 0 &&
+            (row.spend.hash == null_hash || row.spend_height == 0))
+            totals.confirmed += row.value;
+    }
+}
+
 std::string bool_to_string(bool value)
 {
     // This is not considered localizable text.
@@ -61,12 +84,45 @@ bool is_base2(const std::string& text)
     return true;
 }
 
+bool is_tree_encoding(encoding_engine engine)
+{
+    return engine == encoding_engine::info ||
+        engine == encoding_engine::json ||
+        engine == encoding_engine::ndjson ||
+        engine == encoding_engine::xml;
+}
+
 std::string join(const std::vector<std::string>& words,
     const std::string& delimiter)
 {
     return boost::join(words, delimiter);
 }
 
+std::shared_ptr<boost::interprocess::file_lock> lock_file(
+    const boost::filesystem::path& path)
+{
+    const auto lock_path = path.string() + ".lock";
+
+    // A file lock requires that the file exist.
+    std::ofstream file(lock_path, std::ios::app);
+    if (!file.good())
+        return nullptr;
+
+    file.close();
+
+    try
+    {
+        const auto lock = std::make_shared<boost::interprocess::file_lock>(
+            lock_path.c_str());
+        lock->lock();
+        return lock;
+    }
+    catch (const boost::interprocess::interprocess_exception&)
+    {
+        return nullptr;
+    }
+}
+
 // The key may be invalid, caller must test for null secret.
 // Note that random fill of ec_secret could also generate an invalid key,
 // but that would be less easily tested than this result.
@@ -220,6 +276,14 @@ std::ostream& write_stream(std::ostream& output, const pt::ptree& tree,
         case encoding_engine::json:
             pt::write_json(output, tree);
             break;
+        case encoding_engine::ndjson:
+        {
+            // There is no property tree writer for ndjson.
+            stream_writer writer(output, engine);
+            writer.write(tree);
+            writer.finish();
+            break;
+        }
         case encoding_engine::xml:
             pt::write_xml(output, tree);
 
@@ -227,6 +291,13 @@ std::ostream& write_stream(std::ostream& output, const pt::ptree& tree,
             output << std::endl;
 
             break;
+        // There is no binary or delimited encoding of a tree. Commands that
+        // support these formats write their records or rows directly and
+        // other commands reject them, so only the trees of errors and
+        // metrics are written here, as info.
+        case encoding_engine::binary:
+        case encoding_engine::csv:
+        case encoding_engine::tsv:
         default:
             pt::write_info(output, tree);
             break;
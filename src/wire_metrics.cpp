@@ -0,0 +1,292 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bitcoin/explorer/wire_metrics.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+// Values below the sub-bucket count are recorded exactly, each larger power
+// of two is divided into that many buckets.
+static const size_t sub_bucket_bits = 4;
+static const size_t sub_buckets = 1 << sub_bucket_bits;
+static const size_t buckets = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+wire_histogram::wire_histogram()
+  : counts_(buckets, 0), count_(0), minimum_(0), maximum_(0), total_(0)
+{
+}
+
+size_t wire_histogram::bucket(uint64_t value)
+{
+    if (value < sub_buckets)
+        return static_cast<size_t>(value);
+
+    size_t magnitude = 0;
+    while ((value >> magnitude) > 1)
+        ++magnitude;
+
+    const auto shift = magnitude - sub_bucket_bits;
+    const auto sub_bucket = static_cast<size_t>(value >> shift) % sub_buckets;
+    return (shift + 1) * sub_buckets + sub_bucket;
+}
+
+uint64_t wire_histogram::upper_bound(size_t bucket)
+{
+    if (bucket < sub_buckets)
+        return bucket;
+
+    const auto shift = bucket / sub_buckets - 1;
+    const uint64_t lower = uint64_t(sub_buckets + bucket % sub_buckets) <<
+        shift;
+
+    return lower + (uint64_t(1) << shift) - 1;
+}
+
+void wire_histogram::record(uint64_t value)
+{
+    ++counts_[bucket(value)];
+    minimum_ = count_ == 0 ? value : std::min(minimum_, value);
+    maximum_ = std::max(maximum_, value);
+    total_ += value;
+    ++count_;
+}
+
+void wire_histogram::merge(const wire_histogram& other)
+{
+    if (other.count_ == 0)
+        return;
+
+    for (size_t index = 0; index < buckets; ++index)
+        counts_[index] += other.counts_[index];
+
+    minimum_ = count_ == 0 ? other.minimum_ :
+        std::min(minimum_, other.minimum_);
+    maximum_ = std::max(maximum_, other.maximum_);
+    total_ += other.total_;
+    count_ += other.count_;
+}
+
+size_t wire_histogram::count() const
+{
+    return count_;
+}
+
+uint64_t wire_histogram::minimum() const
+{
+    return minimum_;
+}
+
+uint64_t wire_histogram::maximum() const
+{
+    return maximum_;
+}
+
+uint64_t wire_histogram::mean() const
+{
+    return count_ == 0 ? 0 : total_ / count_;
+}
+
+uint64_t wire_histogram::percentile(size_t percentile) const
+{
+    if (count_ == 0)
+        return 0;
+
+    // The rank of the value, counting from one.
+    const auto rank = std::max(size_t(1),
+        (std::min(percentile, size_t(100)) * count_ + 99) / 100);
+
+    size_t seen = 0;
+    for (size_t index = 0; index < buckets; ++index)
+    {
+        seen += static_cast<size_t>(counts_[index]);
+        if (seen >= rank)
+            return std::min(upper_bound(index), maximum_);
+    }
+
+    return maximum_;
+}
+
+// The metrics of a command, created empty on first use.
+static call_metrics& metrics_of(wire_report& report,
+    const std::string& command)
+{
+    auto it = report.find(command);
+    if (it == report.end())
+    {
+        const call_metrics empty = { 0, 0, 0, 0, 0, 0, wire_histogram(),
+            wire_histogram() };
+        it = report.insert(std::make_pair(command, empty)).first;
+    }
+
+    return it->second;
+}
+
+// The total size of the frames of a message.
+static uint64_t size_of(const data_stack& data)
+{
+    uint64_t size = 0;
+    for (const auto& frame: data)
+        size += frame.size();
+
+    return size;
+}
+
+// The id is the second frame of an obelisk message.
+static bool parse_id(data_chunk& id, const data_stack& data)
+{
+    if (data.size() < 2)
+        return false;
+
+    auto frame = data.begin();
+    id = *(++frame);
+    return true;
+}
+
+wire_metrics::wire_metrics(std::shared_ptr<message_stream> next,
+    const period_ms& expiry)
+  : next_(next), expiry_(expiry)
+{
+}
+
+void wire_metrics::write(const data_stack& data)
+{
+    data_chunk id;
+    if (parse_id(id, data))
+    {
+        const std::string command(data.front().begin(), data.front().end());
+        auto& metrics = metrics_of(report_, command);
+        metrics.sent_bytes += size_of(data);
+
+        // A retry is measured from the original send.
+        const auto it = calls_.find(id);
+        if (it == calls_.end())
+        {
+            const call entry = { command, clock::now(), clock::time_point() };
+            calls_[id] = entry;
+            ++metrics.calls;
+        }
+        else
+        {
+            ++metrics.retries;
+        }
+    }
+
+    next_->write(data);
+}
+
+void wire_metrics::received(const data_stack& data)
+{
+    data_chunk id;
+    if (!parse_id(id, data))
+        return;
+
+    const auto it = calls_.find(id);
+    if (it == calls_.end())
+        return;
+
+    auto& entry = it->second;
+    entry.received = clock::now();
+
+    auto& metrics = metrics_of(report_, entry.command);
+    metrics.received_bytes += size_of(data);
+    metrics.first_byte.record(microseconds(entry.received - entry.sent));
+}
+
+void wire_metrics::completed(const data_stack& data)
+{
+    data_chunk id;
+    if (!parse_id(id, data))
+        return;
+
+    const auto it = calls_.find(id);
+    if (it == calls_.end())
+        return;
+
+    auto& metrics = metrics_of(report_, it->second.command);
+    metrics.completion.record(microseconds(clock::now() - it->second.sent));
+    ++metrics.replies;
+    calls_.erase(it);
+}
+
+wire_report wire_metrics::report()
+{
+    if (expiry_.count() == 0)
+        return report_;
+
+    const auto now = clock::now();
+    for (auto it = calls_.begin(); it != calls_.end();)
+    {
+        if (now - it->second.sent < expiry_)
+        {
+            ++it;
+            continue;
+        }
+
+        ++metrics_of(report_, it->second.command).timeouts;
+        it = calls_.erase(it);
+    }
+
+    return report_;
+}
+
+void wire_metrics::reset()
+{
+    report_.clear();
+}
+
+void wire_metrics::merge(wire_report& to, const wire_report& from)
+{
+    for (const auto& command: from)
+    {
+        auto& metrics = metrics_of(to, command.first);
+        const auto& other = command.second;
+        metrics.calls += other.calls;
+        metrics.replies += other.replies;
+        metrics.retries += other.retries;
+        metrics.timeouts += other.timeouts;
+        metrics.sent_bytes += other.sent_bytes;
+        metrics.received_bytes += other.received_bytes;
+        metrics.first_byte.merge(other.first_byte);
+        metrics.completion.merge(other.completion);
+    }
+}
+
+uint64_t wire_metrics::microseconds(const clock::duration& duration)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<
+        std::chrono::microseconds>(duration).count());
+}
+
+} // namespace explorer
+} // namespace libbitcoin
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+#define BX_BINARY_ADDRESS "1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL"
+
+static history_row make_row()
+{
+    history_row row;
+    row.output.hash = hash_transaction(genesis_block().transactions.front());
+    row.output.index = 1;
+    row.output_height = 247683;
+    row.spend.hash = null_hash;
+    row.spend.index = max_uint32;
+    row.spend_height = 0;
+    row.value = 90000;
+    return row;
+}
+
+BOOST_AUTO_TEST_SUITE(binary_writer__binary_record)
+
+BOOST_AUTO_TEST_CASE(binary_writer__binary_record__history_row__transfer_fields)
+{
+    const auto row = make_row();
+    const auto record = binary_record(row);
+
+    auto data = record.data();
+    uint8_t type;
+    const uint8_t* payload;
+    uint32_t size;
+    BOOST_REQUIRE(binary::read_record(data, record.data() + record.size(),
+        type, payload, size));
+    BOOST_REQUIRE_EQUAL(type, binary::transfer);
+    BOOST_REQUIRE(data == record.data() + record.size());
+
+    binary::transfer_record transfer;
+    BOOST_REQUIRE(binary::read_payload(transfer, payload, size));
+    BOOST_REQUIRE_EQUAL(transfer.received_index, 1u);
+    BOOST_REQUIRE_EQUAL(transfer.received_height, 247683u);
+    BOOST_REQUIRE_EQUAL(transfer.spent_index, max_uint32);
+    BOOST_REQUIRE_EQUAL(transfer.spent_height, 0u);
+    BOOST_REQUIRE_EQUAL(transfer.value, 90000u);
+
+    // Hashes are in wire order.
+    BOOST_REQUIRE(std::equal(row.output.hash.rbegin(), row.output.hash.rend(),
+        transfer.received_hash));
+}
+
+BOOST_AUTO_TEST_CASE(binary_writer__binary_record__header__satoshi_serialization)
+{
+    const auto header = genesis_block().header;
+    const auto record = binary_record(header);
+    const auto raw = serialize_satoshi_item(header);
+    BOOST_REQUIRE_EQUAL(raw.size(), sizeof(binary::header_record));
+    BOOST_REQUIRE_EQUAL(record.size(), binary::record_prefix_size + raw.size());
+    BOOST_REQUIRE(std::equal(raw.begin(), raw.end(),
+        record.begin() + binary::record_prefix_size));
+
+    binary::header_record fields;
+    BOOST_REQUIRE(binary::read_payload(fields,
+        record.data() + binary::record_prefix_size,
+        static_cast<uint32_t>(raw.size())));
+    BOOST_REQUIRE_EQUAL(fields.nonce, header.nonce);
+    BOOST_REQUIRE_EQUAL(fields.bits, header.bits);
+}
+
+BOOST_AUTO_TEST_CASE(binary_writer__binary_record__balance__totals_and_address)
+{
+    auto spent = make_row();
+    spent.spend.hash = spent.output.hash;
+    spent.spend.index = 0;
+    spent.spend_height = 247684;
+    const std::vector<balance_row> rows{ make_row(), spent };
+    const payment_address owner(BX_BINARY_ADDRESS);
+    const auto record = binary_record(rows, owner);
+
+    binary::balance_record balance;
+    BOOST_REQUIRE_EQUAL(record[0], binary::balance);
+    BOOST_REQUIRE(binary::read_payload(balance,
+        record.data() + binary::record_prefix_size,
+        static_cast<uint32_t>(record.size() - binary::record_prefix_size)));
+    BOOST_REQUIRE_EQUAL(balance.received, 180000u);
+    BOOST_REQUIRE_EQUAL(balance.address.version, owner.version());
+    BOOST_REQUIRE(std::equal(owner.hash().begin(), owner.hash().end(),
+        balance.address.hash));
+}
+
+BOOST_AUTO_TEST_CASE(binary_writer__binary_records__annotated_expanded__ordered)
+{
+    const auto tx = genesis_block().transactions.front();
+    const std::vector<history_row> rows{ make_row() };
+    std::map<hash_digest, tx_type> transactions;
+    transactions[hash_transaction(tx)] = tx;
+
+    const auto records = binary_records(rows,
+        payment_address(BX_BINARY_ADDRESS), transactions);
+
+    std::vector<uint8_t> types;
+    auto data = records.data();
+    const auto end = records.data() + records.size();
+    uint8_t type;
+    const uint8_t* payload;
+    uint32_t size;
+    while (binary::read_record(data, end, type, payload, size))
+        types.push_back(type);
+
+    BOOST_REQUIRE(data == end);
+    BOOST_REQUIRE_EQUAL(types.size(), 3u);
+    BOOST_REQUIRE_EQUAL(types[0], binary::address);
+    BOOST_REQUIRE_EQUAL(types[1], binary::transfer);
+    BOOST_REQUIRE_EQUAL(types[2], binary::transaction);
+    BOOST_REQUIRE_EQUAL(size, satoshi_raw_size(tx));
+}
+
+BOOST_AUTO_TEST_CASE(binary_writer__binary_record__stealth_row__key_size_checked)
+{
+    stealth_row row;
+    row.ephemkey = data_chunk(33, 0x02);
+    row.address = payment_address(BX_BINARY_ADDRESS);
+    row.transaction_hash = null_hash;
+
+    const auto record = binary_record(row);
+    BOOST_REQUIRE_EQUAL(record.size(),
+        binary::record_prefix_size + sizeof(binary::stealth_record));
+
+    binary::stealth_record stealth;
+    BOOST_REQUIRE(binary::read_payload(stealth,
+        record.data() + binary::record_prefix_size,
+        static_cast<uint32_t>(sizeof(binary::stealth_record))));
+    BOOST_REQUIRE(std::equal(row.ephemkey.begin(), row.ephemkey.end(),
+        stealth.ephemeral_public_key));
+
+    // A key of another size is neither padded nor truncated.
+    const std::vector<stealth_row> rows{ row, row };
+    row.ephemkey.pop_back();
+    BOOST_REQUIRE(binary_record(row).empty());
+    BOOST_REQUIRE(!binary_records(rows).empty());
+    BOOST_REQUIRE(binary_records({ rows.front(), row }).empty());
+}
+
+BOOST_AUTO_TEST_CASE(binary_writer__read_record__truncated__false)
+{
+    const auto record = binary_record(make_row());
+    auto data = record.data();
+    uint8_t type;
+    const uint8_t* payload;
+    uint32_t size;
+    BOOST_REQUIRE(!binary::read_record(data, record.data() + record.size() - 1,
+        type, payload, size));
+    BOOST_REQUIRE(data == record.data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
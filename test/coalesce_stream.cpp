@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+// Records the messages written to a server.
+class recorder
+  : public message_stream
+{
+public:
+    virtual void write(const data_stack& data)
+    {
+        messages.push_back(data);
+    }
+
+    std::vector<data_stack> messages;
+};
+
+// A call message: command, id and payload frames.
+static data_stack make_call(uint8_t id, uint8_t payload=0)
+{
+    return
+    {
+        { 'f', 'o', 'o' },
+        { id, 0x00, 0x00, 0x00 },
+        { payload }
+    };
+}
+
+// The id frame of a message.
+static data_chunk id_of(const data_stack& data)
+{
+    auto frame = data.begin();
+    return *(++frame);
+}
+
+BOOST_AUTO_TEST_SUITE(coalesce_stream__coalesce)
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__write__identical_calls__sent_once)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server);
+    coalesce.write(make_call(1));
+    coalesce.write(make_call(2));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__write__different_payloads__sent_each)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server);
+    coalesce.write(make_call(1, 1));
+    coalesce.write(make_call(2, 2));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__reply__waiting_call__copied_with_its_id)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server);
+    coalesce.write(make_call(1));
+    coalesce.write(make_call(2));
+    coalesce.write(make_call(3));
+
+    const auto copies = coalesce.reply(make_call(1, 42));
+    BOOST_REQUIRE_EQUAL(copies.size(), 2u);
+    BOOST_REQUIRE(id_of(copies[0]) == id_of(make_call(2)));
+    BOOST_REQUIRE(id_of(copies[1]) == id_of(make_call(3)));
+    BOOST_REQUIRE(copies[0].back() == data_chunk{ 42 });
+    BOOST_REQUIRE_EQUAL(coalesce.coalesced(), 2u);
+
+    // The call is complete, so an identical call is sent.
+    coalesce.write(make_call(4));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__write__disabled__sent_each)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server);
+    coalesce.set_enabled(false);
+    coalesce.write(make_call(1));
+    coalesce.write(make_call(2));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__reply__unknown_id__no_copies)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server);
+    BOOST_REQUIRE(coalesce.reply(make_call(1)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__write__resent_waiting_call__sent_alone)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server);
+    coalesce.write(make_call(1));
+    coalesce.write(make_call(2));
+    coalesce.write(make_call(2));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 2u);
+    BOOST_REQUIRE(coalesce.reply(make_call(1)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__write__expired_call__sent_again)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server, period_ms(1));
+    coalesce.write(make_call(1));
+    std::this_thread::sleep_for(period_ms(3));
+    coalesce.write(make_call(2));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 2u);
+}
+
+// The codec has given up on both calls, so a late reply has no copies.
+BOOST_AUTO_TEST_CASE(coalesce_stream__write__expired_calls__forgotten)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server, period_ms(1));
+    coalesce.write(make_call(1));
+    coalesce.write(make_call(2));
+    std::this_thread::sleep_for(period_ms(3));
+    coalesce.write(make_call(3, 3));
+    BOOST_REQUIRE(coalesce.reply(make_call(1)).empty());
+    BOOST_REQUIRE_EQUAL(coalesce.coalesced(), 0u);
+
+    // The forgotten waiting call is resent on its own.
+    coalesce.write(make_call(2));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_stream__clear__waiting_call__forgotten)
+{
+    const auto server = std::make_shared<recorder>();
+    coalesce_stream coalesce(server);
+    coalesce.write(make_call(1));
+    coalesce.write(make_call(2));
+    coalesce.clear();
+    BOOST_REQUIRE(coalesce.reply(make_call(1)).empty());
+
+    // An identical call is no longer in flight, so it is sent.
+    coalesce.write(make_call(3));
+    BOOST_REQUIRE_EQUAL(server->messages.size(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
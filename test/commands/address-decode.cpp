@@ -54,6 +54,8 @@ BOOST_AUTO_TEST_SUITE(address_decode__invoke)
     "<payload>b472a266d0bd89c13706a4132ccfb16f7c3b9fcb</payload>" \
     "<version>0</version>" \
 "</wrapper>\n"
+#define BX_ADDRESS_DECODE_BINARY_ERROR \
+"The 'binary' format is not supported by this command.\n"
 #define BX_ADDRESS_DECODE_V42_DEFAULT \
 "wrapper\n" \
 "{\n" \
@@ -90,6 +92,15 @@ BOOST_AUTO_TEST_CASE(address_decode__invoke__version_0_xml__okay_output)
     BX_REQUIRE_OUTPUT(BX_ADDRESS_DECODE_V0_XML);
 }
 
+BOOST_AUTO_TEST_CASE(address_decode__invoke__version_0_binary__failure_error)
+{
+    BX_DECLARE_COMMAND(address_decode);
+    command.set_format_option({ encoding_engine::binary });
+    command.set_bitcoin_address_argument({ BX_ADDRESS_DECODE_ADDRESS_V0 });
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR(BX_ADDRESS_DECODE_BINARY_ERROR);
+}
+
 BOOST_AUTO_TEST_CASE(address_decode__invoke__version_42_default__okay_output)
 {
     BX_DECLARE_COMMAND(address_decode);
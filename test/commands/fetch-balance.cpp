@@ -21,6 +21,8 @@
 #include "command.hpp"
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include "../mock/mock_server.hpp"
 
 BX_USING_NAMESPACES()
 
@@ -53,12 +55,20 @@ BOOST_AUTO_TEST_SUITE(fetch_balance__invoke)
 "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n" \
 "<balance><address>13Ft7SkreJY9D823NPm4t6D1cBqLYTJtAe</address><confirmed>90000</confirmed><received>90000</received><unspent>90000</unspent></balance>\n"
 
+#define BX_FETCH_BALANCE_SX_DEMO1_DEMO2_XML \
+"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n" \
+"<balances>" \
+"<balance><address>134HfD2fdeBTohfx8YANxEpsYXsv5UoWyz</address><confirmed>0</confirmed><received>100000</received><unspent>0</unspent></balance>" \
+"<balance><address>13Ft7SkreJY9D823NPm4t6D1cBqLYTJtAe</address><confirmed>90000</confirmed><received>90000</received><unspent>90000</unspent></balance>" \
+"<total><addresses>2</addresses><confirmed>90000</confirmed><received>190000</received><unspent>90000</unspent></total>" \
+"</balances>\n"
+
 // This test disabled because people are always sending change to Satoshi.
 //BOOST_AUTO_TEST_CASE(fetch_balance__invoke__mainnet_first_address_info__okay_output)
 //{
 //    BX_DECLARE_NETWORK_COMMAND(fetch_balance);
 //    command.set_format_option({ "info" });
-//    command.set_bitcoin_address_argument({ { BX_FIRST_ADDRESS } });
+//    command.set_bitcoin_addresses_argument({ { BX_FIRST_ADDRESS } });
 //    BX_REQUIRE_OKAY(command.invoke(output, error));
 //    BX_REQUIRE_OUTPUT(BX_FETCH_BALANCE_FIRST_ADDRESS_INFO);
 //}
@@ -67,7 +77,7 @@ BOOST_AUTO_TEST_CASE(fetch_balance__invoke__mainnet_sx_demo1_xml__okay_output)
 {
     BX_DECLARE_NETWORK_COMMAND(fetch_balance);
     command.set_format_option({ "xml" });
-    command.set_bitcoin_address_argument({ BX_FETCH_BALANCE_SX_DEMO1_ADDRESS });
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_BALANCE_SX_DEMO1_ADDRESS } });
     BX_REQUIRE_OKAY(command.invoke(output, error));
     BX_REQUIRE_OUTPUT(BX_FETCH_BALANCE_SX_DEMO1_XML);
 }
@@ -76,10 +86,72 @@ BOOST_AUTO_TEST_CASE(fetch_balance__invoke__mainnet_sx_demo2_xml__okay_output)
 {
     BX_DECLARE_NETWORK_COMMAND(fetch_balance);
     command.set_format_option({ "xml" });
-    command.set_bitcoin_address_argument({ BX_FETCH_BALANCE_SX_DEMO2_ADDRESS });
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_BALANCE_SX_DEMO2_ADDRESS } });
     BX_REQUIRE_OKAY(command.invoke(output, error));
     BX_REQUIRE_OUTPUT(BX_FETCH_BALANCE_SX_DEMO2_XML);
 }
 
+// A window of one preserves the order of the addresses in the output.
+BOOST_AUTO_TEST_CASE(fetch_balance__invoke__mainnet_sx_demo1_demo2_window_one_xml__okay_output)
+{
+    BX_DECLARE_NETWORK_COMMAND(fetch_balance);
+    command.set_format_option({ "xml" });
+    command.set_window_option(1);
+    command.set_bitcoin_addresses_argument(
+    {
+        { BX_FETCH_BALANCE_SX_DEMO1_ADDRESS },
+        { BX_FETCH_BALANCE_SX_DEMO2_ADDRESS }
+    });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BX_REQUIRE_OUTPUT(BX_FETCH_BALANCE_SX_DEMO1_DEMO2_XML);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(fetch_balance__invoke)
+
+#define BX_FETCH_BALANCE_JSON_SERVER "tcp://127.0.0.1:65103"
+
+// The balances and total of a set of addresses are one document.
+BOOST_AUTO_TEST_CASE(fetch_balance__invoke__json_two_addresses__one_document)
+{
+    history_row row;
+    row.output.hash = btc256(
+        "97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3");
+    row.output.index = 1;
+    row.output_height = 247683;
+    row.value = 90000;
+    row.spend.hash = null_hash;
+    row.spend.index = max_uint32;
+    row.spend_height = 0;
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.add_history(address(BX_FETCH_BALANCE_SX_DEMO1_ADDRESS), row);
+    server.add_history(address(BX_FETCH_BALANCE_SX_DEMO2_ADDRESS), row);
+    BOOST_REQUIRE(server.start(BX_FETCH_BALANCE_JSON_SERVER));
+
+    BX_DECLARE_COMMAND(fetch_balance);
+    command.set_general_wait_setting(BX_NETWORK_WAIT);
+    command.set_mainnet_url_setting({ BX_FETCH_BALANCE_JSON_SERVER });
+    command.set_format_option({ "json" });
+    command.set_bitcoin_addresses_argument(
+    {
+        { BX_FETCH_BALANCE_SX_DEMO1_ADDRESS },
+        { BX_FETCH_BALANCE_SX_DEMO2_ADDRESS }
+    });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+
+    // The parser rejects any text that follows the document.
+    pt::ptree tree;
+    BOOST_REQUIRE_NO_THROW(pt::read_json(output, tree));
+    BOOST_REQUIRE_EQUAL(tree.size(), 1u);
+    const auto& balances = tree.get_child("balances");
+    BOOST_REQUIRE_EQUAL(balances.count("balance"), 2u);
+    BOOST_REQUIRE_EQUAL(balances.get<size_t>("total.addresses"), 2u);
+    BOOST_REQUIRE_EQUAL(balances.get<uint64_t>("total.received"), 180000u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -18,6 +18,11 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include "../mock/mock_server.hpp"
 #include "command.hpp"
 
 BX_USING_NAMESPACES()
@@ -65,10 +70,49 @@ BOOST_AUTO_TEST_SUITE(fetch_history__invoke)
 "    }\n" \
 "}\n"
 
+#define BX_FETCH_HISTORY_SX_DEMO1_DEMO2_INFO \
+"histories\n" \
+"{\n" \
+"    transfers\n" \
+"    {\n" \
+"        address 134HfD2fdeBTohfx8YANxEpsYXsv5UoWyz\n" \
+"        transfer\n" \
+"        {\n" \
+"            received\n" \
+"            {\n" \
+"                hash 97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3\n" \
+"                height 247683\n" \
+"                index 1\n" \
+"            }\n" \
+"            spent\n" \
+"            {\n" \
+"                hash b7354b8b9cc9a856aedaa349cffa289ae9917771f4e06b2386636b3c073df1b5\n" \
+"                height 247742\n" \
+"                index 0\n" \
+"            }\n" \
+"            value 100000\n" \
+"        }\n" \
+"    }\n" \
+"    transfers\n" \
+"    {\n" \
+"        address 13Ft7SkreJY9D823NPm4t6D1cBqLYTJtAe\n" \
+"        transfer\n" \
+"        {\n" \
+"            received\n" \
+"            {\n" \
+"                hash b7354b8b9cc9a856aedaa349cffa289ae9917771f4e06b2386636b3c073df1b5\n" \
+"                height 247742\n" \
+"                index 0\n" \
+"            }\n" \
+"            value 90000\n" \
+"        }\n" \
+"    }\n" \
+"}\n"
+
 BOOST_AUTO_TEST_CASE(fetch_history__invoke__mainnet_sx_demo1_info__okay_output)
 {
     BX_DECLARE_NETWORK_COMMAND(bc::explorer::commands::fetch_history);
-    command.set_bitcoin_address_argument({ BX_FETCH_HISTORY_SX_DEMO1_ADDRESS });
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS } });
     BX_REQUIRE_OKAY(command.invoke(output, error));
     BX_REQUIRE_OUTPUT(BX_FETCH_HISTORY_SX_DEMO1_INFO);
 }
@@ -77,10 +121,270 @@ BOOST_AUTO_TEST_CASE(fetch_history__invoke__mainnet_sx_demo2_info__okay_output)
 {
     BX_DECLARE_NETWORK_COMMAND(bc::explorer::commands::fetch_history);
     command.set_format_option({ "info" });
-    command.set_bitcoin_address_argument({ BX_FETCH_HISTORY_SX_DEMO2_ADDRESS });
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO2_ADDRESS } });
     BX_REQUIRE_OKAY(command.invoke(output, error));
     BX_REQUIRE_OUTPUT(BX_FETCH_HISTORY_SX_DEMO2_INFO);
 }
 
+// A window of one preserves the order of the addresses in the output.
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__mainnet_sx_demo1_demo2_window_one__okay_output)
+{
+    BX_DECLARE_NETWORK_COMMAND(bc::explorer::commands::fetch_history);
+    command.set_window_option(1);
+    command.set_bitcoin_addresses_argument(
+    {
+        { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS },
+        { BX_FETCH_HISTORY_SX_DEMO2_ADDRESS }
+    });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BX_REQUIRE_OUTPUT(BX_FETCH_HISTORY_SX_DEMO1_DEMO2_INFO);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(fetch_history__invoke)
+
+#define BX_FETCH_HISTORY_CACHED_SERVER "tcp://127.0.0.1:65031"
+#define BX_FETCH_HISTORY_REFRESHED_SERVER "tcp://127.0.0.1:65032"
+#define BX_FETCH_HISTORY_EXPAND_SERVER "tcp://127.0.0.1:65033"
+#define BX_FETCH_HISTORY_BINARY_SERVER "tcp://127.0.0.1:65034"
+#define BX_FETCH_HISTORY_JSON_SERVER "tcp://127.0.0.1:65101"
+#define BX_FETCH_HISTORY_XML_SERVER "tcp://127.0.0.1:65102"
+
+static history_row demo_row(uint64_t value)
+{
+    history_row row;
+    row.output.hash = btc256(
+        "97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3");
+    row.output.index = 1;
+    row.output_height = 247683;
+    row.value = value;
+    row.spend.hash = null_hash;
+    row.spend.index = max_uint32;
+    row.spend_height = 0;
+    return row;
+}
+
+// The second server returns only the rows at or above the refresh height of
+// the cache, so the older row is that of the cache.
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__cached_sx_demo1__okay_output)
+{
+    const auto path = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+
+    auto spent = demo_row(100000);
+    spent.spend.hash = btc256(
+        "b7354b8b9cc9a856aedaa349cffa289ae9917771f4e06b2386636b3c073df1b5");
+    spent.spend.index = 0;
+    spent.spend_height = 247742;
+
+    auto recent = demo_row(90000);
+    recent.output.index = 2;
+    recent.output_height = 300000;
+
+    czmqpp::context context;
+    bc::explorer::mock_server cached(context);
+    cached.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS), spent);
+    cached.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS), recent);
+    BOOST_REQUIRE(cached.start(BX_FETCH_HISTORY_CACHED_SERVER));
+
+    {
+        BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_FETCH_HISTORY_CACHED_SERVER });
+        command.set_cache_history_setting(path);
+        command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS } });
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+    }
+
+    bc::explorer::mock_server refreshed(context);
+    refreshed.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS), recent);
+    BOOST_REQUIRE(refreshed.start(BX_FETCH_HISTORY_REFRESHED_SERVER));
+
+    {
+        BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_FETCH_HISTORY_REFRESHED_SERVER });
+        command.set_cache_history_setting(path);
+        command.set_format_option({ "json" });
+        command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS } });
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+
+        pt::ptree tree;
+        pt::read_json(output, tree);
+        size_t spends = 0;
+        const auto& transfers = tree.get_child("transfers");
+        BOOST_REQUIRE_EQUAL(transfers.count("transfer"), 2u);
+        for (const auto& transfer: transfers)
+            if (transfer.second.get<size_t>("spent.height", 0) == 247742)
+                ++spends;
+
+        BOOST_REQUIRE_EQUAL(spends, 1u);
+    }
+
+    boost::filesystem::remove(path);
+}
+
+// Both rows refer to one transaction, which is requested once.
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__expand_shared_hash__one_transaction_request)
+{
+    const auto coinbase = genesis_block().transactions.front();
+    const auto hash = hash_transaction(coinbase);
+
+    history_row row;
+    row.output.hash = hash;
+    row.output.index = 0;
+    row.output_height = 1;
+    row.value = 5000000000;
+    row.spend.hash = hash;
+    row.spend.index = 0;
+    row.spend_height = 1;
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS), row);
+    row.output.index = 1;
+    server.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS), row);
+    server.add_transaction(coinbase);
+    BOOST_REQUIRE(server.start(BX_FETCH_HISTORY_EXPAND_SERVER));
+
+    BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+    command.set_general_wait_setting(BX_NETWORK_WAIT);
+    command.set_mainnet_url_setting({ BX_FETCH_HISTORY_EXPAND_SERVER });
+    command.set_expand_option(true);
+    command.set_format_option({ "json" });
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS } });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BOOST_REQUIRE_EQUAL(server.requests(), 2u);
+
+    // Each transfer carries the transaction of its received and spent hash.
+    const auto text = output.str();
+    size_t transactions = 0;
+    for (auto at = text.find("\"transaction\""); at != std::string::npos;
+        at = text.find("\"transaction\"", at + 1))
+        ++transactions;
+
+    BOOST_REQUIRE_EQUAL(transactions, 4u);
+}
+
+// A single address is written as its transfer records only.
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__binary__transfer_record)
+{
+    history_row row;
+    row.output.hash = btc256(
+        "97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3");
+    row.output.index = 1;
+    row.output_height = 247683;
+    row.value = 90000;
+    row.spend.hash = null_hash;
+    row.spend.index = max_uint32;
+    row.spend_height = 0;
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS), row);
+    BOOST_REQUIRE(server.start(BX_FETCH_HISTORY_BINARY_SERVER));
+
+    BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+    command.set_general_wait_setting(BX_NETWORK_WAIT);
+    command.set_mainnet_url_setting({ BX_FETCH_HISTORY_BINARY_SERVER });
+    command.set_format_option({ "binary" });
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS } });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+
+    const auto record = binary_record(row);
+    BOOST_REQUIRE_EQUAL(output.str(), std::string(record.begin(),
+        record.end()));
+}
+
+// The histories of a set of addresses are one document.
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__json_two_addresses__one_document)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS),
+        demo_row(100000));
+    server.add_history(address(BX_FETCH_HISTORY_SX_DEMO2_ADDRESS),
+        demo_row(90000));
+    BOOST_REQUIRE(server.start(BX_FETCH_HISTORY_JSON_SERVER));
+
+    BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+    command.set_general_wait_setting(BX_NETWORK_WAIT);
+    command.set_mainnet_url_setting({ BX_FETCH_HISTORY_JSON_SERVER });
+    command.set_format_option({ "json" });
+    command.set_bitcoin_addresses_argument(
+    {
+        { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS },
+        { BX_FETCH_HISTORY_SX_DEMO2_ADDRESS }
+    });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+
+    // The parser rejects any text that follows the document.
+    pt::ptree tree;
+    BOOST_REQUIRE_NO_THROW(pt::read_json(output, tree));
+    BOOST_REQUIRE_EQUAL(tree.size(), 1u);
+    BOOST_REQUIRE_EQUAL(tree.get_child("histories").count("transfers"), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__xml_two_addresses__one_document)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.add_history(address(BX_FETCH_HISTORY_SX_DEMO1_ADDRESS),
+        demo_row(100000));
+    server.add_history(address(BX_FETCH_HISTORY_SX_DEMO2_ADDRESS),
+        demo_row(90000));
+    BOOST_REQUIRE(server.start(BX_FETCH_HISTORY_XML_SERVER));
+
+    BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+    command.set_general_wait_setting(BX_NETWORK_WAIT);
+    command.set_mainnet_url_setting({ BX_FETCH_HISTORY_XML_SERVER });
+    command.set_format_option({ "xml" });
+    command.set_bitcoin_addresses_argument(
+    {
+        { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS },
+        { BX_FETCH_HISTORY_SX_DEMO2_ADDRESS }
+    });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+
+    // A second prolog or root element would fail to parse.
+    const auto text = output.str();
+    BOOST_REQUIRE_EQUAL(text.find("<?xml"), text.rfind("<?xml"));
+    pt::ptree tree;
+    BOOST_REQUIRE_NO_THROW(pt::read_xml(output, tree));
+    BOOST_REQUIRE_EQUAL(tree.size(), 1u);
+    BOOST_REQUIRE_EQUAL(tree.get_child("histories").count("transfers"), 2u);
+}
+
+// A delimited table is flat, so the transfers cannot be expanded.
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__csv_expand__failure_error)
+{
+    BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+    command.set_expand_option(true);
+    command.set_format_option({ "csv" });
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS } });
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR("The expand option is not supported by the 'csv' format.\n");
+}
+
+BOOST_AUTO_TEST_CASE(fetch_history__invoke__foreign_cache_file__failure)
+{
+    const auto path = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+
+    std::ofstream file(path.string());
+    file << "not a history cache file";
+    file.close();
+
+    BX_DECLARE_COMMAND(bc::explorer::commands::fetch_history);
+    command.set_cache_history_setting(path);
+    command.set_bitcoin_addresses_argument({ { BX_FETCH_HISTORY_SX_DEMO1_ADDRESS } });
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR("Could not open the history cache: " + path.string() +
+        "\n");
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../mock/mock_server.hpp"
+#include "command.hpp"
+
+BX_USING_NAMESPACES()
+
+// A local stand-in server, so the client stack is exercised offline.
+#define BX_LOAD_TEST_MOCK_SERVER "tcp://127.0.0.1:65021"
+
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(load_test__invoke)
+
+BOOST_AUTO_TEST_CASE(load_test__invoke__bogus_server_url_argument__failure)
+{
+    BX_DECLARE_COMMAND(load_test);
+    command.set_server_url_argument("bogus");
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+}
+
+BOOST_AUTO_TEST_CASE(load_test__invoke__mock_server__okay)
+{
+    const auto genesis = genesis_block();
+    czmqpp::context context;
+    bc::explorer::mock_server server(context, period_ms(1), period_ms(1));
+    server.add_header(0, genesis.header);
+    server.add_transaction(genesis.transactions.front());
+    server.set_synthetic_history(10);
+    BOOST_REQUIRE(server.start(BX_LOAD_TEST_MOCK_SERVER));
+
+    BX_DECLARE_COMMAND(load_test);
+    command.set_general_retries_setting(BX_NETWORK_RETRY);
+    command.set_general_wait_setting(BX_NETWORK_WAIT);
+    command.set_concurrency_option(4);
+    command.set_rate_option(100);
+    command.set_duration_option(1);
+    command.set_format_option({ "json" });
+    command.set_server_url_argument(BX_LOAD_TEST_MOCK_SERVER);
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BOOST_REQUIRE(output.str().find("\"failures\": \"0\"") !=
+        std::string::npos);
+    BOOST_REQUIRE(output.str().find("\"timeouts\": \"0\"") !=
+        std::string::npos);
+    BOOST_REQUIRE(server.requests() > 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(network)
+BOOST_AUTO_TEST_SUITE(load_test__invoke)
+
+BOOST_AUTO_TEST_CASE(load_test__invoke__mainnet__okay)
+{
+    BX_DECLARE_NETWORK_COMMAND(load_test);
+    command.set_concurrency_option(2);
+    command.set_rate_option(4);
+    command.set_duration_option(1);
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
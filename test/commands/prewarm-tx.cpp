@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/filesystem.hpp>
+#include "../mock/mock_server.hpp"
+#include "command.hpp"
+
+BX_USING_NAMESPACES()
+
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(prewarm_tx__invoke)
+
+#define BX_PREWARM_TX_SERVER "tcp://127.0.0.1:65041"
+#define BX_PREWARM_TX_EMPTY_SERVER "tcp://127.0.0.1:65042"
+
+BOOST_AUTO_TEST_CASE(prewarm_tx__invoke__no_cache__failure_error)
+{
+    BX_DECLARE_COMMAND(prewarm_tx);
+    command.set_hashes_argument({ { BX_SATOSHIS_WORDS_TX_HASH } });
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR(BX_PREWARM_TX_NO_CACHE "\n");
+}
+
+// The second server has no transactions, so fetch-tx reads from the cache.
+BOOST_AUTO_TEST_CASE(prewarm_tx__invoke__mock_server__cached_for_fetch_tx)
+{
+    const auto path = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+
+    const auto coinbase = genesis_block().transactions.front();
+    const auto hash = hash_transaction(coinbase);
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.add_transaction(coinbase);
+    BOOST_REQUIRE(server.start(BX_PREWARM_TX_SERVER));
+
+    {
+        BX_DECLARE_COMMAND(prewarm_tx);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_PREWARM_TX_SERVER });
+        command.set_cache_transaction_setting(path);
+        command.set_cache_transaction_limit_setting(1);
+        command.set_hashes_argument({ { hash } });
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+        BX_REQUIRE_OUTPUT("Cached 1 of 1 transactions, 1 were fetched.\n");
+    }
+
+    bc::explorer::mock_server empty(context);
+    BOOST_REQUIRE(empty.start(BX_PREWARM_TX_EMPTY_SERVER));
+
+    {
+        BX_DECLARE_COMMAND(fetch_tx);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_PREWARM_TX_EMPTY_SERVER });
+        command.set_cache_transaction_setting(path);
+        command.set_cache_transaction_limit_setting(1);
+        command.set_hash_argument({ hash });
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+        BOOST_REQUIRE_EQUAL(empty.requests(), 0u);
+    }
+
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
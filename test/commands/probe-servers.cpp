@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command.hpp"
+
+BX_USING_NAMESPACES()
+
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(probe_servers__invoke)
+
+#define BX_PROBE_SERVERS_BOGUS_INFO \
+"servers\n" \
+"{\n" \
+"    server\n" \
+"    {\n" \
+"        url bogus\n" \
+"        healthy false\n" \
+"        height 0\n" \
+"        lag 0\n" \
+"        failures 2\n" \
+"    }\n" \
+"}\n"
+
+BOOST_AUTO_TEST_CASE(probe_servers__invoke__bogus_server__okay_unhealthy)
+{
+    BX_DECLARE_COMMAND(probe_servers);
+    command.set_samples_option(2);
+    command.set_server_urls_argument({ "bogus" });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BX_REQUIRE_OUTPUT(BX_PROBE_SERVERS_BOGUS_INFO);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(network)
+BOOST_AUTO_TEST_SUITE(probe_servers__invoke)
+
+BOOST_AUTO_TEST_CASE(probe_servers__invoke__mainnet__okay)
+{
+    BX_DECLARE_NETWORK_COMMAND(probe_servers);
+    command.set_samples_option(2);
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
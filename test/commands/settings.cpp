@@ -63,6 +63,9 @@ BOOST_AUTO_TEST_SUITE(settings__invoke)
 "    }\n" \
 "}\n"
 
+#define BX_SETTINGS_CSV_ERROR \
+"The 'csv' format is not supported by this command.\n"
+
 BOOST_AUTO_TEST_CASE(settings__invoke__empty__okay_output)
 {
     BX_DECLARE_COMMAND(settings);
@@ -82,5 +85,13 @@ BOOST_AUTO_TEST_CASE(settings__invoke__test_values__okay_output)
     BX_REQUIRE_OUTPUT(BX_SETTINGS_TEST_VALUES);
 }
 
+BOOST_AUTO_TEST_CASE(settings__invoke__csv__failure_error)
+{
+    BX_DECLARE_COMMAND(settings);
+    command.set_format_option({ encoding_engine::csv });
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR(BX_SETTINGS_CSV_ERROR);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
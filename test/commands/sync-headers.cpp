@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/filesystem.hpp>
+#include "../mock/mock_server.hpp"
+#include "command.hpp"
+
+BX_USING_NAMESPACES()
+
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(sync_headers__invoke)
+
+#define BX_SYNC_HEADERS_SERVER "tcp://127.0.0.1:65051"
+#define BX_SYNC_HEADERS_EMPTY_SERVER "tcp://127.0.0.1:65052"
+#define BX_SYNC_HEADERS_BROKEN_SERVER "tcp://127.0.0.1:65053"
+#define BX_SYNC_HEADERS_REORGANIZED_SERVER "tcp://127.0.0.1:65104"
+
+#define SYNC_HEADERS_SECOND_HASH \
+"00000000839a8e6886ab5951d76f411475428afc90947ee320161bbf18eb6048"
+
+static block_header_type second_header()
+{
+    block_header_type header;
+    header.version = 1;
+    header.previous_block_hash = hash_block_header(genesis_block().header);
+    header.merkle = decode_hash(
+        "0e3e2357e806b6cdb1f70b54c3a3a17b6714ee1f0e68bebb44a74b1efd512098");
+    header.timestamp = 1231469665;
+    header.bits = 486604799;
+    header.nonce = 2573394689;
+    return header;
+}
+
+static block_header_type third_header()
+{
+    block_header_type header;
+    header.version = 1;
+    header.previous_block_hash = hash_block_header(second_header());
+    header.merkle = decode_hash(
+        "9b0fc92260312ce44e74ef369f5c66bbb85848f2eddd5a7a1cde251e54ccfdd5");
+    header.timestamp = 1231469744;
+    header.bits = 486604799;
+    header.nonce = 1639830024;
+    return header;
+}
+
+static boost::filesystem::path temporary_path()
+{
+    return boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+}
+
+BOOST_AUTO_TEST_CASE(sync_headers__invoke__no_cache__failure_error)
+{
+    BX_DECLARE_COMMAND(sync_headers);
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR(BX_SYNC_HEADERS_NO_CACHE "\n");
+}
+
+// The second server has no headers, so fetch-header reads from the file.
+BOOST_AUTO_TEST_CASE(sync_headers__invoke__mock_server__stored_for_fetch_header)
+{
+    const auto path = temporary_path();
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.set_height(1);
+    server.add_header(0, genesis_block().header);
+    server.add_header(1, second_header());
+    BOOST_REQUIRE(server.start(BX_SYNC_HEADERS_SERVER));
+
+    {
+        BX_DECLARE_COMMAND(sync_headers);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_SYNC_HEADERS_SERVER });
+        command.set_cache_header_setting(path);
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+        BX_REQUIRE_OUTPUT("Synced 2 headers, 2 headers are stored.\n");
+    }
+
+    {
+        // Only the stored tip is requested again, to detect a reorganization.
+        BX_DECLARE_COMMAND(sync_headers);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_SYNC_HEADERS_SERVER });
+        command.set_cache_header_setting(path);
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+        BX_REQUIRE_OUTPUT("Synced 0 headers, 2 headers are stored.\n");
+    }
+
+    bc::explorer::mock_server empty(context);
+    BOOST_REQUIRE(empty.start(BX_SYNC_HEADERS_EMPTY_SERVER));
+
+    {
+        BX_DECLARE_COMMAND(fetch_header);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_SYNC_HEADERS_EMPTY_SERVER });
+        command.set_cache_header_setting(path);
+        command.set_hash_option({ SYNC_HEADERS_SECOND_HASH });
+        command.set_format_option({ "json" });
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+        BOOST_REQUIRE(output.str().find(SYNC_HEADERS_SECOND_HASH) !=
+            std::string::npos);
+        BOOST_REQUIRE_EQUAL(empty.requests(), 0u);
+    }
+
+    boost::filesystem::remove(path);
+}
+
+// The server's chain has replaced the stored tip at height one. A competing
+// header cannot be mined for the test, so the stale tip is stored directly.
+BOOST_AUTO_TEST_CASE(sync_headers__invoke__competing_tip__reorganized)
+{
+    const auto path = temporary_path();
+    auto stale = second_header();
+    stale.nonce = 0;
+
+    {
+        header_store store(path);
+        BOOST_REQUIRE(store.append({ genesis_block().header, stale }));
+    }
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.set_height(2);
+    server.add_header(0, genesis_block().header);
+    server.add_header(1, second_header());
+    server.add_header(2, third_header());
+    BOOST_REQUIRE(server.start(BX_SYNC_HEADERS_REORGANIZED_SERVER));
+
+    {
+        BX_DECLARE_COMMAND(sync_headers);
+        command.set_general_wait_setting(BX_NETWORK_WAIT);
+        command.set_mainnet_url_setting({ BX_SYNC_HEADERS_REORGANIZED_SERVER });
+        command.set_cache_header_setting(path);
+        BX_REQUIRE_OKAY(command.invoke(output, error));
+        BX_REQUIRE_OUTPUT(
+            "Removed 1 headers that are not in the server's chain.\n"
+            "Synced 2 headers, 3 headers are stored.\n");
+    }
+
+    header_store store(path);
+    block_header_type header;
+    BOOST_REQUIRE(store.read(header, 1));
+    BOOST_REQUIRE_EQUAL(encode_hash(hash_block_header(header)),
+        SYNC_HEADERS_SECOND_HASH);
+    BOOST_REQUIRE(store.top_hash() == hash_block_header(third_header()));
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(sync_headers__invoke__broken_linkage__failure_error)
+{
+    const auto path = temporary_path();
+    auto orphan = second_header();
+    orphan.previous_block_hash = null_hash;
+
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.set_height(1);
+    server.add_header(0, genesis_block().header);
+    server.add_header(1, orphan);
+    BOOST_REQUIRE(server.start(BX_SYNC_HEADERS_BROKEN_SERVER));
+
+    BX_DECLARE_COMMAND(sync_headers);
+    command.set_general_wait_setting(BX_NETWORK_WAIT);
+    command.set_mainnet_url_setting({ BX_SYNC_HEADERS_BROKEN_SERVER });
+    command.set_cache_header_setting(path);
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR("The header at height 1 failed verification.\n");
+    boost::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
@@ -58,6 +58,18 @@ BOOST_AUTO_TEST_SUITE(tx_decode__invoke)
 "    }\n" \
 "    version 1\n" \
 "}\n"
+#define TX_DECODE_TX_A_CSV \
+"transaction_hash,type,index,address,previous_output_hash,previous_output_index,sequence,value,script\n" \
+"39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0,input,0,,97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3,1,4294967295,,\n" \
+"39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0,output,0,13Ft7SkreJY9D823NPm4t6D1cBqLYTJtAe,,,,90000,dup hash160 [ 18c0bd8d1818f1bf99cb1df2269c645318ef7b73 ] equalverify checksig\n"
+#define TX_DECODE_TX_A_NDJSON \
+"{\"transaction\":{\"hash\":\"39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0\",\"inputs\":{\"input\":{\"previous_output\":{\"hash\":\"97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3\",\"index\":\"1\"},\"script\":\"\",\"sequence\":\"4294967295\"}}}}\n" \
+"{\"transaction\":{\"hash\":\"39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0\",\"lock_time\":\"0\",\"outputs\":{\"output\":{\"address\":\"13Ft7SkreJY9D823NPm4t6D1cBqLYTJtAe\",\"script\":\"dup hash160 [ 18c0bd8d1818f1bf99cb1df2269c645318ef7b73 ] equalverify checksig\",\"value\":\"90000\"}}}}\n" \
+"{\"transaction\":{\"hash\":\"39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0\",\"lock_time\":\"0\",\"version\":\"1\"}}\n"
+#define TX_DECODE_TX_A_TSV \
+"transaction_hash\ttype\tindex\taddress\tprevious_output_hash\tprevious_output_index\tsequence\tvalue\tscript\n" \
+"39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0\tinput\t0\t\t97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3\t1\t4294967295\t\t\n" \
+"39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0\toutput\t0\t13Ft7SkreJY9D823NPm4t6D1cBqLYTJtAe\t\t\t\t90000\tdup hash160 [ 18c0bd8d1818f1bf99cb1df2269c645318ef7b73 ] equalverify checksig\n"
 #define TX_DECODE_TX_A_XML \
 "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n" \
 "<transaction><hash>39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0</hash><inputs><input><previous_output><hash>97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3</hash><index>1</index></previous_output><script/><sequence>4294967295</sequence></input></inputs><lock_time>0</lock_time><outputs><output><address>13Ft7SkreJY9D823NPm4t6D1cBqLYTJtAe</address><script>dup hash160 [ 18c0bd8d1818f1bf99cb1df2269c645318ef7b73 ] equalverify checksig</script><value>90000</value></output></outputs><version>1</version></transaction>\n"
@@ -95,6 +107,9 @@ BOOST_AUTO_TEST_SUITE(tx_decode__invoke)
 "    version 1\n" \
 "}\n"
 
+#define TX_DECODE_BINARY_ERROR \
+"The 'binary' format is not supported by this command.\n"
+
 BOOST_AUTO_TEST_CASE(tx_decode__invoke__tx_A_info__okay_output)
 {
     BX_DECLARE_COMMAND(tx_decode);
@@ -114,6 +129,42 @@ BOOST_AUTO_TEST_CASE(tx_decode__invoke__tx_A_info__okay_output)
 //    BX_REQUIRE_OUTPUT(TX_DECODE_TX_A_JSON);
 //}
 
+BOOST_AUTO_TEST_CASE(tx_decode__invoke__tx_A_binary__failure_error)
+{
+    BX_DECLARE_COMMAND(tx_decode);
+    command.set_format_option({ "binary" });
+    command.set_transaction_argument({ TX_DECODE_TX_A_BASE16 });
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BX_REQUIRE_ERROR(TX_DECODE_BINARY_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE(tx_decode__invoke__tx_A_csv__okay_output)
+{
+    BX_DECLARE_COMMAND(tx_decode);
+    command.set_format_option({ "csv" });
+    command.set_transaction_argument({ TX_DECODE_TX_A_BASE16 });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BX_REQUIRE_OUTPUT(TX_DECODE_TX_A_CSV);
+}
+
+BOOST_AUTO_TEST_CASE(tx_decode__invoke__tx_A_ndjson__okay_output)
+{
+    BX_DECLARE_COMMAND(tx_decode);
+    command.set_format_option({ "ndjson" });
+    command.set_transaction_argument({ TX_DECODE_TX_A_BASE16 });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BX_REQUIRE_OUTPUT(TX_DECODE_TX_A_NDJSON);
+}
+
+BOOST_AUTO_TEST_CASE(tx_decode__invoke__tx_A_tsv__okay_output)
+{
+    BX_DECLARE_COMMAND(tx_decode);
+    command.set_format_option({ "tsv" });
+    command.set_transaction_argument({ TX_DECODE_TX_A_BASE16 });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BX_REQUIRE_OUTPUT(TX_DECODE_TX_A_TSV);
+}
+
 BOOST_AUTO_TEST_CASE(tx_decode__invoke__tx_A_xml__okay_output)
 {
     BX_DECLARE_COMMAND(tx_decode);
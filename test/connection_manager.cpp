@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc::client;
+using namespace bc::explorer;
+using namespace bc::explorer::commands;
+
+// Connection is asynchronous, so a server is not required to connect.
+#define BX_CONNECTION_MANAGER_SERVER "tcp://127.0.0.1:65001"
+#define BX_CONNECTION_MANAGER_OTHER_SERVER "tcp://127.0.0.1:65002"
+
+BOOST_AUTO_TEST_SUITE(connection_manager__connect)
+
+BOOST_AUTO_TEST_CASE(connection_manager__connect__bogus_server__null)
+{
+    connection_manager connections;
+    BOOST_REQUIRE(connections.connect("bogus", period_ms(0), 0) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__connect__server__not_null)
+{
+    connection_manager connections;
+    const auto client = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(0), 0);
+    BOOST_REQUIRE(client != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__connect__same_server__same_client)
+{
+    connection_manager connections;
+    const auto first = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(0), 0);
+    const auto second = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(0), 0);
+    BOOST_REQUIRE(first == second);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__connect__other_server__other_client)
+{
+    connection_manager connections;
+    const auto first = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(0), 0);
+    const auto second = connections.connect(
+        BX_CONNECTION_MANAGER_OTHER_SERVER, period_ms(0), 0);
+    BOOST_REQUIRE(first != second);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__connect__other_policy__other_client)
+{
+    connection_manager connections;
+    const auto first = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(0), 0);
+    const auto second = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(1000), 0);
+    BOOST_REQUIRE(first != second);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__connect__no_servers__null)
+{
+    connection_manager connections;
+    const std::vector<std::string> servers;
+    BOOST_REQUIRE(connections.connect(servers, period_ms(0), 0,
+        period_ms(0)) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__connect__hedged_servers__not_null)
+{
+    connection_manager connections;
+    const std::vector<std::string> servers
+    {
+        BX_CONNECTION_MANAGER_SERVER,
+        BX_CONNECTION_MANAGER_OTHER_SERVER
+    };
+
+    const auto client = connections.connect(servers, period_ms(0), 0,
+        period_ms(500));
+    BOOST_REQUIRE(client != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__disconnect__server__new_client)
+{
+    connection_manager connections;
+    const auto first = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(0), 0);
+    connections.disconnect();
+    const auto second = connections.connect(BX_CONNECTION_MANAGER_SERVER,
+        period_ms(0), 0);
+    BOOST_REQUIRE(first != second);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(connection_manager__servers)
+
+BOOST_AUTO_TEST_CASE(connection_manager__servers__configured__url_first)
+{
+    fetch_height command;
+    command.set_mainnet_url_setting({ BX_CONNECTION_MANAGER_SERVER });
+    command.set_mainnet_servers_setting({ { BX_CONNECTION_MANAGER_OTHER_SERVER } });
+    const auto servers = connection_manager::servers(command);
+    BOOST_REQUIRE_EQUAL(servers.size(), 2u);
+    BOOST_REQUIRE_EQUAL(servers[0], BX_CONNECTION_MANAGER_SERVER);
+    BOOST_REQUIRE_EQUAL(servers[1], BX_CONNECTION_MANAGER_OTHER_SERVER);
+}
+
+BOOST_AUTO_TEST_CASE(connection_manager__servers__ranking__ranked_first)
+{
+    const auto path = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+
+    std::ofstream file(path.string());
+    file << "tcp://unconfigured:1" << std::endl;
+    file << BX_CONNECTION_MANAGER_OTHER_SERVER << std::endl;
+    file.close();
+
+    fetch_height command;
+    command.set_general_ranking_setting(path);
+    command.set_mainnet_url_setting({ BX_CONNECTION_MANAGER_SERVER });
+    command.set_mainnet_servers_setting({ { BX_CONNECTION_MANAGER_OTHER_SERVER } });
+    const auto servers = connection_manager::servers(command);
+    boost::filesystem::remove(path);
+
+    BOOST_REQUIRE_EQUAL(servers.size(), 2u);
+    BOOST_REQUIRE_EQUAL(servers[0], BX_CONNECTION_MANAGER_OTHER_SERVER);
+    BOOST_REQUIRE_EQUAL(servers[1], BX_CONNECTION_MANAGER_SERVER);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+#define BX_DELIMITED_ADDRESS "1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL"
+#define BX_DELIMITED_HASH_A \
+    "97e06e49dfdd26c5a904670971ccf4c7fe7d9da53cb379bf9b442fc9427080b3"
+#define BX_DELIMITED_HASH_B \
+    "39d2caaf112f21364be00c5d0b14e3763468934e586e416bf74647a1906b18e0"
+
+static history_row make_row(const std::string& received, size_t height,
+    uint64_t value)
+{
+    history_row row;
+    row.output.hash = primitives::btc256(received);
+    row.output.index = 1;
+    row.output_height = height;
+    row.spend.hash = null_hash;
+    row.spend.index = max_uint32;
+    row.spend_height = 0;
+    row.value = value;
+    return row;
+}
+
+BOOST_AUTO_TEST_SUITE(delimited_writer__history)
+
+BOOST_AUTO_TEST_CASE(delimited_writer__history__csv__columns_and_rows)
+{
+    auto spent = make_row(BX_DELIMITED_HASH_A, 247683, 90000);
+    spent.spend.hash = primitives::btc256(BX_DELIMITED_HASH_B);
+    spent.spend.index = 0;
+    spent.spend_height = 247684;
+    const std::vector<history_row> rows
+    {
+        spent,
+        make_row(BX_DELIMITED_HASH_B, 0, 42)
+    };
+
+    std::stringstream output;
+    delimited_writer writer(output, encoding_engine::csv);
+    writer.history_columns();
+    writer.history(rows, payment_address(BX_DELIMITED_ADDRESS));
+
+    BOOST_REQUIRE_EQUAL(output.str(),
+        "address,received_hash,received_index,received_height,spent_hash,spent_index,spent_height,value\n"
+        BX_DELIMITED_ADDRESS "," BX_DELIMITED_HASH_A ",1,247683," BX_DELIMITED_HASH_B ",0,247684,90000\n"
+        BX_DELIMITED_ADDRESS "," BX_DELIMITED_HASH_B ",1,,,,,42\n");
+}
+
+BOOST_AUTO_TEST_CASE(delimited_writer__history__tsv__tab_separated)
+{
+    const std::vector<history_row> rows
+    {
+        make_row(BX_DELIMITED_HASH_A, 247683, 90000)
+    };
+
+    std::stringstream output;
+    delimited_writer writer(output, encoding_engine::tsv);
+    writer.history(rows, payment_address(BX_DELIMITED_ADDRESS));
+
+    BOOST_REQUIRE_EQUAL(output.str(),
+        BX_DELIMITED_ADDRESS "\t" BX_DELIMITED_HASH_A "\t1\t247683\t\t\t\t90000\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(delimited_writer__balance)
+
+BOOST_AUTO_TEST_CASE(delimited_writer__balance__csv__totals_row)
+{
+    auto spent = make_row(BX_DELIMITED_HASH_A, 247683, 90000);
+    spent.spend.hash = primitives::btc256(BX_DELIMITED_HASH_B);
+    spent.spend.index = 0;
+    spent.spend_height = 247684;
+    const std::vector<balance_row> rows
+    {
+        spent,
+        make_row(BX_DELIMITED_HASH_B, 247684, 42)
+    };
+
+    std::stringstream output;
+    delimited_writer writer(output, encoding_engine::csv);
+    writer.balance_columns();
+    writer.balance(rows, payment_address(BX_DELIMITED_ADDRESS));
+
+    BOOST_REQUIRE_EQUAL(output.str(),
+        "address,confirmed,received,unspent\n"
+        BX_DELIMITED_ADDRESS ",42,90042,42\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(delimited_writer__is_delimited)
+
+BOOST_AUTO_TEST_CASE(delimited_writer__is_delimited__engines__expected)
+{
+    BOOST_REQUIRE(is_delimited(encoding_engine::csv));
+    BOOST_REQUIRE(is_delimited(encoding_engine::tsv));
+    BOOST_REQUIRE(!is_delimited(encoding_engine::binary));
+    BOOST_REQUIRE(!is_delimited(encoding_engine::info));
+    BOOST_REQUIRE(!is_delimited(encoding_engine::ndjson));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
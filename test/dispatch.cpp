@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::explorer;
+
+BOOST_AUTO_TEST_SUITE(dispatch__dispatch_batch)
+
+#define BX_DISPATCH_SHA256_ABC \
+"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad\n"
+#define BX_DISPATCH_INVALID_FOO \
+"'foo' is not a bx command. Enter 'bx help' for a list of commands.\n"
+#define BX_DISPATCH_INVALID_SERVE \
+"The 'serve' command cannot be sent as a request.\n"
+#define BX_DISPATCH_INVALID_BATCH \
+"The '--batch' command cannot be sent as a request.\n"
+#define BX_DISPATCH_INVALID_WATCH \
+"The 'watch-address' command cannot be sent as a request.\n"
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__empty__okay_no_output)
+{
+    std::stringstream input, output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "");
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__bad_input__failure)
+{
+    std::stringstream input, output, error;
+    input.setstate(std::ios::badbit);
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::failure);
+    BOOST_REQUIRE_EQUAL(output.str(), "");
+    BOOST_REQUIRE_EQUAL(error.str(), BX_BATCH_READ_FAILURE "\n");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__blank_lines__okay_no_output)
+{
+    std::stringstream input("\n  \n\t\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "");
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__sha256__framed_output)
+{
+    std::stringstream input("sha256 616263\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "0 65 0\n" BX_DISPATCH_SHA256_ABC);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__quoted_argument__framed_output)
+{
+    std::stringstream input("sha256 \"616263\"\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "0 65 0\n" BX_DISPATCH_SHA256_ABC);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__invalid_command__framed_error)
+{
+    std::stringstream input("foo\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "-1 0 67\n" BX_DISPATCH_INVALID_FOO);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__multiple_commands__framed_in_order)
+{
+    std::stringstream input("sha256 616263\nfoo\nsha256 616263"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(),
+        "0 65 0\n" BX_DISPATCH_SHA256_ABC
+        "-1 0 67\n" BX_DISPATCH_INVALID_FOO
+        "0 65 0\n" BX_DISPATCH_SHA256_ABC);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__serve__framed_error)
+{
+    std::stringstream input("serve tcp://127.0.0.1:65081\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "-1 0 49\n" BX_DISPATCH_INVALID_SERVE);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__batch__framed_error)
+{
+    std::stringstream input(BX_BATCH_OPTION "\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "-1 0 51\n" BX_DISPATCH_INVALID_BATCH);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__watch_address__framed_error)
+{
+    std::stringstream input("watch-address 1\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str(), "-1 0 57\n" BX_DISPATCH_INVALID_WATCH);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__dispatch_batch__stats__framed_metrics)
+{
+    std::stringstream input(BX_STATS_OPTION "\n"), output, error;
+    const auto result = dispatch_batch(input, output, error);
+    BOOST_REQUIRE_EQUAL(result, console_result::okay);
+    BOOST_REQUIRE_EQUAL(output.str().substr(0, 2), "0 ");
+    BOOST_REQUIRE(output.str().find("wire_metrics") != std::string::npos);
+    BOOST_REQUIRE_EQUAL(error.str(), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(dispatch__bind_variables)
+
+BOOST_AUTO_TEST_CASE(dispatch__bind_variables__sha256_argument__binds)
+{
+    const char* argv[] = { "sha256", "616263" };
+    commands::sha256 command;
+    BOOST_REQUIRE(bind_variables(command, 2, argv));
+    const data_chunk& data = command.get_base16_argument();
+    BOOST_REQUIRE_EQUAL(encode_base16(data), "616263");
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__bind_variables__sha256_missing_argument__unbound)
+{
+    const char* argv[] = { "sha256" };
+    commands::sha256 command;
+    BOOST_REQUIRE(!bind_variables(command, 1, argv));
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__bind_variables__sha256_help__unbound)
+{
+    const char* argv[] = { "sha256", "--help" };
+    commands::sha256 command;
+    BOOST_REQUIRE(!bind_variables(command, 2, argv));
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__bind_variables__sha256_invalid_argument__unbound)
+{
+    const char* argv[] = { "sha256", "booger" };
+    commands::sha256 command;
+    BOOST_REQUIRE(!bind_variables(command, 2, argv));
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__bind_variables__option_command__unbound)
+{
+    const char* argv[] = { "settings" };
+    commands::settings command;
+    BOOST_REQUIRE(!bind_variables(command, 1, argv));
+}
+
+BOOST_AUTO_TEST_CASE(dispatch__bind_variables__fetch_height__default_settings)
+{
+    const char* argv[] = { "fetch-height", "tcp://localhost:9091" };
+    commands::fetch_height command;
+    BOOST_REQUIRE(bind_variables(command, 2, argv));
+    BOOST_REQUIRE_EQUAL(command.get_server_url_argument(), "tcp://localhost:9091");
+    BOOST_REQUIRE_EQUAL(command.get_general_network_setting(), "mainnet");
+    BOOST_REQUIRE_EQUAL(command.get_general_wait_setting(), 2000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
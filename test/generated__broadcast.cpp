@@ -33,5 +33,20 @@ BOOST_AUTO_TEST_CASE(generated__broadcast__always__does_not_throw)
     bc::explorer::broadcast(func);
 }
 
+BOOST_AUTO_TEST_CASE(generated__broadcast_metadata__always__matches_commands)
+{
+    auto func = [](const bc::explorer::command_metadata& metadata) -> void
+    {
+        const auto command = bc::explorer::find(metadata.name);
+        BOOST_REQUIRE(command != nullptr);
+        BOOST_REQUIRE_EQUAL(command->name(), metadata.name);
+        BOOST_REQUIRE_EQUAL(command->category(), metadata.category);
+        BOOST_REQUIRE_EQUAL(command->description(), metadata.description);
+        BOOST_REQUIRE_EQUAL(command->obsolete(), metadata.obsolete);
+    };
+
+    bc::explorer::broadcast_metadata(func);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
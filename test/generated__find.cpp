@@ -31,452 +31,677 @@ BOOST_AUTO_TEST_SUITE(generated__find)
 
 BOOST_AUTO_TEST_CASE(generated__find__address_decode__returns_object)
 {
-    BOOST_REQUIRE(find("address-decode") != nullptr);
+    const auto command = find("address-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), address_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__address_embed__returns_object)
 {
-    BOOST_REQUIRE(find("address-embed") != nullptr);
+    const auto command = find("address-embed");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), address_embed::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__address_encode__returns_object)
 {
-    BOOST_REQUIRE(find("address-encode") != nullptr);
+    const auto command = find("address-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), address_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__address_validate__returns_object)
 {
-    BOOST_REQUIRE(find("address-validate") != nullptr);
+    const auto command = find("address-validate");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), address_validate::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__base16_decode__returns_object)
 {
-    BOOST_REQUIRE(find("base16-decode") != nullptr);
+    const auto command = find("base16-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), base16_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__base16_encode__returns_object)
 {
-    BOOST_REQUIRE(find("base16-encode") != nullptr);
+    const auto command = find("base16-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), base16_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__base58_decode__returns_object)
 {
-    BOOST_REQUIRE(find("base58-decode") != nullptr);
+    const auto command = find("base58-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), base58_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__base58_encode__returns_object)
 {
-    BOOST_REQUIRE(find("base58-encode") != nullptr);
+    const auto command = find("base58-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), base58_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__base58check_decode__returns_object)
 {
-    BOOST_REQUIRE(find("base58check-decode") != nullptr);
+    const auto command = find("base58check-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), base58check_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__base58check_encode__returns_object)
 {
-    BOOST_REQUIRE(find("base58check-encode") != nullptr);
+    const auto command = find("base58check-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), base58check_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__bci_fetch_last_height__returns_object)
 {
-    BOOST_REQUIRE(find("bci-fetch-last-height") != nullptr);
+    const auto command = find("bci-fetch-last-height");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), bci_fetch_last_height::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__bci_history__returns_object)
 {
-    BOOST_REQUIRE(find("bci-history") != nullptr);
+    const auto command = find("bci-history");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), bci_history::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__bitcoin160__returns_object)
 {
-    BOOST_REQUIRE(find("bitcoin160") != nullptr);
+    const auto command = find("bitcoin160");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), bitcoin160::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__bitcoin256__returns_object)
 {
-    BOOST_REQUIRE(find("bitcoin256") != nullptr);
+    const auto command = find("bitcoin256");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), bitcoin256::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__blke_fetch_transaction__returns_object)
 {
-    BOOST_REQUIRE(find("blke-fetch-transaction") != nullptr);
+    const auto command = find("blke-fetch-transaction");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), blke_fetch_transaction::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__btc_to_satoshi__returns_object)
 {
-    BOOST_REQUIRE(find("btc-to-satoshi") != nullptr);
+    const auto command = find("btc-to-satoshi");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), btc_to_satoshi::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_add__returns_object)
 {
-    BOOST_REQUIRE(find("ec-add") != nullptr);
+    const auto command = find("ec-add");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_add::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_add_secrets__returns_object)
 {
-    BOOST_REQUIRE(find("ec-add-secrets") != nullptr);
+    const auto command = find("ec-add-secrets");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_add_secrets::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_lock__returns_object)
 {
-    BOOST_REQUIRE(find("ec-lock") != nullptr);
+    const auto command = find("ec-lock");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_lock::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_multiply__returns_object)
 {
-    BOOST_REQUIRE(find("ec-multiply") != nullptr);
+    const auto command = find("ec-multiply");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_multiply::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_multiply_secrets__returns_object)
 {
-    BOOST_REQUIRE(find("ec-multiply-secrets") != nullptr);
+    const auto command = find("ec-multiply-secrets");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_multiply_secrets::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_new__returns_object)
 {
-    BOOST_REQUIRE(find("ec-new") != nullptr);
+    const auto command = find("ec-new");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_new::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_to_address__returns_object)
 {
-    BOOST_REQUIRE(find("ec-to-address") != nullptr);
+    const auto command = find("ec-to-address");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_to_address::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_to_public__returns_object)
 {
-    BOOST_REQUIRE(find("ec-to-public") != nullptr);
+    const auto command = find("ec-to-public");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_to_public::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_to_wif__returns_object)
 {
-    BOOST_REQUIRE(find("ec-to-wif") != nullptr);
+    const auto command = find("ec-to-wif");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_to_wif::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ec_unlock__returns_object)
 {
-    BOOST_REQUIRE(find("ec-unlock") != nullptr);
+    const auto command = find("ec-unlock");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ec_unlock::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_balance__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-balance") != nullptr);
+    const auto command = find("fetch-balance");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_balance::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_header__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-header") != nullptr);
+    const auto command = find("fetch-header");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_header::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_height__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-height") != nullptr);
+    const auto command = find("fetch-height");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_height::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_history__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-history") != nullptr);
+    const auto command = find("fetch-history");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_history::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_public_key__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-public-key") != nullptr);
+    const auto command = find("fetch-public-key");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_public_key::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_stealth__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-stealth") != nullptr);
+    const auto command = find("fetch-stealth");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_stealth::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_tx__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-tx") != nullptr);
+    const auto command = find("fetch-tx");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_tx::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_tx_index__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-tx-index") != nullptr);
+    const auto command = find("fetch-tx-index");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_tx_index::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__fetch_utxo__returns_object)
 {
-    BOOST_REQUIRE(find("fetch-utxo") != nullptr);
+    const auto command = find("fetch-utxo");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), fetch_utxo::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__genaddr__returns_object)
 {
-    BOOST_REQUIRE(find("genaddr") != nullptr);
+    const auto command = find("genaddr");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), genaddr::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__genpriv__returns_object)
 {
-    BOOST_REQUIRE(find("genpriv") != nullptr);
+    const auto command = find("genpriv");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), genpriv::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__genpub__returns_object)
 {
-    BOOST_REQUIRE(find("genpub") != nullptr);
+    const auto command = find("genpub");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), genpub::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__hd_new__returns_object)
 {
-    BOOST_REQUIRE(find("hd-new") != nullptr);
+    const auto command = find("hd-new");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), hd_new::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__hd_private__returns_object)
 {
-    BOOST_REQUIRE(find("hd-private") != nullptr);
+    const auto command = find("hd-private");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), hd_private::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__hd_public__returns_object)
 {
-    BOOST_REQUIRE(find("hd-public") != nullptr);
+    const auto command = find("hd-public");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), hd_public::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__hd_to_address__returns_object)
 {
-    BOOST_REQUIRE(find("hd-to-address") != nullptr);
+    const auto command = find("hd-to-address");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), hd_to_address::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__hd_to_ec__returns_object)
 {
-    BOOST_REQUIRE(find("hd-to-ec") != nullptr);
+    const auto command = find("hd-to-ec");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), hd_to_ec::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__hd_to_public__returns_object)
 {
-    BOOST_REQUIRE(find("hd-to-public") != nullptr);
+    const auto command = find("hd-to-public");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), hd_to_public::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__hd_to_wif__returns_object)
 {
-    BOOST_REQUIRE(find("hd-to-wif") != nullptr);
+    const auto command = find("hd-to-wif");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), hd_to_wif::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__help__returns_object)
 {
-    BOOST_REQUIRE(find("help") != nullptr);
+    const auto command = find("help");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), help::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__initchain__returns_object)
 {
-    BOOST_REQUIRE(find("initchain") != nullptr);
+    const auto command = find("initchain");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), initchain::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__input_set__returns_object)
 {
-    BOOST_REQUIRE(find("input-set") != nullptr);
+    const auto command = find("input-set");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), input_set::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__input_sign__returns_object)
 {
-    BOOST_REQUIRE(find("input-sign") != nullptr);
+    const auto command = find("input-sign");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), input_sign::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__input_validate__returns_object)
 {
-    BOOST_REQUIRE(find("input-validate") != nullptr);
+    const auto command = find("input-validate");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), input_validate::symbol());
+}
+
+BOOST_AUTO_TEST_CASE(generated__find__load_test__returns_object)
+{
+    const auto command = find("load-test");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), load_test::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__mnemonic_decode__returns_object)
 {
-    BOOST_REQUIRE(find("mnemonic-decode") != nullptr);
+    const auto command = find("mnemonic-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), mnemonic_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__mnemonic_encode__returns_object)
 {
-    BOOST_REQUIRE(find("mnemonic-encode") != nullptr);
+    const auto command = find("mnemonic-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), mnemonic_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__mpk__returns_object)
 {
-    BOOST_REQUIRE(find("mpk") != nullptr);
+    const auto command = find("mpk");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), mpk::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__newseed__returns_object)
 {
-    BOOST_REQUIRE(find("newseed") != nullptr);
+    const auto command = find("newseed");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), newseed::symbol());
+}
+
+BOOST_AUTO_TEST_CASE(generated__find__prewarm_tx__returns_object)
+{
+    const auto command = find("prewarm-tx");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), prewarm_tx::symbol());
+}
+
+BOOST_AUTO_TEST_CASE(generated__find__probe_servers__returns_object)
+{
+    const auto command = find("probe-servers");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), probe_servers::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__qrcode__returns_object)
 {
-    BOOST_REQUIRE(find("qrcode") != nullptr);
+    const auto command = find("qrcode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), qrcode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__ripemd160__returns_object)
 {
-    BOOST_REQUIRE(find("ripemd160") != nullptr);
+    const auto command = find("ripemd160");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), ripemd160::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__satoshi_to_btc__returns_object)
 {
-    BOOST_REQUIRE(find("satoshi-to-btc") != nullptr);
+    const auto command = find("satoshi-to-btc");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), satoshi_to_btc::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__script_decode__returns_object)
 {
-    BOOST_REQUIRE(find("script-decode") != nullptr);
+    const auto command = find("script-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), script_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__script_encode__returns_object)
 {
-    BOOST_REQUIRE(find("script-encode") != nullptr);
+    const auto command = find("script-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), script_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__script_to_address__returns_object)
 {
-    BOOST_REQUIRE(find("script-to-address") != nullptr);
+    const auto command = find("script-to-address");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), script_to_address::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__seed__returns_object)
 {
-    BOOST_REQUIRE(find("seed") != nullptr);
+    const auto command = find("seed");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), seed::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__send_tx__returns_object)
 {
-    BOOST_REQUIRE(find("send-tx") != nullptr);
+    const auto command = find("send-tx");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), send_tx::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__send_tx_node__returns_object)
 {
-    BOOST_REQUIRE(find("send-tx-node") != nullptr);
+    const auto command = find("send-tx-node");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), send_tx_node::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__send_tx_p2p__returns_object)
 {
-    BOOST_REQUIRE(find("send-tx-p2p") != nullptr);
+    const auto command = find("send-tx-p2p");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), send_tx_p2p::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__sendtx_bci__returns_object)
 {
-    BOOST_REQUIRE(find("sendtx-bci") != nullptr);
+    const auto command = find("sendtx-bci");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), sendtx_bci::symbol());
+}
+
+BOOST_AUTO_TEST_CASE(generated__find__serve__returns_object)
+{
+    const auto command = find("serve");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), serve::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__settings__returns_object)
 {
-    BOOST_REQUIRE(find("settings") != nullptr);
+    const auto command = find("settings");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), settings::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__sha160__returns_object)
 {
-    BOOST_REQUIRE(find("sha160") != nullptr);
+    const auto command = find("sha160");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), sha160::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__sha256__returns_object)
 {
-    BOOST_REQUIRE(find("sha256") != nullptr);
+    const auto command = find("sha256");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), sha256::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__sha512__returns_object)
 {
-    BOOST_REQUIRE(find("sha512") != nullptr);
+    const auto command = find("sha512");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), sha512::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__showblkhead__returns_object)
 {
-    BOOST_REQUIRE(find("showblkhead") != nullptr);
+    const auto command = find("showblkhead");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), showblkhead::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__stealth_decode__returns_object)
 {
-    BOOST_REQUIRE(find("stealth-decode") != nullptr);
+    const auto command = find("stealth-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), stealth_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__stealth_encode__returns_object)
 {
-    BOOST_REQUIRE(find("stealth-encode") != nullptr);
+    const auto command = find("stealth-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), stealth_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__stealth_initiate__returns_object)
 {
-    BOOST_REQUIRE(find("stealth-initiate") != nullptr);
+    const auto command = find("stealth-initiate");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), stealth_initiate::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__stealth_newkey__returns_object)
 {
-    BOOST_REQUIRE(find("stealth-newkey") != nullptr);
+    const auto command = find("stealth-newkey");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), stealth_newkey::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__stealth_public__returns_object)
 {
-    BOOST_REQUIRE(find("stealth-public") != nullptr);
+    const auto command = find("stealth-public");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), stealth_public::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__stealth_secret__returns_object)
 {
-    BOOST_REQUIRE(find("stealth-secret") != nullptr);
+    const auto command = find("stealth-secret");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), stealth_secret::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__stealth_shared__returns_object)
 {
-    BOOST_REQUIRE(find("stealth-shared") != nullptr);
+    const auto command = find("stealth-shared");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), stealth_shared::symbol());
+}
+
+BOOST_AUTO_TEST_CASE(generated__find__sync_headers__returns_object)
+{
+    const auto command = find("sync-headers");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), sync_headers::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__tx_decode__returns_object)
 {
-    BOOST_REQUIRE(find("tx-decode") != nullptr);
+    const auto command = find("tx-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), tx_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__tx_encode__returns_object)
 {
-    BOOST_REQUIRE(find("tx-encode") != nullptr);
+    const auto command = find("tx-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), tx_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__tx_sign__returns_object)
 {
-    BOOST_REQUIRE(find("tx-sign") != nullptr);
+    const auto command = find("tx-sign");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), tx_sign::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__uri_decode__returns_object)
 {
-    BOOST_REQUIRE(find("uri-decode") != nullptr);
+    const auto command = find("uri-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), uri_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__uri_encode__returns_object)
 {
-    BOOST_REQUIRE(find("uri-encode") != nullptr);
+    const auto command = find("uri-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), uri_encode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__validate_tx__returns_object)
 {
-    BOOST_REQUIRE(find("validate-tx") != nullptr);
+    const auto command = find("validate-tx");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), validate_tx::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__wallet__returns_object)
 {
-    BOOST_REQUIRE(find("wallet") != nullptr);
+    const auto command = find("wallet");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), wallet::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__watch_address__returns_object)
 {
-    BOOST_REQUIRE(find("watch-address") != nullptr);
+    const auto command = find("watch-address");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), watch_address::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__watch_tx__returns_object)
 {
-    BOOST_REQUIRE(find("watch-tx") != nullptr);
+    const auto command = find("watch-tx");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), watch_tx::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__wif_to_ec__returns_object)
 {
-    BOOST_REQUIRE(find("wif-to-ec") != nullptr);
+    const auto command = find("wif-to-ec");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), wif_to_ec::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__wif_to_public__returns_object)
 {
-    BOOST_REQUIRE(find("wif-to-public") != nullptr);
+    const auto command = find("wif-to-public");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), wif_to_public::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__wrap_decode__returns_object)
 {
-    BOOST_REQUIRE(find("wrap-decode") != nullptr);
+    const auto command = find("wrap-decode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), wrap_decode::symbol());
 }
 
 BOOST_AUTO_TEST_CASE(generated__find__wrap_encode__returns_object)
 {
-    BOOST_REQUIRE(find("wrap-encode") != nullptr);
+    const auto command = find("wrap-encode");
+    BOOST_REQUIRE(command != nullptr);
+    BOOST_REQUIRE_EQUAL(command->name(), wrap_encode::symbol());
+}
+
+BOOST_AUTO_TEST_CASE(generated__find__bogus__returns_null)
+{
+    BOOST_REQUIRE(find("booger") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(generated__find__empty__returns_null)
+{
+    BOOST_REQUIRE(find("") == nullptr);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -219,5 +219,15 @@ BOOST_AUTO_TEST_CASE(generated__formerly__wrap_encode_was_wrap__returns_object)
     BOOST_REQUIRE_EQUAL(formerly("wrap"), wrap_encode::symbol());
 }
 
+BOOST_AUTO_TEST_CASE(generated__formerly__bogus__returns_empty)
+{
+    BOOST_REQUIRE_EQUAL(formerly("booger"), "");
+}
+
+BOOST_AUTO_TEST_CASE(generated__formerly__current_symbol__returns_empty)
+{
+    BOOST_REQUIRE_EQUAL(formerly("fetch-tx"), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
@@ -279,6 +279,11 @@ BOOST_AUTO_TEST_CASE(generated__symbol__input_validate__returns_expected_value)
     BOOST_REQUIRE_EQUAL(input_validate::symbol(), "input-validate");
 }
 
+BOOST_AUTO_TEST_CASE(generated__symbol__load_test__returns_expected_value)
+{
+    BOOST_REQUIRE_EQUAL(load_test::symbol(), "load-test");
+}
+
 BOOST_AUTO_TEST_CASE(generated__symbol__mnemonic_decode__returns_expected_value)
 {
     BOOST_REQUIRE_EQUAL(mnemonic_decode::symbol(), "mnemonic-decode");
@@ -299,6 +304,16 @@ BOOST_AUTO_TEST_CASE(generated__symbol__newseed__returns_expected_value)
     BOOST_REQUIRE_EQUAL(newseed::symbol(), "newseed");
 }
 
+BOOST_AUTO_TEST_CASE(generated__symbol__prewarm_tx__returns_expected_value)
+{
+    BOOST_REQUIRE_EQUAL(prewarm_tx::symbol(), "prewarm-tx");
+}
+
+BOOST_AUTO_TEST_CASE(generated__symbol__probe_servers__returns_expected_value)
+{
+    BOOST_REQUIRE_EQUAL(probe_servers::symbol(), "probe-servers");
+}
+
 BOOST_AUTO_TEST_CASE(generated__symbol__qrcode__returns_expected_value)
 {
     BOOST_REQUIRE_EQUAL(qrcode::symbol(), "qrcode");
@@ -354,6 +369,11 @@ BOOST_AUTO_TEST_CASE(generated__symbol__sendtx_bci__returns_expected_value)
     BOOST_REQUIRE_EQUAL(sendtx_bci::symbol(), "sendtx-bci");
 }
 
+BOOST_AUTO_TEST_CASE(generated__symbol__serve__returns_expected_value)
+{
+    BOOST_REQUIRE_EQUAL(serve::symbol(), "serve");
+}
+
 BOOST_AUTO_TEST_CASE(generated__symbol__settings__returns_expected_value)
 {
     BOOST_REQUIRE_EQUAL(settings::symbol(), "settings");
@@ -414,6 +434,11 @@ BOOST_AUTO_TEST_CASE(generated__symbol__stealth_shared__returns_expected_value)
     BOOST_REQUIRE_EQUAL(stealth_shared::symbol(), "stealth-shared");
 }
 
+BOOST_AUTO_TEST_CASE(generated__symbol__sync_headers__returns_expected_value)
+{
+    BOOST_REQUIRE_EQUAL(sync_headers::symbol(), "sync-headers");
+}
+
 BOOST_AUTO_TEST_CASE(generated__symbol__tx_decode__returns_expected_value)
 {
     BOOST_REQUIRE_EQUAL(tx_decode::symbol(), "tx-decode");
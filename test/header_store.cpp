@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::explorer;
+
+static boost::filesystem::path temporary_path()
+{
+    return boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+}
+
+static void remove_files(const boost::filesystem::path& path)
+{
+    boost::filesystem::remove(path);
+    boost::filesystem::remove(path.string() + ".lock");
+}
+
+// The headers of the first two mainnet blocks.
+static std::vector<block_header_type> first_headers()
+{
+    block_header_type second;
+    second.version = 1;
+    second.previous_block_hash = hash_block_header(genesis_block().header);
+    second.merkle = decode_hash(
+        "0e3e2357e806b6cdb1f70b54c3a3a17b6714ee1f0e68bebb44a74b1efd512098");
+    second.timestamp = 1231469665;
+    second.bits = 486604799;
+    second.nonce = 2573394689;
+    return { genesis_block().header, second };
+}
+
+// A header of which only the time and difficulty are meaningful.
+static block_header_type make_header(uint32_t timestamp, uint32_t bits)
+{
+    block_header_type header;
+    header.version = 1;
+    header.previous_block_hash = null_hash;
+    header.merkle = null_hash;
+    header.timestamp = timestamp;
+    header.bits = bits;
+    header.nonce = 0;
+    return header;
+}
+
+BOOST_AUTO_TEST_SUITE(header_store__verify)
+
+BOOST_AUTO_TEST_CASE(header_store__verify__mainnet_headers__all_valid)
+{
+    const auto headers = first_headers();
+    BOOST_REQUIRE_EQUAL(header_store::verify(headers, null_hash), 2u);
+    BOOST_REQUIRE_EQUAL(header_store::verify(headers, null_hash, 1), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__verify__wrong_previous__none_valid)
+{
+    const auto headers = first_headers();
+    BOOST_REQUIRE_EQUAL(header_store::verify(headers,
+        hash_block_header(headers.back())), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__verify__changed_nonce__stops_at_header)
+{
+    auto headers = first_headers();
+    headers.back().nonce++;
+    BOOST_REQUIRE_EQUAL(header_store::verify(headers, null_hash), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__verify__negative_target__none_valid)
+{
+    auto headers = first_headers();
+    headers.front().bits |= 0x00800000;
+    BOOST_REQUIRE_EQUAL(header_store::verify(headers, null_hash), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(header_store__verify_difficulty)
+
+BOOST_AUTO_TEST_CASE(header_store__verify_difficulty__mainnet_headers__all_valid)
+{
+    const auto path = temporary_path();
+    header_store store(path);
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty(first_headers(), false), 2u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__verify_difficulty__changed_bits__stops_at_header)
+{
+    const auto path = temporary_path();
+    header_store store(path);
+    auto headers = first_headers();
+    headers.back().bits = 0x1c00ffff;
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty(headers, false), 1u);
+    remove_files(path);
+}
+
+// The retarget at height 32256, from the times of blocks 30240 and 32255.
+BOOST_AUTO_TEST_CASE(header_store__verify_difficulty__retarget__scaled_bits)
+{
+    const auto path = temporary_path();
+    header_store store(path);
+    std::vector<block_header_type> period;
+    for (uint32_t index = 0; index < 2016; ++index)
+        period.push_back(make_header(1261130161 + index * 500, 0x1d00ffff));
+
+    period.back().timestamp = 1262152739;
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty(period, false), 2016u);
+    BOOST_REQUIRE(store.append(period));
+
+    const auto next = make_header(1262153000, 0x1d00d86a);
+    const auto unchanged = make_header(1262153000, 0x1d00ffff);
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty({ next }, false), 1u);
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty({ unchanged }, false), 0u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__verify_difficulty__testnet_slow_block__minimum_allowed)
+{
+    const auto path = temporary_path();
+    header_store store(path);
+    const std::vector<block_header_type> headers =
+    {
+        make_header(1000, 0x1d00ffff),
+        make_header(1600, 0x1c00ffff)
+    };
+
+    // The store does not verify, so the period need not begin at a retarget.
+    BOOST_REQUIRE(store.append(headers));
+
+    // A minimum difficulty block is valid only once twenty minutes pass, and
+    // its successor returns to the difficulty of the period.
+    const auto fast = make_header(2000, 0x1d00ffff);
+    const auto slow = make_header(2801, 0x1d00ffff);
+    const auto after = make_header(3000, 0x1c00ffff);
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty({ fast }, true), 0u);
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty({ slow }, false), 0u);
+    BOOST_REQUIRE_EQUAL(store.verify_difficulty({ slow, after }, true), 2u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(header_store__append)
+
+BOOST_AUTO_TEST_CASE(header_store__constructor__foreign_file__invalid)
+{
+    const auto path = temporary_path();
+    std::ofstream file(path.string());
+    file << "not a header file";
+    file.close();
+
+    header_store store(path);
+    BOOST_REQUIRE(!store.valid());
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__constructor__new_file__empty)
+{
+    const auto path = temporary_path();
+    header_store store(path);
+    BOOST_REQUIRE(store.valid());
+    BOOST_REQUIRE_EQUAL(store.count(), 0u);
+    BOOST_REQUIRE(store.top_hash() == null_hash);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__read__reopened__stored_headers)
+{
+    const auto path = temporary_path();
+    const auto headers = first_headers();
+    {
+        header_store store(path);
+        BOOST_REQUIRE(store.append(headers));
+    }
+
+    header_store store(path);
+    BOOST_REQUIRE_EQUAL(store.count(), 2u);
+    BOOST_REQUIRE(store.top_hash() == hash_block_header(headers.back()));
+
+    block_header_type header;
+    BOOST_REQUIRE(store.read(header, 1));
+    BOOST_REQUIRE(hash_block_header(header) ==
+        hash_block_header(headers.back()));
+    BOOST_REQUIRE(!store.read(header, 2));
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__find__stored_hash__header)
+{
+    const auto path = temporary_path();
+    const auto headers = first_headers();
+    header_store store(path);
+    BOOST_REQUIRE(store.append(headers));
+
+    block_header_type header;
+    const auto genesis = hash_block_header(headers.front());
+    BOOST_REQUIRE(store.find(header, genesis));
+    BOOST_REQUIRE(hash_block_header(header) == genesis);
+
+    const auto top = hash_block_header(headers.back());
+    BOOST_REQUIRE(store.find(header, top));
+    BOOST_REQUIRE(hash_block_header(header) == top);
+    BOOST_REQUIRE(!store.find(header, null_hash));
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(header_store__truncate__reopened__headers_removed)
+{
+    const auto path = temporary_path();
+    const auto headers = first_headers();
+    {
+        header_store store(path);
+        BOOST_REQUIRE(store.append(headers));
+        BOOST_REQUIRE(!store.truncate(3));
+        BOOST_REQUIRE(store.truncate(1));
+    }
+
+    header_store store(path);
+    BOOST_REQUIRE_EQUAL(store.count(), 1u);
+    BOOST_REQUIRE(store.top_hash() == hash_block_header(headers.front()));
+
+    block_header_type header;
+    BOOST_REQUIRE(!store.read(header, 1));
+    BOOST_REQUIRE(store.append({ headers.back() }));
+    BOOST_REQUIRE_EQUAL(store.count(), 2u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+// Records the messages written to a server.
+class recorder
+  : public message_stream
+{
+public:
+    recorder()
+      : writes(0)
+    {
+    }
+
+    virtual void write(const data_stack& data)
+    {
+        ++writes;
+    }
+
+    size_t writes;
+};
+
+// A call message: command, id and payload frames.
+static const data_stack call
+{
+    { 'f', 'o', 'o' },
+    { 0x2a, 0x00, 0x00, 0x00 },
+    { }
+};
+
+static void sleep_beyond(const period_ms& delay)
+{
+    std::this_thread::sleep_for(delay * 2 + period_ms(1));
+}
+
+BOOST_AUTO_TEST_SUITE(hedge_stream__hedge)
+
+BOOST_AUTO_TEST_CASE(hedge_stream__write__no_servers__no_wakeup)
+{
+    hedge_stream hedge(period_ms(1));
+    hedge.write(call);
+    BOOST_REQUIRE_EQUAL(hedge.wakeup().count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_stream__write__two_servers__first_server_only)
+{
+    const auto first = std::make_shared<recorder>();
+    const auto second = std::make_shared<recorder>();
+    hedge_stream hedge(period_ms(1000));
+    hedge.add(first);
+    hedge.add(second);
+    hedge.write(call);
+    BOOST_REQUIRE_EQUAL(first->writes, 1u);
+    BOOST_REQUIRE_EQUAL(second->writes, 0u);
+    BOOST_REQUIRE(hedge.wakeup().count() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_stream__wakeup__zero_delay__not_hedged)
+{
+    const auto first = std::make_shared<recorder>();
+    const auto second = std::make_shared<recorder>();
+    hedge_stream hedge(period_ms(0));
+    hedge.add(first);
+    hedge.add(second);
+    hedge.write(call);
+    BOOST_REQUIRE_EQUAL(hedge.wakeup().count(), 0);
+    BOOST_REQUIRE_EQUAL(second->writes, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_stream__wakeup__delay_elapsed__hedged_to_next_server)
+{
+    const period_ms delay(1);
+    const auto first = std::make_shared<recorder>();
+    const auto second = std::make_shared<recorder>();
+    hedge_stream hedge(delay);
+    hedge.add(first);
+    hedge.add(second);
+    hedge.write(call);
+    sleep_beyond(delay);
+    BOOST_REQUIRE_EQUAL(hedge.wakeup().count(), 0);
+    BOOST_REQUIRE_EQUAL(first->writes, 1u);
+    BOOST_REQUIRE_EQUAL(second->writes, 1u);
+    BOOST_REQUIRE_EQUAL(hedge.hedges(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_stream__reply__before_delay__not_hedged)
+{
+    const period_ms delay(1);
+    const auto first = std::make_shared<recorder>();
+    const auto second = std::make_shared<recorder>();
+    hedge_stream hedge(delay);
+    hedge.add(first);
+    hedge.add(second);
+    hedge.write(call);
+    hedge.reply(0, call);
+    sleep_beyond(delay);
+    BOOST_REQUIRE_EQUAL(hedge.wakeup().count(), 0);
+    BOOST_REQUIRE_EQUAL(second->writes, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_stream__write__faster_second_server__second_server_first)
+{
+    const auto first = std::make_shared<recorder>();
+    const auto second = std::make_shared<recorder>();
+    hedge_stream hedge(period_ms(1000));
+    hedge.add(first);
+    hedge.add(second);
+
+    // Only the second server has an observed latency.
+    hedge.write(call);
+    hedge.reply(1, call);
+    hedge.write(call);
+    BOOST_REQUIRE_EQUAL(first->writes, 1u);
+    BOOST_REQUIRE_EQUAL(second->writes, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_stream__write__outstanding_id__retry)
+{
+    hedge_stream hedge(period_ms(0));
+    hedge.add(std::make_shared<recorder>());
+    hedge.write(call);
+    BOOST_REQUIRE_EQUAL(hedge.retries(), 0u);
+    hedge.write(call);
+    BOOST_REQUIRE_EQUAL(hedge.retries(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(hedge_stream__delay__insufficient_samples__initial_delay)
+{
+    const period_ms delay(42);
+    hedge_stream hedge(delay);
+    hedge.add(std::make_shared<recorder>());
+    hedge.write(call);
+    hedge.reply(0, call);
+    BOOST_REQUIRE_EQUAL(hedge.delay().count(), delay.count());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
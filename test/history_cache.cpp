@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+static boost::filesystem::path temporary_path()
+{
+    return boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+}
+
+static void remove_files(const boost::filesystem::path& path)
+{
+    boost::filesystem::remove(path);
+    boost::filesystem::remove(path.string() + ".lock");
+}
+
+static history_row make_row(uint8_t seed, size_t height, size_t spend_height)
+{
+    history_row row;
+    row.output.hash = bitcoin_hash(data_chunk{ seed });
+    row.output.index = seed;
+    row.output_height = height;
+    row.value = 1000 * seed;
+    row.spend.hash = spend_height == 0 ? null_hash :
+        bitcoin_hash(data_chunk{ seed, seed });
+    row.spend.index = spend_height == 0 ? max_uint32 : 0;
+    row.spend_height = spend_height;
+    return row;
+}
+
+static const payment_address address(0x00, short_hash{ { 0x42 } });
+
+BOOST_AUTO_TEST_SUITE(history_cache__merge)
+
+BOOST_AUTO_TEST_CASE(history_cache__constructor__new_file__valid_empty)
+{
+    const auto path = temporary_path();
+    history_cache cache(path);
+    BOOST_REQUIRE(cache.valid());
+    BOOST_REQUIRE_EQUAL(cache.height(address), 0u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(history_cache__constructor__foreign_file__invalid)
+{
+    const auto path = temporary_path();
+    std::ofstream file(path.string());
+    file << "not a history cache file";
+    file.close();
+
+    history_cache cache(path);
+    BOOST_REQUIRE(!cache.valid());
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(history_cache__merge__reopened__persisted_height_and_rows)
+{
+    const auto path = temporary_path();
+    {
+        history_cache cache(path);
+        const auto merged = cache.merge(address,
+            { make_row(1, 100, 0), make_row(2, 110, 120) });
+        BOOST_REQUIRE_EQUAL(merged.size(), 2u);
+        BOOST_REQUIRE_EQUAL(cache.height(address), 114u);
+    }
+
+    // The refresh height is six blocks below the synced height, so the server
+    // returns only the row spent above it.
+    history_cache cache(path);
+    BOOST_REQUIRE_EQUAL(cache.height(address), 114u);
+    const auto merged = cache.merge(address, { make_row(2, 110, 120) });
+    BOOST_REQUIRE_EQUAL(merged.size(), 2u);
+    BOOST_REQUIRE_EQUAL(merged[0].value, 1000u);
+    BOOST_REQUIRE_EQUAL(merged[1].spend_height, 120u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(history_cache__merge__spent_delta__replaces_row)
+{
+    const auto path = temporary_path();
+    {
+        history_cache cache(path);
+        cache.merge(address, { make_row(1, 100, 0) });
+        const auto merged = cache.merge(address, { make_row(1, 100, 130) });
+        BOOST_REQUIRE_EQUAL(merged.size(), 1u);
+        BOOST_REQUIRE_EQUAL(merged[0].spend_height, 130u);
+    }
+
+    history_cache cache(path);
+    const auto merged = cache.merge(address, { make_row(1, 100, 130) });
+    BOOST_REQUIRE_EQUAL(merged.size(), 1u);
+    BOOST_REQUIRE_EQUAL(merged[0].spend_height, 130u);
+    BOOST_REQUIRE_EQUAL(cache.height(address), 124u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(history_cache__merge__unconfirmed_row__not_persisted)
+{
+    const auto path = temporary_path();
+    {
+        history_cache cache(path);
+        const auto merged = cache.merge(address,
+            { make_row(1, 100, 0), make_row(2, 0, 0) });
+        BOOST_REQUIRE_EQUAL(merged.size(), 2u);
+    }
+
+    history_cache cache(path);
+    const auto merged = cache.merge(address, { make_row(1, 100, 0) });
+    BOOST_REQUIRE_EQUAL(merged.size(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.height(address), 94u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(history_cache__merge__reorganized_receive__dropped)
+{
+    const auto path = temporary_path();
+    {
+        history_cache cache(path);
+        cache.merge(address, { make_row(1, 100, 0), make_row(2, 200, 0) });
+        BOOST_REQUIRE_EQUAL(cache.height(address), 194u);
+
+        // The receive at 200 is no longer returned from the refresh height.
+        const auto merged = cache.merge(address, {});
+        BOOST_REQUIRE_EQUAL(merged.size(), 1u);
+        BOOST_REQUIRE_EQUAL(merged[0].output_height, 100u);
+    }
+
+    history_cache cache(path);
+    const auto merged = cache.merge(address, {});
+    BOOST_REQUIRE_EQUAL(merged.size(), 1u);
+    BOOST_REQUIRE_EQUAL(merged[0].output_height, 100u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(history_cache__merge__reorganized_spend__unspent)
+{
+    const auto path = temporary_path();
+    {
+        history_cache cache(path);
+        cache.merge(address, { make_row(1, 100, 200) });
+
+        // The spend at 200 is no longer returned from the refresh height.
+        const auto merged = cache.merge(address, {});
+        BOOST_REQUIRE_EQUAL(merged.size(), 1u);
+        BOOST_REQUIRE_EQUAL(merged[0].spend_height, 0u);
+        BOOST_REQUIRE(merged[0].spend.hash == null_hash);
+    }
+
+    history_cache cache(path);
+    const auto merged = cache.merge(address, {});
+    BOOST_REQUIRE_EQUAL(merged.size(), 1u);
+    BOOST_REQUIRE_EQUAL(merged[0].spend_height, 0u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(history_cache__merge__reorganized_receive__moved)
+{
+    const auto path = temporary_path();
+    history_cache cache(path);
+    cache.merge(address, { make_row(1, 100, 0), make_row(2, 200, 0) });
+
+    // The receive at 200 is confirmed again at 201.
+    const auto merged = cache.merge(address, { make_row(2, 201, 0) });
+    BOOST_REQUIRE_EQUAL(merged.size(), 2u);
+    BOOST_REQUIRE_EQUAL(cache.height(address), 195u);
+    for (const auto& row: merged)
+        BOOST_REQUIRE(row.output_height == 100u || row.output_height == 201u);
+
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc::explorer;
+
+// A probe with the latencies in microseconds.
+static server_probe make_probe(const std::string& server,
+    const std::vector<uint64_t>& latencies, size_t failures, size_t height)
+{
+    server_probe probe{ server, {}, failures, height, 0 };
+    for (const auto latency: latencies)
+        probe.latencies.record(latency);
+
+    return probe;
+}
+
+BOOST_AUTO_TEST_SUITE(latency_probe__rank)
+
+BOOST_AUTO_TEST_CASE(latency_probe__healthy__no_latencies__false)
+{
+    const auto probe = make_probe("a", {}, 0, 100);
+    BOOST_REQUIRE(!latency_probe::healthy(probe));
+}
+
+BOOST_AUTO_TEST_CASE(latency_probe__healthy__answered__true)
+{
+    const auto probe = make_probe("a", { 10 }, 0, 100);
+    BOOST_REQUIRE(latency_probe::healthy(probe));
+}
+
+BOOST_AUTO_TEST_CASE(latency_probe__healthy__failure__false)
+{
+    const auto probe = make_probe("a", { 10 }, 1, 100);
+    BOOST_REQUIRE(!latency_probe::healthy(probe));
+}
+
+BOOST_AUTO_TEST_CASE(latency_probe__rank__lagging_server__computes_lag)
+{
+    std::vector<server_probe> probes
+    {
+        make_probe("a", { 10 }, 0, 98),
+        make_probe("b", { 20 }, 0, 100)
+    };
+
+    latency_probe::rank(probes);
+    BOOST_REQUIRE_EQUAL(probes[0].server, "b");
+    BOOST_REQUIRE_EQUAL(probes[0].lag, 0u);
+    BOOST_REQUIRE_EQUAL(probes[1].lag, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(latency_probe__rank__healthy_servers__median_order)
+{
+    std::vector<server_probe> probes
+    {
+        make_probe("a", { 3000, 3000, 3000 }, 0, 100),
+        make_probe("b", { 1000, 1000, 9000 }, 0, 100),
+        make_probe("c", {}, 3, 0)
+    };
+
+    latency_probe::rank(probes);
+    BOOST_REQUIRE_EQUAL(probes[0].server, "b");
+    BOOST_REQUIRE_EQUAL(probes[1].server, "a");
+    BOOST_REQUIRE_EQUAL(probes[2].server, "c");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/explorer.hpp>
+#include "mock/mock_server.hpp"
+
+using namespace bc::client;
+using namespace bc::explorer;
+
+#define BX_LOAD_GENERATOR_SERVER "tcp://127.0.0.1:65071"
+
+BOOST_AUTO_TEST_SUITE(load_generator__report)
+
+BOOST_AUTO_TEST_CASE(load_generator__throughput__zero_duration__zero)
+{
+    const load_report report{ 0, 1, 0, 1, 1, 0, 0, 0, 0, {} };
+    BOOST_REQUIRE_EQUAL(load_generator::throughput(report), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(load_generator__throughput__completed__per_second)
+{
+    const load_report report{ 2000, 1, 0, 10, 10, 0, 0, 0, 0, {} };
+    BOOST_REQUIRE_EQUAL(load_generator::throughput(report), 5.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(load_generator__run)
+
+BOOST_AUTO_TEST_CASE(load_generator__run__mock_server__microsecond_latencies)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    BOOST_REQUIRE(server.start(BX_LOAD_GENERATOR_SERVER));
+
+    bc::explorer::obelisk_client client(context, period_ms(2000));
+    BOOST_REQUIRE_GE(client.connect(BX_LOAD_GENERATOR_SERVER), 0);
+
+    // Loopback round trips are well under a millisecond.
+    load_generator generator(2, 0);
+    const auto report = generator.run(client, period_ms(100));
+    BOOST_REQUIRE_GT(report.completed, 0u);
+    BOOST_REQUIRE_EQUAL(report.latencies.count(), report.completed);
+    BOOST_REQUIRE_GT(report.latencies.maximum(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,388 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mock_server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+#include <bitcoin/explorer/utility/utility.hpp>
+
+using namespace bc::client;
+
+namespace libbitcoin {
+namespace explorer {
+
+// The longest the server thread waits before observing a stop.
+static const int poll_period_ms = 100;
+
+// The obelisk_codec request commands that are answered.
+static const char* fetch_last_height = "blockchain.fetch_last_height";
+static const char* fetch_history = "blockchain.fetch_history";
+static const char* address_fetch_history = "address.fetch_history";
+static const char* fetch_transaction = "blockchain.fetch_transaction";
+static const char* fetch_unconfirmed_transaction =
+    "transaction_pool.fetch_transaction";
+static const char* fetch_transaction_index =
+    "blockchain.fetch_transaction_index";
+static const char* fetch_block_header = "blockchain.fetch_block_header";
+static const char* fetch_stealth = "blockchain.fetch_stealth";
+static const char* broadcast_transaction = "protocol.broadcast_transaction";
+static const char* validate = "transaction_pool.validate";
+
+static void write_4_bytes(data_chunk& data, uint32_t value)
+{
+    extend_data(data, to_little_endian(value));
+}
+
+static void write_8_bytes(data_chunk& data, uint64_t value)
+{
+    extend_data(data, to_little_endian(value));
+}
+
+// Each reply payload begins with an error code, zero for success.
+static data_chunk error_code(const std::error_code& code=std::error_code())
+{
+    data_chunk payload;
+    write_4_bytes(payload, static_cast<uint32_t>(code.value()));
+    return payload;
+}
+
+
+mock_server::mock_server(czmqpp::context& context, const period_ms& latency,
+    const period_ms& jitter)
+  : latency_(latency), jitter_(jitter), socket_(context, ZMQ_ROUTER),
+    stopped_(true), requests_(0), height_(0), synthetic_rows_(0)
+{
+}
+
+mock_server::~mock_server()
+{
+    stop();
+}
+
+bool mock_server::start(const std::string& endpoint)
+{
+    if (!stopped_ || socket_.bind(endpoint) < 0)
+        return false;
+
+    stopped_ = false;
+    thread_ = std::thread(&mock_server::run, this);
+    return true;
+}
+
+void mock_server::stop()
+{
+    stopped_ = true;
+    if (thread_.joinable())
+        thread_.join();
+}
+
+size_t mock_server::requests() const
+{
+    return requests_;
+}
+
+void mock_server::set_height(size_t height)
+{
+    height_ = static_cast<uint32_t>(height);
+}
+
+void mock_server::set_synthetic_history(size_t rows)
+{
+    synthetic_rows_ = rows;
+}
+
+void mock_server::add_history(const payment_address& address,
+    const history_row& row)
+{
+    histories_[address.hash()].push_back(row);
+}
+
+void mock_server::add_header(size_t height, const block_header_type& header)
+{
+    const auto height32 = static_cast<uint32_t>(height);
+    headers_[height32] = header;
+    header_heights_[hash_block_header(header)] = height32;
+}
+
+void mock_server::add_stealth(const stealth_row& row)
+{
+    stealth_rows_.push_back(row);
+}
+
+void mock_server::add_transaction(const tx_type& tx, size_t height,
+    size_t index)
+{
+    transactions_[hash_transaction(tx)] =
+    {
+        serialize_satoshi_item(tx),
+        static_cast<uint32_t>(height),
+        static_cast<uint32_t>(index)
+    };
+}
+
+// Orders the reply heap so that the earliest due reply is at the front.
+bool mock_server::later(const reply& left, const reply& right)
+{
+    return left.due > right.due;
+}
+
+void mock_server::run()
+{
+    czmqpp::poller poller;
+    poller.add(socket_);
+
+    while (!stopped_)
+    {
+        // Wake when the next reply is due, or periodically to observe stop.
+        auto wait = poll_period_ms;
+        if (!replies_.empty())
+        {
+            const auto remaining = std::chrono::duration_cast<period_ms>(
+                replies_.front().due - clock::now()).count();
+            wait = static_cast<int>(std::max(period_ms::rep(0),
+                std::min(period_ms::rep(wait), remaining)));
+        }
+
+        poller.wait(wait);
+
+        if (poller.terminated())
+            break;
+
+        if (!poller.expired())
+            receive();
+
+        send_due();
+    }
+}
+
+// A router request is the client identity, command, id and payload frames.
+void mock_server::receive()
+{
+    czmqpp::message message;
+    if (!message.receive(socket_))
+        return;
+
+    const auto& parts = message.parts();
+    if (parts.size() != 4)
+        return;
+
+    auto part = parts.begin();
+    const data_chunk identity(*part++);
+    const data_chunk command(*part++);
+    const data_chunk id(*part++);
+    const data_chunk request(*part);
+
+    data_chunk payload;
+    const std::string name(command.begin(), command.end());
+    if (!answer(name, request, payload))
+        return;
+
+    ++requests_;
+    replies_.push_back({ clock::now() + delay(),
+        { identity, command, id, payload } });
+    std::push_heap(replies_.begin(), replies_.end(), later);
+}
+
+void mock_server::send_due()
+{
+    const auto now = clock::now();
+    while (!replies_.empty() && replies_.front().due <= now)
+    {
+        std::pop_heap(replies_.begin(), replies_.end(), later);
+
+        czmqpp::message message;
+        for (const auto& frame: replies_.back().frames)
+            message.append(frame);
+
+        message.send(socket_);
+        replies_.pop_back();
+    }
+}
+
+period_ms mock_server::delay()
+{
+    if (jitter_.count() == 0)
+        return latency_;
+
+    std::uniform_int_distribution<period_ms::rep> deviation(-jitter_.count(),
+        jitter_.count());
+
+    const auto delay = latency_.count() + deviation(random_);
+    return period_ms(std::max(delay, period_ms::rep(0)));
+}
+
+// Synthetic rows are a deterministic function of the address hash. Rows are
+// returned if unconfirmed or if the output or spend is at or above the height.
+data_chunk mock_server::history(const short_hash& hash,
+    uint32_t from_height) const
+{
+    std::vector<history_row> synthetic;
+    const auto canned = histories_.find(hash);
+    if (canned == histories_.end())
+    {
+        for (uint32_t row = 0; row < synthetic_rows_; ++row)
+        {
+            data_chunk seed(hash.begin(), hash.end());
+            write_4_bytes(seed, row);
+
+            history_row item;
+            item.output.hash = sha256_hash(seed);
+            item.output.index = row % 4;
+            item.output_height = height_ - std::min(height_, row);
+            item.value = 10000 * (row + 1);
+            item.spend.hash = null_hash;
+            item.spend.index = max_uint32;
+            item.spend_height = 0;
+            synthetic.push_back(item);
+        }
+    }
+
+    const auto& rows = canned == histories_.end() ? synthetic :
+        canned->second;
+
+    auto payload = error_code();
+    for (const auto& row: rows)
+    {
+        if (row.output_height != 0 && row.output_height < from_height &&
+            row.spend_height < from_height)
+            continue;
+
+        extend_data(payload, row.output.hash);
+        write_4_bytes(payload, row.output.index);
+        write_4_bytes(payload, static_cast<uint32_t>(row.output_height));
+        write_8_bytes(payload, row.value);
+        extend_data(payload, row.spend.hash);
+        write_4_bytes(payload, row.spend.index);
+        write_4_bytes(payload, static_cast<uint32_t>(row.spend_height));
+    }
+
+    return payload;
+}
+
+bool mock_server::answer(const std::string& command,
+    const data_chunk& request, data_chunk& payload) const
+{
+    auto deserial = make_deserializer(request.begin(), request.end());
+
+    try
+    {
+        if (command == fetch_last_height)
+        {
+            payload = error_code();
+            write_4_bytes(payload, height_);
+        }
+        else if (command == fetch_history || command == address_fetch_history)
+        {
+            deserial.read_byte();
+            const auto hash = deserial.read_short_hash();
+            payload = history(hash, deserial.read_4_bytes());
+        }
+        else if (command == fetch_transaction ||
+            command == fetch_unconfirmed_transaction ||
+            command == fetch_transaction_index)
+        {
+            const auto it = transactions_.find(deserial.read_hash());
+            if (it == transactions_.end())
+            {
+                payload = error_code(error::not_found);
+            }
+            else if (command == fetch_transaction_index)
+            {
+                payload = error_code();
+                write_4_bytes(payload, it->second.height);
+                write_4_bytes(payload, it->second.index);
+            }
+            else
+            {
+                payload = error_code();
+                extend_data(payload, it->second.raw);
+            }
+        }
+        else if (command == fetch_block_header)
+        {
+            // The header is requested by hash or by height.
+            auto height = height_;
+            if (request.size() == hash_size)
+            {
+                const auto it = header_heights_.find(deserial.read_hash());
+                height = it == header_heights_.end() ? max_uint32 : it->second;
+            }
+            else
+            {
+                height = deserial.read_4_bytes();
+            }
+
+            const auto it = headers_.find(height);
+            if (it == headers_.end())
+            {
+                payload = error_code(error::not_found);
+            }
+            else
+            {
+                payload = error_code();
+                extend_data(payload, serialize_satoshi_item(it->second));
+            }
+        }
+        else if (command == fetch_stealth)
+        {
+            // The prefix is not applied, all rows are served.
+            payload = error_code();
+            for (const auto& row: stealth_rows_)
+            {
+                extend_data(payload, row.ephemkey);
+                payload.push_back(row.address.version());
+                extend_data(payload, row.address.hash());
+                extend_data(payload, row.transaction_hash);
+            }
+        }
+        else if (command == broadcast_transaction)
+        {
+            payload = error_code();
+        }
+        else if (command == validate)
+        {
+            // Valid, with no unconfirmed inputs.
+            payload = error_code();
+        }
+        else
+        {
+            return false;
+        }
+    }
+    catch (end_of_stream)
+    {
+        payload = error_code(error::bad_stream);
+    }
+
+    return true;
+}
+
+} // namespace explorer
+} // namespace libbitcoin
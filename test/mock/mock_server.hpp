@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BX_MOCK_SERVER_HPP
+#define BX_MOCK_SERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
+
+/* NOTE: don't declare 'using namespace foo' in headers. */
+
+namespace libbitcoin {
+namespace explorer {
+
+/**
+ * Class to stand in for an Obelisk server, for deterministic offline tests
+ * and benchmarks. The server binds a zmq ROUTER socket and answers the
+ * obelisk_codec wire format from canned or synthetic data, on its own
+ * thread, delaying each reply by a configurable latency and jitter.
+ * Populate the server before starting it, it is not modified thereafter.
+ */
+class mock_server
+{
+public:
+
+    /**
+     * Initialization constructor.
+     * @param[in]  context  The zmq context.
+     * @param[in]  latency  The mean delay before each reply, defaults to zero.
+     * @param[in]  jitter   The maximum random deviation from the latency,
+     *                      defaults to zero.
+     */
+    mock_server(czmqpp::context& context,
+        const client::period_ms& latency=client::period_ms(0),
+        const client::period_ms& jitter=client::period_ms(0));
+
+    /**
+     * Destructor, stops the server thread (RAII).
+     */
+    ~mock_server();
+
+    /**
+     * Bind to the specified endpoint and start serving on a new thread.
+     * @param[in]  endpoint  The zmq endpoint, such as 'tcp://127.0.0.1:9091'.
+     * @return               True if bound and started.
+     */
+    virtual bool start(const std::string& endpoint);
+
+    /**
+     * Stop serving and join the server thread.
+     */
+    virtual void stop();
+
+    /**
+     * Get the number of requests answered.
+     */
+    virtual size_t requests() const;
+
+    /**
+     * Set the height returned for the last height.
+     * @param[in]  height  The height.
+     */
+    virtual void set_height(size_t height);
+
+    /**
+     * Set the number of synthetic history rows returned for an address
+     * without canned history, defaults to zero.
+     * @param[in]  rows  The number of rows.
+     */
+    virtual void set_synthetic_history(size_t rows);
+
+    /**
+     * Add a canned history row for an address.
+     * @param[in]  address  The payment address.
+     * @param[in]  row      The history row.
+     */
+    virtual void add_history(const payment_address& address,
+        const client::history_row& row);
+
+    /**
+     * Add a canned block header, which is served by height and by hash.
+     * @param[in]  height  The block height.
+     * @param[in]  header  The block header.
+     */
+    virtual void add_header(size_t height,
+        const block_header_type& header);
+
+    /**
+     * Add a canned stealth row, which is served for any prefix.
+     * @param[in]  row  The stealth row.
+     */
+    virtual void add_stealth(const client::stealth_row& row);
+
+    /**
+     * Add a canned transaction, which is served by hash along with its
+     * height and index.
+     * @param[in]  tx      The transaction.
+     * @param[in]  height  The block height of the transaction.
+     * @param[in]  index   The index of the transaction in the block.
+     */
+    virtual void add_transaction(const tx_type& tx,
+        size_t height=0, size_t index=0);
+
+private:
+
+    typedef std::chrono::steady_clock clock;
+
+    struct reply
+    {
+        clock::time_point due;
+        std::vector<data_chunk> frames;
+    };
+
+    struct located_tx
+    {
+        data_chunk raw;
+        uint32_t height;
+        uint32_t index;
+    };
+
+    static bool later(const reply& left, const reply& right);
+
+    void run();
+    void receive();
+    void send_due();
+    client::period_ms delay();
+    bool answer(const std::string& command, const data_chunk& request,
+        data_chunk& payload) const;
+    data_chunk history(const short_hash& hash, uint32_t from_height) const;
+
+    const client::period_ms latency_;
+    const client::period_ms jitter_;
+    czmqpp::socket socket_;
+    std::thread thread_;
+    std::atomic<bool> stopped_;
+    std::atomic<size_t> requests_;
+    std::vector<reply> replies_;
+    std::minstd_rand random_;
+
+    uint32_t height_;
+    size_t synthetic_rows_;
+    std::map<short_hash, std::vector<client::history_row>> histories_;
+    std::map<uint32_t, block_header_type> headers_;
+    std::map<hash_digest, uint32_t> header_heights_;
+    std::vector<client::stealth_row> stealth_rows_;
+    std::map<hash_digest, located_tx> transactions_;
+};
+
+} // namespace explorer
+} // namespace libbitcoin
+
+#endif
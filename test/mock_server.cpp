@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/explorer.hpp>
+#include "commands/command.hpp"
+#include "mock/mock_server.hpp"
+
+BX_USING_NAMESPACES()
+
+// Each case uses its own endpoint, as connections are shared by the process.
+#define BX_MOCK_SERVER_HEIGHT "tcp://127.0.0.1:65011"
+#define BX_MOCK_SERVER_HISTORY "tcp://127.0.0.1:65012"
+#define BX_MOCK_SERVER_TX "tcp://127.0.0.1:65013"
+
+#define BX_DECLARE_MOCK_COMMAND(extension, endpoint) \
+    BX_DECLARE_COMMAND(extension); \
+    command.set_general_retries_setting(BX_NETWORK_RETRY); \
+    command.set_general_wait_setting(BX_NETWORK_WAIT); \
+    command.set_general_hedge_setting(0); \
+    command.set_mainnet_url_setting({ endpoint })
+
+BOOST_AUTO_TEST_SUITE(offline)
+BOOST_AUTO_TEST_SUITE(mock_server)
+
+BOOST_AUTO_TEST_CASE(mock_server__start__bogus_endpoint__false)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    BOOST_REQUIRE(!server.start("bogus"));
+}
+
+BOOST_AUTO_TEST_CASE(mock_server__fetch_height__height__okay)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context, period_ms(10), period_ms(5));
+    server.set_height(42);
+    BOOST_REQUIRE(server.start(BX_MOCK_SERVER_HEIGHT));
+
+    BX_DECLARE_MOCK_COMMAND(fetch_height, BX_MOCK_SERVER_HEIGHT);
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BX_REQUIRE_OUTPUT("42\n");
+    BOOST_REQUIRE_EQUAL(server.requests(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(mock_server__fetch_history__canned_row__okay)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    const payment_address address(BX_FIRST_ADDRESS);
+    history_row row;
+    row.output.hash = null_hash;
+    row.output.index = 0;
+    row.output_height = 1;
+    row.value = 5000000000;
+    row.spend.hash = null_hash;
+    row.spend.index = max_uint32;
+    row.spend_height = 0;
+    server.add_history(address, row);
+    BOOST_REQUIRE(server.start(BX_MOCK_SERVER_HISTORY));
+
+    BX_DECLARE_MOCK_COMMAND(fetch_history, BX_MOCK_SERVER_HISTORY);
+    command.set_format_option({ "info" });
+    command.set_bitcoin_addresses_argument({ { BX_FIRST_ADDRESS } });
+    BX_REQUIRE_OKAY(command.invoke(output, error));
+    BOOST_REQUIRE(output.str().find("5000000000") != std::string::npos);
+    BOOST_REQUIRE_EQUAL(server.requests(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(mock_server__fetch_tx__missing__failure)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    BOOST_REQUIRE(server.start(BX_MOCK_SERVER_TX));
+
+    BX_DECLARE_MOCK_COMMAND(fetch_tx, BX_MOCK_SERVER_TX);
+    command.set_hash_argument({ BX_SATOSHIS_WORDS_TX_HASH });
+    BX_REQUIRE_FAILURE(command.invoke(output, error));
+    BOOST_REQUIRE_EQUAL(server.requests(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
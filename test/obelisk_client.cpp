@@ -18,19 +18,171 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <boost/filesystem.hpp>
-#include <boost/program_options.hpp>
+#include <cstddef>
+#include <system_error>
 #include <boost/test/test_tools.hpp>
 #include <boost/test/unit_test_suite.hpp>
+#include <czmq++/czmqpp.hpp>
+#include <bitcoin/bitcoin.hpp>
+#include <bitcoin/client.hpp>
 #include <bitcoin/explorer.hpp>
+#include "mock/mock_server.hpp"
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+// Each case uses its own endpoints, as a bound port is not reusable at once.
+#define BX_OBELISK_CLIENT_HEIGHT "tcp://127.0.0.1:65061"
+#define BX_OBELISK_CLIENT_COALESCE "tcp://127.0.0.1:65062"
+#define BX_OBELISK_CLIENT_SLOW "tcp://127.0.0.1:65063"
+#define BX_OBELISK_CLIENT_FAST "tcp://127.0.0.1:65064"
+#define BX_OBELISK_CLIENT_SILENT "tcp://127.0.0.1:65065"
+#define BX_OBELISK_CLIENT_TIMEOUT period_ms(2000)
 
 BOOST_AUTO_TEST_SUITE(obelisk)
 BOOST_AUTO_TEST_SUITE(obelisk_client)
 
-BOOST_AUTO_TEST_CASE(obelisk_client__constructor)
+BOOST_AUTO_TEST_CASE(obelisk_client__constructor__streams_created)
+{
+    czmqpp::context context;
+    bc::explorer::obelisk_client client(context);
+    BOOST_REQUIRE(client.get_codec());
+    BOOST_REQUIRE(client.get_stream());
+    BOOST_REQUIRE(client.get_coalesce_stream());
+    BOOST_REQUIRE(client.get_metrics());
+}
+
+BOOST_AUTO_TEST_CASE(obelisk_client__connect__bogus_address__failure)
+{
+    czmqpp::context context;
+    bc::explorer::obelisk_client client(context);
+    BOOST_REQUIRE_LT(client.connect("bogus"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(obelisk_client__resolve_callbacks__fetch_height__height)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context);
+    server.set_height(42);
+    BOOST_REQUIRE(server.start(BX_OBELISK_CLIENT_HEIGHT));
+
+    bc::explorer::obelisk_client client(context, BX_OBELISK_CLIENT_TIMEOUT);
+    BOOST_REQUIRE_GE(client.connect(BX_OBELISK_CLIENT_HEIGHT), 0);
+
+    size_t height = 0;
+    std::error_code code;
+    const auto on_error = [&code](const std::error_code& error)
+    {
+        code = error;
+    };
+
+    const auto on_done = [&height](size_t value)
+    {
+        height = value;
+    };
+
+    client.get_codec()->fetch_last_height(on_error, on_done);
+    BOOST_REQUIRE(client.resolve_callbacks());
+    BOOST_REQUIRE(!code);
+    BOOST_REQUIRE_EQUAL(height, 42u);
+    BOOST_REQUIRE_EQUAL(client.get_codec()->outstanding_call_count(), 0u);
+    BOOST_REQUIRE_EQUAL(server.requests(), 1u);
+
+    const auto report = client.get_metrics()->report();
+    const auto metrics = report.find("blockchain.fetch_last_height");
+    BOOST_REQUIRE(metrics != report.end());
+    BOOST_REQUIRE_EQUAL(metrics->second.calls, 1u);
+    BOOST_REQUIRE_EQUAL(metrics->second.replies, 1u);
+    BOOST_REQUIRE_EQUAL(metrics->second.timeouts, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(obelisk_client__resolve_callbacks__identical_calls__sent_once)
+{
+    czmqpp::context context;
+    bc::explorer::mock_server server(context, period_ms(20));
+    server.set_height(42);
+    BOOST_REQUIRE(server.start(BX_OBELISK_CLIENT_COALESCE));
+
+    bc::explorer::obelisk_client client(context, BX_OBELISK_CLIENT_TIMEOUT);
+    BOOST_REQUIRE_GE(client.connect(BX_OBELISK_CLIENT_COALESCE), 0);
+
+    size_t replies = 0;
+    const auto on_error = [](const std::error_code&)
+    {
+    };
+
+    const auto on_done = [&replies](size_t height)
+    {
+        if (height == 42)
+            ++replies;
+    };
+
+    client.get_codec()->fetch_last_height(on_error, on_done);
+    client.get_codec()->fetch_last_height(on_error, on_done);
+    BOOST_REQUIRE(client.resolve_callbacks());
+    BOOST_REQUIRE_EQUAL(replies, 2u);
+    BOOST_REQUIRE_EQUAL(client.get_coalesce_stream()->coalesced(), 1u);
+    BOOST_REQUIRE_EQUAL(server.requests(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(obelisk_client__resolve_callbacks__slow_server__hedged)
 {
-    // TODO
+    czmqpp::context context;
+    bc::explorer::mock_server slow(context, period_ms(1000));
+    bc::explorer::mock_server fast(context);
+    slow.set_height(42);
+    fast.set_height(42);
+    BOOST_REQUIRE(slow.start(BX_OBELISK_CLIENT_SLOW));
+    BOOST_REQUIRE(fast.start(BX_OBELISK_CLIENT_FAST));
+
+    bc::explorer::obelisk_client client(context, BX_OBELISK_CLIENT_TIMEOUT, 0,
+        period_ms(20));
+    BOOST_REQUIRE_GE(client.connect(BX_OBELISK_CLIENT_SLOW), 0);
+    BOOST_REQUIRE_GE(client.connect(BX_OBELISK_CLIENT_FAST), 0);
+
+    size_t height = 0;
+    const auto on_error = [](const std::error_code&)
+    {
+    };
+
+    const auto on_done = [&height](size_t value)
+    {
+        height = value;
+    };
+
+    client.get_codec()->fetch_last_height(on_error, on_done);
+    BOOST_REQUIRE(client.resolve_callbacks());
+    BOOST_REQUIRE_EQUAL(height, 42u);
+    BOOST_REQUIRE_EQUAL(client.get_stream()->hedges(), 1u);
+    BOOST_REQUIRE_EQUAL(fast.requests(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(obelisk_client__resolve_callbacks__no_reply__timeout_error)
+{
+    // Nothing is bound to the endpoint, so the call is never answered.
+    czmqpp::context context;
+    bc::explorer::obelisk_client client(context, period_ms(50));
+    BOOST_REQUIRE_GE(client.connect(BX_OBELISK_CLIENT_SILENT), 0);
+
+    std::error_code code;
+    bool done = false;
+    const auto on_error = [&code](const std::error_code& error)
+    {
+        code = error;
+    };
+
+    const auto on_done = [&done](size_t)
+    {
+        done = true;
+    };
+
+    client.get_codec()->fetch_last_height(on_error, on_done);
+    BOOST_REQUIRE(client.resolve_callbacks());
+    BOOST_REQUIRE(code);
+    BOOST_REQUIRE(!done);
+    BOOST_REQUIRE_EQUAL(client.get_codec()->outstanding_call_count(), 0u);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+BOOST_AUTO_TEST_SUITE(output_buffer__flush)
+
+BOOST_AUTO_TEST_CASE(output_buffer__flush__unbuffered__each_flush_writes)
+{
+    std::stringstream sink;
+    output_buffer buffer(sink, { 0, period_ms(0) });
+    std::ostream output(&buffer);
+
+    output << "first";
+    BOOST_REQUIRE_EQUAL(sink.str(), "");
+    output << std::endl;
+    BOOST_REQUIRE_EQUAL(sink.str(), "first\n");
+    BOOST_REQUIRE_EQUAL(buffer.held(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(output_buffer__flush__size__writes_once_size_held)
+{
+    std::stringstream sink;
+    output_buffer buffer(sink, { 10, period_ms(0) });
+    std::ostream output(&buffer);
+
+    output << "12345" << std::endl;
+    BOOST_REQUIRE_EQUAL(sink.str(), "");
+    BOOST_REQUIRE_EQUAL(buffer.held(), 6u);
+    output << "6789" << std::endl;
+    BOOST_REQUIRE_EQUAL(sink.str(), "12345\n6789\n");
+    BOOST_REQUIRE_EQUAL(buffer.held(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(output_buffer__flush__size_beyond_chunk__held)
+{
+    std::stringstream sink;
+    output_buffer buffer(sink, { 100000, period_ms(0) });
+    std::ostream output(&buffer);
+
+    const std::string line(10000, 'x');
+    for (size_t count = 0; count < 5; ++count)
+        output << line << std::endl;
+
+    BOOST_REQUIRE_EQUAL(sink.str(), "");
+    BOOST_REQUIRE_EQUAL(buffer.held(), 50005u);
+}
+
+BOOST_AUTO_TEST_CASE(output_buffer__flush__interval__writes_once_elapsed)
+{
+    std::stringstream sink;
+    output_buffer buffer(sink, { 0, period_ms(50) });
+    std::ostream output(&buffer);
+
+    output << "first" << std::endl;
+    BOOST_REQUIRE_EQUAL(sink.str(), "");
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    output << "second" << std::endl;
+    BOOST_REQUIRE_EQUAL(sink.str(), "first\nsecond\n");
+}
+
+BOOST_AUTO_TEST_CASE(output_buffer__write_due__interval_elapsed__writes_held)
+{
+    std::stringstream sink;
+    output_buffer buffer(sink, { 0, period_ms(50) });
+    std::ostream output(&buffer);
+
+    output << "quiet" << std::endl;
+    buffer.write_due();
+    BOOST_REQUIRE_EQUAL(sink.str(), "");
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    buffer.write_due();
+    BOOST_REQUIRE_EQUAL(sink.str(), "quiet\n");
+}
+
+BOOST_AUTO_TEST_CASE(output_buffer__flush__destroyed__writes_held)
+{
+    std::stringstream sink;
+
+    {
+        output_buffer buffer(sink, { 1000, period_ms(0) });
+        std::ostream output(&buffer);
+        output << "held" << std::endl;
+        BOOST_REQUIRE_EQUAL(sink.str(), "");
+    }
+
+    BOOST_REQUIRE_EQUAL(sink.str(), "held\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(output_buffer__callback_state)
+
+BOOST_AUTO_TEST_CASE(output_buffer__callback_state__default__each_line_written)
+{
+    std::stringstream error;
+    std::stringstream sink;
+    callback_state state(error, sink, encoding_engine::info);
+
+    state.output(std::string("line"));
+    BOOST_REQUIRE_EQUAL(sink.str(), "line\n");
+}
+
+BOOST_AUTO_TEST_CASE(output_buffer__callback_state__buffered__written_on_flush)
+{
+    std::stringstream error;
+    std::stringstream sink;
+    callback_state state(error, sink, encoding_engine::info,
+        { 1000, period_ms(0) });
+
+    state.output(std::string("first"));
+    state.output(std::string("second"));
+    BOOST_REQUIRE_EQUAL(sink.str(), "");
+    state.flush();
+    BOOST_REQUIRE_EQUAL(sink.str(), "first\nsecond\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,315 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+using namespace bc::explorer::primitives;
+
+static std::string write_tree(const pt::ptree& tree, encoding_engine engine)
+{
+    std::stringstream output;
+    write_stream(output, tree, engine);
+    return output.str();
+}
+
+static std::string write_streamed(const pt::ptree& tree,
+    encoding_engine engine)
+{
+    std::stringstream output;
+    stream_writer writer(output, engine);
+    writer.write(tree);
+    writer.finish();
+    return output.str();
+}
+
+// Values that require escaping or quoting in each of the encodings.
+static pt::ptree make_tree()
+{
+    pt::ptree tree;
+    tree.put("alpha.empty", "");
+    tree.put("alpha.quote", "say \"hi\"");
+    tree.put("alpha.slash", "a/b\\c");
+    tree.put("alpha.spaces", "   ");
+    tree.put("alpha.markup", "<a & 'b'>");
+    tree.add_child("beta", pt::ptree());
+    tree.put("gamma", "line\nbreak\ttab;{}");
+    tree.add("gamma", 42);
+    return tree;
+}
+
+static std::vector<history_row> make_rows(const tx_type& tx)
+{
+    history_row spent;
+    spent.output.hash = hash_transaction(tx);
+    spent.output.index = 0;
+    spent.output_height = 0;
+    spent.spend.hash = hash_transaction(tx);
+    spent.spend.index = 1;
+    spent.spend_height = 42;
+    spent.value = 5000000000;
+
+    history_row unspent;
+    unspent.output.hash = null_hash;
+    unspent.output.index = 2;
+    unspent.output_height = 7;
+    unspent.spend.hash = null_hash;
+    unspent.spend.index = 0;
+    unspent.spend_height = 0;
+    unspent.value = 1;
+
+    return { spent, unspent };
+}
+
+BOOST_AUTO_TEST_SUITE(stream_writer__write)
+
+BOOST_AUTO_TEST_CASE(stream_writer__write__empty__matches_tree)
+{
+    const pt::ptree tree;
+    BOOST_REQUIRE_EQUAL(write_streamed(tree, encoding_engine::info),
+        write_tree(tree, encoding_engine::info));
+    BOOST_REQUIRE_EQUAL(write_streamed(tree, encoding_engine::json),
+        write_tree(tree, encoding_engine::json));
+    BOOST_REQUIRE_EQUAL(write_streamed(tree, encoding_engine::xml),
+        write_tree(tree, encoding_engine::xml));
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__write__escaped_values__matches_tree)
+{
+    const auto tree = make_tree();
+    BOOST_REQUIRE_EQUAL(write_streamed(tree, encoding_engine::info),
+        write_tree(tree, encoding_engine::info));
+    BOOST_REQUIRE_EQUAL(write_streamed(tree, encoding_engine::json),
+        write_tree(tree, encoding_engine::json));
+    BOOST_REQUIRE_EQUAL(write_streamed(tree, encoding_engine::xml),
+        write_tree(tree, encoding_engine::xml));
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__put__typed_values__matches_tree)
+{
+    pt::ptree tree;
+    tree.put("element.number", uint64_t(5000000000));
+    tree.put("element.flag", true);
+    tree.put("value", address("1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL"));
+
+    std::stringstream output;
+    stream_writer writer(output, encoding_engine::json);
+    writer.open("element");
+    writer.put("number", uint64_t(5000000000));
+    writer.put("flag", true);
+    writer.close();
+    writer.put("value", address("1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL"));
+    writer.finish();
+    BOOST_REQUIRE_EQUAL(output.str(), write_tree(tree, encoding_engine::json));
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__finish__open_elements__closed)
+{
+    pt::ptree tree;
+    tree.put("outer.inner.value", 1);
+
+    std::stringstream output;
+    stream_writer writer(output, encoding_engine::xml);
+    writer.open("outer");
+    writer.open("inner");
+    writer.put("value", 1);
+    writer.finish();
+    BOOST_REQUIRE_EQUAL(output.str(), write_tree(tree, encoding_engine::xml));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(stream_writer__prop_tree)
+
+BOOST_AUTO_TEST_CASE(stream_writer__prop_tree__transaction__matches_tree)
+{
+    const transaction tx(genesis_block().transactions.front());
+    const auto tree = prop_tree(tx);
+
+    for (const auto engine: { encoding_engine::info, encoding_engine::json,
+        encoding_engine::xml })
+    {
+        std::stringstream output;
+        stream_writer writer(output, engine);
+        prop_tree(writer, tx);
+        writer.finish();
+        BOOST_REQUIRE_EQUAL(output.str(), write_tree(tree, engine));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__prop_tree__history__matches_tree)
+{
+    const auto tx = genesis_block().transactions.front();
+    const auto rows = make_rows(tx);
+    const payment_address owner("1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL");
+    std::map<hash_digest, tx_type> transactions;
+    transactions[hash_transaction(tx)] = tx;
+
+    for (const auto engine: { encoding_engine::info, encoding_engine::json,
+        encoding_engine::xml })
+    {
+        std::stringstream plain;
+        stream_writer plain_writer(plain, engine);
+        prop_tree(plain_writer, rows, owner);
+        plain_writer.finish();
+        BOOST_REQUIRE_EQUAL(plain.str(),
+            write_tree(prop_tree(rows, owner), engine));
+
+        std::stringstream expanded;
+        stream_writer expanded_writer(expanded, engine);
+        prop_tree(expanded_writer, rows, transactions);
+        expanded_writer.finish();
+        BOOST_REQUIRE_EQUAL(expanded.str(),
+            write_tree(prop_tree(rows, transactions), engine));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(stream_writer__ndjson)
+
+BOOST_AUTO_TEST_CASE(stream_writer__ndjson__list__row_per_element)
+{
+    pt::ptree row;
+    row.put("received.hash", "a/b");
+    row.put("value", 1);
+
+    pt::ptree list;
+    list.put("address", "1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL");
+    list.add_child("transfer", row);
+    list.add_child("transfer", row);
+
+    pt::ptree tree;
+    tree.add_child("transfers", list);
+    BOOST_REQUIRE_EQUAL(write_tree(tree, encoding_engine::ndjson),
+        "{\"transfers\":{\"address\":\"1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL\",\"transfer\":{\"received\":{\"hash\":\"a\\/b\"},\"value\":\"1\"}}}\n"
+        "{\"transfers\":{\"address\":\"1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL\",\"transfer\":{\"received\":{\"hash\":\"a\\/b\"},\"value\":\"1\"}}}\n");
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__ndjson__elements__row_per_element)
+{
+    pt::ptree tree;
+    tree.put("header.bits", 1);
+    tree.add_child("empty", pt::ptree());
+    tree.put("height", 2);
+    tree.put("output.outputs.output.value", 3);
+    tree.put("output.pay_to", "x");
+    BOOST_REQUIRE_EQUAL(write_tree(tree, encoding_engine::ndjson),
+        "{\"header\":{\"bits\":\"1\"}}\n"
+        "{\"empty\":\"\"}\n"
+        "{\"height\":\"2\"}\n"
+        "{\"output\":{\"outputs\":{\"output\":{\"value\":\"3\"}}}}\n"
+        "{\"output\":{\"pay_to\":\"x\"}}\n");
+}
+
+// Each input and output is a row of its own, so no row repeats a name.
+BOOST_AUTO_TEST_CASE(stream_writer__ndjson__transaction__row_per_input_and_output)
+{
+    pt::ptree input;
+    input.put("sequence", 1);
+
+    pt::ptree inputs;
+    inputs.add_child("input", input);
+    inputs.add_child("input", input);
+
+    pt::ptree output;
+    output.put("value", 2);
+
+    pt::ptree outputs;
+    outputs.add_child("output", output);
+    outputs.add_child("output", output);
+
+    pt::ptree transaction;
+    transaction.put("hash", "h");
+    transaction.add_child("inputs", inputs);
+    transaction.put("lock_time", 0);
+    transaction.add_child("outputs", outputs);
+    transaction.put("version", 1);
+
+    pt::ptree tree;
+    tree.add_child("transaction", transaction);
+    BOOST_REQUIRE_EQUAL(write_tree(tree, encoding_engine::ndjson),
+        "{\"transaction\":{\"hash\":\"h\",\"inputs\":{\"input\":{\"sequence\":\"1\"}}}}\n"
+        "{\"transaction\":{\"hash\":\"h\",\"inputs\":{\"input\":{\"sequence\":\"1\"}}}}\n"
+        "{\"transaction\":{\"hash\":\"h\",\"lock_time\":\"0\",\"outputs\":{\"output\":{\"value\":\"2\"}}}}\n"
+        "{\"transaction\":{\"hash\":\"h\",\"lock_time\":\"0\",\"outputs\":{\"output\":{\"value\":\"2\"}}}}\n"
+        "{\"transaction\":{\"hash\":\"h\",\"lock_time\":\"0\",\"version\":\"1\"}}\n");
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__ndjson__streamed_transaction__matches_tree)
+{
+    const auto tx = genesis_block().transactions.front();
+
+    std::stringstream output;
+    stream_writer writer(output, encoding_engine::ndjson);
+    prop_tree(writer, primitives::transaction(tx));
+    writer.finish();
+    BOOST_REQUIRE_EQUAL(output.str(),
+        write_tree(prop_tree(primitives::transaction(tx)),
+            encoding_engine::ndjson));
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__ndjson__streamed_history__matches_tree)
+{
+    const auto tx = genesis_block().transactions.front();
+    const auto rows = make_rows(tx);
+    const payment_address owner("1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL");
+
+    std::stringstream output;
+    stream_writer writer(output, encoding_engine::ndjson);
+    prop_tree(writer, rows, owner);
+    writer.finish();
+    BOOST_REQUIRE_EQUAL(output.str(),
+        write_tree(prop_tree(rows, owner), encoding_engine::ndjson));
+}
+
+// An address without transfers is written with its address, as in json.
+BOOST_AUTO_TEST_CASE(stream_writer__ndjson__list_values_without_rows__row_of_values)
+{
+    std::stringstream output;
+    stream_writer writer(output, encoding_engine::ndjson);
+    writer.open_list("transfers");
+    writer.put("address", "1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL");
+    writer.close();
+    writer.finish();
+    BOOST_REQUIRE_EQUAL(output.str(),
+        "{\"transfers\":{\"address\":\"1JziqzWrJSKrL4ZJuLwM1RvKJwV6vbLmBL\"}}\n");
+}
+
+BOOST_AUTO_TEST_CASE(stream_writer__ndjson__empty_list__no_rows)
+{
+    std::stringstream output;
+    stream_writer writer(output, encoding_engine::ndjson);
+    writer.open_list("transfers");
+    writer.close();
+    writer.finish();
+    BOOST_REQUIRE(output.str().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::explorer;
+
+static boost::filesystem::path temporary_path()
+{
+    return boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path();
+}
+
+static void remove_files(const boost::filesystem::path& path)
+{
+    boost::filesystem::remove(path);
+    boost::filesystem::remove(path.string() + ".lock");
+}
+
+// Distinct transactions of the same size as the genesis coinbase.
+static tx_type make_tx(uint32_t locktime)
+{
+    auto tx = genesis_block().transactions.front();
+    tx.locktime = locktime;
+    return tx;
+}
+
+// The size of the file header and of a record of one of the transactions.
+static const size_t header = 16;
+static const size_t record = 44 + satoshi_raw_size(make_tx(0));
+
+// Write a cache file of the transactions, each last used in the order given.
+static void write_cache(const boost::filesystem::path& path,
+    const std::vector<tx_type>& transactions)
+{
+    data_chunk file(header + transactions.size() * record);
+    auto serial = make_serializer(file.begin());
+    serial.write_4_bytes(0x63747862);
+    serial.write_4_bytes(1);
+    serial.write_8_bytes(file.size());
+
+    uint64_t used = 0;
+    for (const auto& tx: transactions)
+    {
+        const auto raw = serialize_satoshi_item(tx);
+        serial.write_hash(hash_transaction(tx));
+        serial.write_8_bytes(used++);
+        serial.write_4_bytes(static_cast<uint32_t>(raw.size()));
+        serial.write_data(raw);
+    }
+
+    std::ofstream stream(path.string(), std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+}
+
+BOOST_AUTO_TEST_SUITE(transaction_cache__store)
+
+BOOST_AUTO_TEST_CASE(transaction_cache__constructor__foreign_file__invalid)
+{
+    const auto path = temporary_path();
+    std::ofstream file(path.string());
+    file << "not a transaction cache file";
+    file.close();
+
+    transaction_cache cache(path, 1024);
+    BOOST_REQUIRE(!cache.valid());
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_cache__find__reopened__stored_transaction)
+{
+    const auto path = temporary_path();
+    const auto tx = make_tx(1);
+    {
+        transaction_cache cache(path, 1024 * 1024);
+        BOOST_REQUIRE(cache.valid());
+        BOOST_REQUIRE(cache.store(tx));
+    }
+
+    transaction_cache cache(path, 1024 * 1024);
+    tx_type found;
+    BOOST_REQUIRE(cache.find(found, hash_transaction(tx)));
+    BOOST_REQUIRE(hash_transaction(found) == hash_transaction(tx));
+    BOOST_REQUIRE(!cache.find(found, null_hash));
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_cache__store__larger_than_capacity__false)
+{
+    const auto path = temporary_path();
+    transaction_cache cache(path, header + record - 1);
+    BOOST_REQUIRE(!cache.store(make_tx(1)));
+    BOOST_REQUIRE_EQUAL(cache.count(), 0u);
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_cache__store__full__evicts_least_recently_used)
+{
+    const auto path = temporary_path();
+    const auto first = make_tx(1);
+    const auto second = make_tx(2);
+    const auto third = make_tx(3);
+    {
+        transaction_cache cache(path, header + 2 * record);
+        BOOST_REQUIRE(cache.store(first));
+        BOOST_REQUIRE(cache.store(second));
+
+        // Using the first makes the second the least recently used.
+        tx_type found;
+        BOOST_REQUIRE(cache.find(found, hash_transaction(first)));
+        BOOST_REQUIRE(cache.store(third));
+        BOOST_REQUIRE_EQUAL(cache.count(), 2u);
+    }
+
+    transaction_cache cache(path, header + 2 * record);
+    BOOST_REQUIRE(cache.contains(hash_transaction(first)));
+    BOOST_REQUIRE(!cache.contains(hash_transaction(second)));
+    BOOST_REQUIRE(cache.contains(hash_transaction(third)));
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_cache__store__duplicate_record__evicts_once)
+{
+    const auto path = temporary_path();
+    const auto first = make_tx(1);
+    const auto second = make_tx(2);
+    const auto third = make_tx(3);
+    write_cache(path, { first, first });
+
+    transaction_cache cache(path, header + 2 * record);
+    BOOST_REQUIRE(cache.valid());
+    BOOST_REQUIRE_EQUAL(cache.count(), 1u);
+    BOOST_REQUIRE(cache.store(second));
+    BOOST_REQUIRE(cache.store(third));
+    BOOST_REQUIRE_EQUAL(cache.count(), 2u);
+    BOOST_REQUIRE(!cache.contains(hash_transaction(first)));
+    BOOST_REQUIRE(cache.contains(hash_transaction(second)));
+    BOOST_REQUIRE(cache.contains(hash_transaction(third)));
+    remove_files(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2011-2014 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin-explorer.
+ *
+ * libbitcoin-explorer is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License with
+ * additional permissions to the one published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version. For more information see LICENSE.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <bitcoin/explorer.hpp>
+
+using namespace bc;
+using namespace bc::client;
+using namespace bc::explorer;
+
+// Discards the messages written to a server.
+class discard
+  : public message_stream
+{
+public:
+    virtual void write(const data_stack& data)
+    {
+    }
+};
+
+// A call message: command, id and payload frames.
+static data_stack make_call(uint8_t id)
+{
+    return
+    {
+        { 'f', 'o', 'o' },
+        { id, 0x00, 0x00, 0x00 },
+        { 0x2a }
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(wire_metrics__histogram)
+
+BOOST_AUTO_TEST_CASE(wire_histogram__percentile__empty__zero)
+{
+    wire_histogram histogram;
+    BOOST_REQUIRE_EQUAL(histogram.count(), 0u);
+    BOOST_REQUIRE_EQUAL(histogram.percentile(50), 0u);
+    BOOST_REQUIRE_EQUAL(histogram.mean(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(wire_histogram__percentile__small_values__exact)
+{
+    wire_histogram histogram;
+    for (uint64_t value = 1; value <= 10; ++value)
+        histogram.record(value);
+
+    BOOST_REQUIRE_EQUAL(histogram.minimum(), 1u);
+    BOOST_REQUIRE_EQUAL(histogram.percentile(50), 5u);
+    BOOST_REQUIRE_EQUAL(histogram.percentile(100), 10u);
+    BOOST_REQUIRE_EQUAL(histogram.maximum(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(wire_histogram__percentile__large_values__within_one_sixteenth)
+{
+    wire_histogram histogram;
+    histogram.record(1000);
+    histogram.record(1000000);
+    histogram.record(1000000000);
+
+    const auto median = histogram.percentile(50);
+    BOOST_REQUIRE(median >= 1000000u);
+    BOOST_REQUIRE(median <= 1000000u + 1000000u / 16);
+    BOOST_REQUIRE_EQUAL(histogram.percentile(100), 1000000000u);
+    BOOST_REQUIRE_EQUAL(histogram.mean(), 333667000u);
+}
+
+BOOST_AUTO_TEST_CASE(wire_histogram__merge__two_histograms__combined)
+{
+    wire_histogram first;
+    wire_histogram second;
+    first.record(8);
+    second.record(2);
+    second.record(4);
+    first.merge(second);
+    BOOST_REQUIRE_EQUAL(first.count(), 3u);
+    BOOST_REQUIRE_EQUAL(first.minimum(), 2u);
+    BOOST_REQUIRE_EQUAL(first.maximum(), 8u);
+    BOOST_REQUIRE_EQUAL(first.percentile(50), 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(wire_metrics__stream)
+
+BOOST_AUTO_TEST_CASE(wire_metrics__completed__reply__recorded)
+{
+    wire_metrics metrics(std::make_shared<discard>());
+    metrics.write(make_call(1));
+    metrics.received(make_call(1));
+    metrics.completed(make_call(1));
+
+    const auto report = metrics.report();
+    BOOST_REQUIRE_EQUAL(report.size(), 1u);
+    const auto& foo = report.at("foo");
+    BOOST_REQUIRE_EQUAL(foo.calls, 1u);
+    BOOST_REQUIRE_EQUAL(foo.replies, 1u);
+    BOOST_REQUIRE_EQUAL(foo.retries, 0u);
+    BOOST_REQUIRE_EQUAL(foo.sent_bytes, 8u);
+    BOOST_REQUIRE_EQUAL(foo.received_bytes, 8u);
+    BOOST_REQUIRE_EQUAL(foo.first_byte.count(), 1u);
+    BOOST_REQUIRE_EQUAL(foo.completion.count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(wire_metrics__write__same_id__retry)
+{
+    wire_metrics metrics(std::make_shared<discard>());
+    metrics.write(make_call(1));
+    metrics.write(make_call(1));
+
+    const auto& foo = metrics.report().at("foo");
+    BOOST_REQUIRE_EQUAL(foo.calls, 1u);
+    BOOST_REQUIRE_EQUAL(foo.retries, 1u);
+    BOOST_REQUIRE_EQUAL(foo.sent_bytes, 16u);
+}
+
+BOOST_AUTO_TEST_CASE(wire_metrics__report__expired_call__timeout)
+{
+    wire_metrics metrics(std::make_shared<discard>(), period_ms(1));
+    metrics.write(make_call(1));
+    std::this_thread::sleep_for(period_ms(3));
+
+    const auto& foo = metrics.report().at("foo");
+    BOOST_REQUIRE_EQUAL(foo.timeouts, 1u);
+    BOOST_REQUIRE_EQUAL(foo.replies, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(wire_metrics__reset__in_flight_call__completed_after)
+{
+    wire_metrics metrics(std::make_shared<discard>());
+    metrics.write(make_call(1));
+    metrics.reset();
+    BOOST_REQUIRE(metrics.report().empty());
+
+    metrics.received(make_call(1));
+    metrics.completed(make_call(1));
+    BOOST_REQUIRE_EQUAL(metrics.report().at("foo").replies, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(wire_metrics__merge__two_reports__summed)
+{
+    wire_metrics metrics(std::make_shared<discard>());
+    metrics.write(make_call(1));
+    metrics.write(make_call(2));
+
+    wire_report report;
+    wire_metrics::merge(report, metrics.report());
+    wire_metrics::merge(report, metrics.report());
+    BOOST_REQUIRE_EQUAL(report.at("foo").calls, 4u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()